@@ -18,9 +18,13 @@ class FrameBuffer
 public:
 	uInt16 tiaColorMap16[256]{};
 	uInt32 tiaColorMap32[256]{};
-	uInt8 myPhosphorPalette[256][256]{};
-	std::array<uInt8, 160 * TIAConstants::frameBufferHeight> prevFramebuffer;
+	uInt32 tiaPalette[256]{};
+	IG::PixelFormat tiaColorMap32Format{};
+	// last displayed frame in the output pixel format, used by the phosphor effect
+	std::array<uInt32, 160 * TIAConstants::frameBufferHeight> prevFramebuffer{};
+	IG::PixelFormat prevFramebufferFormat{};
 	float myPhosphorPercent = 0.80f;
+	uInt32 myPhosphorFactor = 205; // myPhosphorPercent in 8.8 fixed point
 	bool myUsePhosphor = false;
 
 	FrameBuffer() {}
@@ -68,16 +72,10 @@ public:
 	bool phosphorEnabled() const { return myUsePhosphor; }
 
 	/**
-		Used to calculate an averaged color for the 'phosphor' effect.
-
-		@param c1  Color 1
-		@param c2  Color 2
-
-		@return  Averaged value of the two colors
+		Rebuild tiaColorMap32 from the current palette if the 32-bit
+		output format changed.
 	*/
-	uInt8 getPhosphor(const uInt8 c1, uInt8 c2) const;
-
-	uInt32 getRGBPhosphor(const uInt32 c, const uInt32 p) const;
+	void updateColorMap32(IG::PixelFormat format);
 
 	void clear() {}
 };
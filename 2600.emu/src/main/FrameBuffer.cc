@@ -24,6 +24,11 @@
 #endif
 #include <FrameBuffer.hxx>
 #include <stella/emucore/tia/TIA.hxx>
+#if defined __SSE2__
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 
 void FrameBuffer::showMessage(const string& message, int position, bool force, uInt32 color)
 {
@@ -36,25 +41,12 @@ void FrameBuffer::enablePhosphor(bool enable, int blend)
 	if(blend >= 0)
 	{
 		myPhosphorPercent = std::max(blend, 1) / 100.0;
+		myPhosphorFactor = myPhosphorPercent * 256.f + .5f;
   	logMsg("phosphor blend:%d (%.2f%%)", blend, myPhosphorPercent);
 	}
-	if(enable)
-  {
-    for(Int16 c = 255; c >= 0; c--)
-      for(Int16 p = 255; p >= 0; p--)
-        myPhosphorPalette[c][p] = getPhosphor(c, p);
-  }
 	prevFramebuffer = {};
 }
 
-uint8 FrameBuffer::getPhosphor(uInt8 c1, uInt8 c2) const
-{
-	// Use maximum of current and decayed previous values
-	c2 = uInt8(c2 * myPhosphorPercent);
-	if(c1 > c2)  return c1; // raise (assumed immediate)
-	else         return c2; // decay
-}
-
 void FrameBuffer::setPalette(const uInt32* palette)
 {
 	logMsg("setTIAPalette");
@@ -64,42 +56,168 @@ void FrameBuffer::setPalette(const uInt32* palette)
 		uint8 g = (palette[i] >> 8) & 0xff;
 		uint8 b = palette[i] & 0xff;
 		tiaColorMap16[i] = IG::PIXEL_DESC_RGB565.build(r >> 3, g >> 2, b >> 3, 0);
-		tiaColorMap32[i] = IG::PIXEL_DESC_ARGB8888.build((int)r, (int)g, (int)b, 0);
+		tiaPalette[i] = palette[i];
 	}
+	tiaColorMap32Format = {};
 }
 
-uInt32 FrameBuffer::getRGBPhosphor(const uInt32 c, const uInt32 p) const
+void FrameBuffer::updateColorMap32(IG::PixelFormat format)
 {
-  #define TO_RGB(color, red, green, blue) \
-    const uInt8 red = color >> 16; const uInt8 green = color >> 8; const uInt8 blue = color;
+	if(format == tiaColorMap32Format)
+		return;
+	logMsg("building 32-bit color map for format:%s", format.name());
+	auto desc = format.desc();
+	iterateTimes(256, i)
+	{
+		int r = (tiaPalette[i] >> 16) & 0xff;
+		int g = (tiaPalette[i] >> 8) & 0xff;
+		int b = tiaPalette[i] & 0xff;
+		tiaColorMap32[i] = desc.build(r, g, b, 0);
+	}
+	tiaColorMap32Format = format;
+}
+
+// Phosphor blending works per channel directly on the output pixels:
+// out = max(current, previous * factor / 256), and the result becomes the
+// next frame's previous value, matching Stella's TIASurface behavior
 
-  TO_RGB(c, rc, gc, bc);
-  TO_RGB(p, rp, gp, bp);
+static void blendPhosphor(uInt16 *dest, uInt16 *prev, const uInt16 *cur, uInt32 pixels, uInt32 factor)
+{
+	uInt32 i = 0;
+	#if defined __SSE2__
+	const __m128i f = _mm_set1_epi16(factor);
+	const __m128i mask5 = _mm_set1_epi16(0x1f);
+	const __m128i mask6 = _mm_set1_epi16(0x3f);
+	for(; i + 8 <= pixels; i += 8)
+	{
+		__m128i c = _mm_loadu_si128((const __m128i*)&cur[i]);
+		__m128i p = _mm_loadu_si128((const __m128i*)&prev[i]);
+		__m128i r = _mm_max_epi16(_mm_srli_epi16(c, 11),
+			_mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi16(p, 11), f), 8));
+		__m128i g = _mm_max_epi16(_mm_and_si128(_mm_srli_epi16(c, 5), mask6),
+			_mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(p, 5), mask6), f), 8));
+		__m128i b = _mm_max_epi16(_mm_and_si128(c, mask5),
+			_mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(p, mask5), f), 8));
+		__m128i out = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+		_mm_storeu_si128((__m128i*)&prev[i], out);
+		_mm_storeu_si128((__m128i*)&dest[i], out);
+	}
+	#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	const uint16x8_t mask5 = vdupq_n_u16(0x1f);
+	const uint16x8_t mask6 = vdupq_n_u16(0x3f);
+	for(; i + 8 <= pixels; i += 8)
+	{
+		uint16x8_t c = vld1q_u16(&cur[i]);
+		uint16x8_t p = vld1q_u16(&prev[i]);
+		uint16x8_t r = vmaxq_u16(vshrq_n_u16(c, 11),
+			vshrq_n_u16(vmulq_n_u16(vshrq_n_u16(p, 11), factor), 8));
+		uint16x8_t g = vmaxq_u16(vandq_u16(vshrq_n_u16(c, 5), mask6),
+			vshrq_n_u16(vmulq_n_u16(vandq_u16(vshrq_n_u16(p, 5), mask6), factor), 8));
+		uint16x8_t b = vmaxq_u16(vandq_u16(c, mask5),
+			vshrq_n_u16(vmulq_n_u16(vandq_u16(p, mask5), factor), 8));
+		uint16x8_t out = vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b);
+		vst1q_u16(&prev[i], out);
+		vst1q_u16(&dest[i], out);
+	}
+	#endif
+	for(; i < pixels; i++)
+	{
+		uInt32 c = cur[i], p = prev[i];
+		uInt32 r = std::max(c >> 11, ((p >> 11) * factor) >> 8);
+		uInt32 g = std::max((c >> 5) & 0x3f, (((p >> 5) & 0x3f) * factor) >> 8);
+		uInt32 b = std::max(c & 0x1f, ((p & 0x1f) * factor) >> 8);
+		prev[i] = dest[i] = (r << 11) | (g << 5) | b;
+	}
+}
 
-  // Mix current calculated frame with previous displayed frame
-  const uInt8 rn = myPhosphorPalette[rc][rp];
-  const uInt8 gn = myPhosphorPalette[gc][gp];
-  const uInt8 bn = myPhosphorPalette[bc][bp];
+static void blendPhosphor(uInt32 *dest, uInt32 *prev, const uInt32 *cur, uInt32 pixels, uInt32 factor)
+{
+	// channel layout doesn't matter since all 4 bytes get the same treatment
+	uInt32 i = 0;
+	#if defined __SSE2__
+	const __m128i f = _mm_set1_epi16(factor);
+	const __m128i zero = _mm_setzero_si128();
+	for(; i + 4 <= pixels; i += 4)
+	{
+		__m128i c = _mm_loadu_si128((const __m128i*)&cur[i]);
+		__m128i p = _mm_loadu_si128((const __m128i*)&prev[i]);
+		__m128i pLo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), f), 8);
+		__m128i pHi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), f), 8);
+		__m128i out = _mm_max_epu8(c, _mm_packus_epi16(pLo, pHi));
+		_mm_storeu_si128((__m128i*)&prev[i], out);
+		_mm_storeu_si128((__m128i*)&dest[i], out);
+	}
+	#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	for(; i + 4 <= pixels; i += 4)
+	{
+		uint8x16_t c = vld1q_u8((const uint8_t*)&cur[i]);
+		uint8x16_t p = vld1q_u8((const uint8_t*)&prev[i]);
+		uint8x8_t pLo = vshrn_n_u16(vmulq_n_u16(vmovl_u8(vget_low_u8(p)), factor), 8);
+		uint8x8_t pHi = vshrn_n_u16(vmulq_n_u16(vmovl_u8(vget_high_u8(p)), factor), 8);
+		uint8x16_t out = vmaxq_u8(c, vcombine_u8(pLo, pHi));
+		vst1q_u8((uint8_t*)&prev[i], out);
+		vst1q_u8((uint8_t*)&dest[i], out);
+	}
+	#endif
+	for(; i < pixels; i++)
+	{
+		uInt32 c = cur[i], p = prev[i], out = 0;
+		for(uInt32 shift = 0; shift < 32; shift += 8)
+		{
+			uInt32 cc = (c >> shift) & 0xff;
+			uInt32 pc = ((((p >> shift) & 0xff) * factor) >> 8);
+			out |= std::max(cc, pc) << shift;
+		}
+		prev[i] = dest[i] = out;
+	}
+}
 
-  return IG::PIXEL_DESC_RGB565.build(rn >> 3, gn >> 2, bn >> 3, 0);
+template <class T>
+static void renderPhosphor(IG::Pixmap pix, const uInt8 *tiaFrame, const T *colorMap, T *prevFrame, uInt32 factor)
+{
+	auto width = pix.w();
+	// the TIA always outputs 160 pixels per line
+	static constexpr uInt32 MAX_WIDTH = 160;
+	assumeExpr(width <= MAX_WIDTH);
+	T cur[MAX_WIDTH];
+	iterateTimes(pix.h(), y)
+	{
+		// expand into a local row so the output buffer is only ever written
+		iterateTimes(width, x)
+		{
+			cur[x] = colorMap[tiaFrame[x]];
+		}
+		blendPhosphor((T*)pix.pixel({0, (int)y}), prevFrame, cur, width, factor);
+		tiaFrame += width;
+		prevFrame += width;
+	}
 }
 
 void FrameBuffer::render(IG::Pixmap pix, TIA &tia)
 {
 	assumeExpr(pix.w() == tia.width());
 	assumeExpr(pix.h() == tia.height());
-	IG::Pixmap framePix{{{(int)tia.width(), (int)tia.height()}, IG::PIXEL_I8}, tia.frameBuffer()};
+	bool is32Bit = pix.format().bytesPerPixel() == 4;
+	if(is32Bit)
+		updateColorMap32(pix.format());
 	if(myUsePhosphor)
 	{
-		uint8* prevFrame = prevFramebuffer.data();
-		pix.writeTransformed([this, &prevFrame](uint8 p)
-			{
-				return getRGBPhosphor(tiaColorMap32[p], tiaColorMap32[*prevFrame++]);
-			}, framePix);
-		memcpy(prevFramebuffer.data(), tia.frameBuffer(), sizeof(prevFramebuffer));
+		if(pix.format() != prevFramebufferFormat)
+		{
+			prevFramebuffer = {};
+			prevFramebufferFormat = pix.format();
+		}
+		if(is32Bit)
+			renderPhosphor(pix, tia.frameBuffer(), tiaColorMap32, prevFramebuffer.data(), myPhosphorFactor);
+		else
+			renderPhosphor(pix, tia.frameBuffer(), tiaColorMap16, (uInt16*)prevFramebuffer.data(), myPhosphorFactor);
 	}
 	else
 	{
-		pix.writeTransformed([this](uint8 p){ return tiaColorMap16[p]; }, framePix);
+		IG::Pixmap framePix{{{(int)tia.width(), (int)tia.height()}, IG::PIXEL_I8}, tia.frameBuffer()};
+		if(is32Bit)
+			pix.writeTransformed([this](uint8 p){ return tiaColorMap32[p]; }, framePix);
+		else
+			pix.writeTransformed([this](uint8 p){ return tiaColorMap16[p]; }, framePix);
 	}
 }
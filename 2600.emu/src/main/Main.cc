@@ -21,6 +21,7 @@
 #define Debugger DebuggerMac
 #include <emuframework/EmuApp.hh>
 #include <emuframework/EmuAppInlines.hh>
+#include <imagine/io/MemoryStreamBuf.hh>
 #undef BytePtr
 #undef Debugger
 #ifdef Success
@@ -80,9 +81,14 @@ FS::PathString EmuSystem::sprintStateFilename(int slot, const char *savePath, co
 	return FS::makePathStringPrintf("%s/%s.0%c.sta", savePath, gameName, saveSlotChar(slot));
 }
 
+// the state size is fixed once a game is loaded, so it's measured with a dry run
+// on the first query and afterwards taken from the last save
+static size_t stateSizeHint{};
+
 void EmuSystem::closeSystem()
 {
 	osystem->deleteConsole();
+	stateSizeHint = 0;
 }
 
 static void updateSwitchValues()
@@ -205,6 +211,45 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 	return {};
 }
 
+size_t EmuSystem::stateDataSize()
+{
+	if(!stateSizeHint)
+	{
+		MemoryStreamBuf buf;
+		Serializer state(buf);
+		if(!osystem->state().saveState(state))
+			return 0;
+		stateSizeHint = buf.bytesWritten();
+	}
+	return stateSizeHint;
+}
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	MemoryStreamBuf buf{data, size};
+	Serializer state(buf);
+	if(!osystem->state().saveState(state))
+	{
+		stateSizeHint = 0;
+		return makeError("State buffer too small");
+	}
+	dataSize = buf.bytesWritten();
+	stateSizeHint = dataSize;
+	return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	MemoryStreamBuf buf{data, size};
+	Serializer state(buf);
+	if(!osystem->state().loadState(state))
+	{
+		return makeError("Invalid state data");
+	}
+	updateSwitchValues();
+	return {};
+}
+
 void EmuApp::onCustomizeNavView(EmuApp::NavView &view)
 {
 	const Gfx::LGradientStopDesc navViewGrad[] =
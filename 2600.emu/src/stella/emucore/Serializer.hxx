@@ -49,6 +49,12 @@ class Serializer
     Serializer(const string& filename, bool readonly = false);
     Serializer();
 
+    /**
+      Creates a new Serializer device streaming to/from the given stream
+      buffer, which must outlive the Serializer.
+    */
+    explicit Serializer(std::streambuf& buf);
+
   public:
     /**
       Answers whether the serializer is currently initialized for reading
@@ -62,6 +62,13 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, bool traponfata
     configuration(configurefor),
     myCartridge(cartridge)
 {
+  decodedRom = make_unique<Op[]>(ROMSIZE / 2);
+  for(uInt32 i = 0; i < ROMSIZE / 2; ++i)
+  {
+    uInt16 inst = CONV_RAMROM(rom[i]);
+    decodedRom[i] = decodeInstructionWord(inst);
+  }
+
   setConsoleTiming(ConsoleTiming::ntsc);
   trapFatalErrors(traponfatal);
   reset();
@@ -526,6 +533,232 @@ void Thumbulator::do_vflag_bit(uInt32 x)
   if(x) cpsr |= CPSR_V;  else cpsr &= ~CPSR_V;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Thumbulator::Op Thumbulator::decodeInstructionWord(uInt16 inst)
+{
+  // Several patterns overlap, so they're tested in this order and the first
+  // match wins
+  //ADC
+  if((inst & 0xFFC0) == 0x4140) return Op::adc;
+
+  //ADD(1) small immediate two registers (a zero immediate is MOV(2))
+  if(((inst & 0xFE00) == 0x1C00) && (inst & 0x01C0)) return Op::add1;
+
+  //ADD(2) big immediate one register
+  if((inst & 0xF800) == 0x3000) return Op::add2;
+
+  //ADD(3) three registers
+  if((inst & 0xFE00) == 0x1800) return Op::add3;
+
+  //ADD(4) two registers one or both high no flags
+  if((inst & 0xFF00) == 0x4400) return Op::add4;
+
+  //ADD(5) rd = pc plus immediate
+  if((inst & 0xF800) == 0xA000) return Op::add5;
+
+  //ADD(6) rd = sp plus immediate
+  if((inst & 0xF800) == 0xA800) return Op::add6;
+
+  //ADD(7) sp plus immediate
+  if((inst & 0xFF80) == 0xB000) return Op::add7;
+
+  //AND
+  if((inst & 0xFFC0) == 0x4000) return Op::and_;
+
+  //ASR(1) two register immediate
+  if((inst & 0xF800) == 0x1000) return Op::asr1;
+
+  //ASR(2) two register
+  if((inst & 0xFFC0) == 0x4100) return Op::asr2;
+
+  //B(1) conditional branch (0xDE is undefined, 0xDF is SWI)
+  if(((inst & 0xF000) == 0xD000) && ((inst & 0x0F00) < 0x0E00)) return Op::b1;
+
+  //B(2) unconditional branch
+  if((inst & 0xF800) == 0xE000) return Op::b2;
+
+  //BIC
+  if((inst & 0xFFC0) == 0x4380) return Op::bic;
+
+  //BKPT
+  if((inst & 0xFF00) == 0xBE00) return Op::bkpt;
+
+  //BL/BLX(1)
+  if((inst & 0xE000) == 0xE000) return Op::bl;
+
+  //BLX(2)
+  if((inst & 0xFF87) == 0x4780) return Op::blx2;
+
+  //BX
+  if((inst & 0xFF87) == 0x4700) return Op::bx;
+
+  //CMN
+  if((inst & 0xFFC0) == 0x42C0) return Op::cmn;
+
+  //CMP(1) compare immediate
+  if((inst & 0xF800) == 0x2800) return Op::cmp1;
+
+  //CMP(2) compare register
+  if((inst & 0xFFC0) == 0x4280) return Op::cmp2;
+
+  //CMP(3) compare high register
+  if((inst & 0xFF00) == 0x4500) return Op::cmp3;
+
+  //CPS
+  if((inst & 0xFFE8) == 0xB660) return Op::cps;
+
+  //CPY copy high register
+  if((inst & 0xFFC0) == 0x4600) return Op::cpy;
+
+  //EOR
+  if((inst & 0xFFC0) == 0x4040) return Op::eor;
+
+  //LDMIA
+  if((inst & 0xF800) == 0xC800) return Op::ldmia;
+
+  //LDR(1) two register immediate
+  if((inst & 0xF800) == 0x6800) return Op::ldr1;
+
+  //LDR(2) three register
+  if((inst & 0xFE00) == 0x5800) return Op::ldr2;
+
+  //LDR(3)
+  if((inst & 0xF800) == 0x4800) return Op::ldr3;
+
+  //LDR(4)
+  if((inst & 0xF800) == 0x9800) return Op::ldr4;
+
+  //LDRB(1)
+  if((inst & 0xF800) == 0x7800) return Op::ldrb1;
+
+  //LDRB(2)
+  if((inst & 0xFE00) == 0x5C00) return Op::ldrb2;
+
+  //LDRH(1)
+  if((inst & 0xF800) == 0x8800) return Op::ldrh1;
+
+  //LDRH(2)
+  if((inst & 0xFE00) == 0x5A00) return Op::ldrh2;
+
+  //LDRSB
+  if((inst & 0xFE00) == 0x5600) return Op::ldrsb;
+
+  //LDRSH
+  if((inst & 0xFE00) == 0x5E00) return Op::ldrsh;
+
+  //LSL(1)
+  if((inst & 0xF800) == 0x0000) return Op::lsl1;
+
+  //LSL(2) two register
+  if((inst & 0xFFC0) == 0x4080) return Op::lsl2;
+
+  //LSR(1) two register immediate
+  if((inst & 0xF800) == 0x0800) return Op::lsr1;
+
+  //LSR(2) two register
+  if((inst & 0xFFC0) == 0x40C0) return Op::lsr2;
+
+  //MOV(1) immediate
+  if((inst & 0xF800) == 0x2000) return Op::mov1;
+
+  //MOV(2) two low registers
+  if((inst & 0xFFC0) == 0x1C00) return Op::mov2;
+
+  //MOV(3)
+  if((inst & 0xFF00) == 0x4600) return Op::mov3;
+
+  //MUL
+  if((inst & 0xFFC0) == 0x4340) return Op::mul;
+
+  //MVN
+  if((inst & 0xFFC0) == 0x43C0) return Op::mvn;
+
+  //NEG
+  if((inst & 0xFFC0) == 0x4240) return Op::neg;
+
+  //ORR
+  if((inst & 0xFFC0) == 0x4300) return Op::orr;
+
+  //POP
+  if((inst & 0xFE00) == 0xBC00) return Op::pop;
+
+  //PUSH
+  if((inst & 0xFE00) == 0xB400) return Op::push;
+
+  //REV
+  if((inst & 0xFFC0) == 0xBA00) return Op::rev;
+
+  //REV16
+  if((inst & 0xFFC0) == 0xBA40) return Op::rev16;
+
+  //REVSH
+  if((inst & 0xFFC0) == 0xBAC0) return Op::revsh;
+
+  //ROR
+  if((inst & 0xFFC0) == 0x41C0) return Op::ror;
+
+  //SBC
+  if((inst & 0xFFC0) == 0x4180) return Op::sbc;
+
+  //SETEND
+  if((inst & 0xFFF7) == 0xB650) return Op::setend;
+
+  //STMIA
+  if((inst & 0xF800) == 0xC000) return Op::stmia;
+
+  //STR(1)
+  if((inst & 0xF800) == 0x6000) return Op::str1;
+
+  //STR(2)
+  if((inst & 0xFE00) == 0x5000) return Op::str2;
+
+  //STR(3)
+  if((inst & 0xF800) == 0x9000) return Op::str3;
+
+  //STRB(1)
+  if((inst & 0xF800) == 0x7000) return Op::strb1;
+
+  //STRB(2)
+  if((inst & 0xFE00) == 0x5400) return Op::strb2;
+
+  //STRH(1)
+  if((inst & 0xF800) == 0x8000) return Op::strh1;
+
+  //STRH(2)
+  if((inst & 0xFE00) == 0x5200) return Op::strh2;
+
+  //SUB(1)
+  if((inst & 0xFE00) == 0x1E00) return Op::sub1;
+
+  //SUB(2)
+  if((inst & 0xF800) == 0x3800) return Op::sub2;
+
+  //SUB(3)
+  if((inst & 0xFE00) == 0x1A00) return Op::sub3;
+
+  //SUB(4)
+  if((inst & 0xFF80) == 0xB080) return Op::sub4;
+
+  //SWI
+  if((inst & 0xFF00) == 0xDF00) return Op::swi;
+
+  //SXTB
+  if((inst & 0xFFC0) == 0xB240) return Op::sxtb;
+
+  //SXTH
+  if((inst & 0xFFC0) == 0xB200) return Op::sxth;
+
+  //TST
+  if((inst & 0xFFC0) == 0x4200) return Op::tst;
+
+  //UXTB
+  if((inst & 0xFFC0) == 0xB2C0) return Op::uxtb;
+
+  //UXTH
+  if((inst & 0xFFC0) == 0xB280) return Op::uxth;
+  return Op::invalid;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int Thumbulator::execute()
 {
@@ -593,1725 +826,1740 @@ int Thumbulator::execute()
 #endif
 
   inst = fetch16(pc-2);
+
+  // Code in ROM was decoded once on construction; RAM can be rewritten at any
+  // time (by the ARM and by the 6507), so its instructions are decoded on fetch
+  const Op decodedOp = ((pc-2) & 0xF0000000) == 0x00000000 ?
+      decodedRom[((pc-2) & ROMADDMASK) >> 1] : decodeInstructionWord(inst);
+
   pc += 2;
   write_register(15, pc);
   DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " ");
 
   instructions++;
 
-  //ADC
-  if((inst & 0xFFC0) == 0x4140)
-  {
-    rd = (inst >> 0) & 0x07;
-    rm = (inst >> 3) & 0x07;
-    DO_DISS(statusMsg << "adc r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra + rb;
-    if(cpsr & CPSR_C)
-      rc++;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    if(cpsr & CPSR_C) { do_cflag(ra, rb, 1); do_vflag(ra, rb, 1); }
-    else              { do_cflag(ra, rb, 0); do_vflag(ra, rb, 0); }
-    return 0;
-  }
-
-  //ADD(1) small immediate two registers
-  if((inst & 0xFE00) == 0x1C00)
+  switch(decodedOp)
   {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rb = (inst >> 6) & 0x7;
-    if(rb)
+    //ADC
+    case Op::adc:
     {
-      DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ","
-                        << "#0x" << Base::HEX2 << rb << endl);
-      ra = read_register(rn);
+      rd = (inst >> 0) & 0x07;
+      rm = (inst >> 3) & 0x07;
+      DO_DISS(statusMsg << "adc r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
       rc = ra + rb;
-      //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
+      if(cpsr & CPSR_C)
+        rc++;
       write_register(rd, rc);
       do_nflag(rc);
       do_zflag(rc);
-      do_cflag(ra, rb, 0);
-      do_vflag(ra, rb, 0);
+      if(cpsr & CPSR_C) { do_cflag(ra, rb, 1); do_vflag(ra, rb, 1); }
+      else              { do_cflag(ra, rb, 0); do_vflag(ra, rb, 0); }
       return 0;
     }
-    else
+
+    //ADD(1) small immediate two registers
+    case Op::add1:
     {
-      //this is a mov
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rb = (inst >> 6) & 0x7;
+      if(rb)
+      {
+        DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ","
+                          << "#0x" << Base::HEX2 << rb << endl);
+        ra = read_register(rn);
+        rc = ra + rb;
+        //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
+        write_register(rd, rc);
+        do_nflag(rc);
+        do_zflag(rc);
+        do_cflag(ra, rb, 0);
+        do_vflag(ra, rb, 0);
+        return 0;
+      }
+      else
+      {
+        //this is a mov
+      }
     }
-  }
-
-  //ADD(2) big immediate one register
-  if((inst & 0xF800) == 0x3000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x7;
-    DO_DISS(statusMsg << "adds r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(rd);
-    rc = ra + rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, rb, 0);
-    do_vflag(ra, rb, 0);
-    return 0;
-  }
-
-  //ADD(3) three registers
-  if((inst & 0xFE00) == 0x1800)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ",r" << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra + rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, rb, 0);
-    do_vflag(ra, rb, 0);
-    return 0;
-  }
+    break;
 
-  //ADD(4) two registers one or both high no flags
-  if((inst & 0xFF00) == 0x4400)
-  {
-    if((inst >> 6) & 3)
+    //ADD(2) big immediate one register
+    case Op::add2:
     {
-      //UNPREDICTABLE
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x7;
+      DO_DISS(statusMsg << "adds r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rd);
+      rc = ra + rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, rb, 0);
+      do_vflag(ra, rb, 0);
+      return 0;
     }
-    rd  = (inst >> 0) & 0x7;
-    rd |= (inst >> 4) & 0x8;
-    rm  = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "add r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra + rb;
-    if(rd == 15)
-    {
-      if((rc & 1) == 0)
-        fatalError("add pc", pc, rc, " produced an arm address");
 
-      rc &= ~1; //write_register may do this as well
-      rc += 2;  //The program counter is special
+    //ADD(3) three registers
+    case Op::add3:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ",r" << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra + rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, rb, 0);
+      do_vflag(ra, rb, 0);
+      return 0;
     }
-    //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //ADD(5) rd = pc plus immediate
-  if((inst & 0xF800) == 0xA000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x7;
-    rb <<= 2;
-    DO_DISS(statusMsg << "add r" << dec << rd << ",PC,#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(15);
-    rc = (ra & (~3u)) + rb;
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //ADD(6) rd = sp plus immediate
-  if((inst & 0xF800) == 0xA800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x7;
-    rb <<= 2;
-    DO_DISS(statusMsg << "add r" << dec << rd << ",SP,#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(13);
-    rc = ra + rb;
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //ADD(7) sp plus immediate
-  if((inst & 0xFF80) == 0xB000)
-  {
-    rb = (inst >> 0) & 0x7F;
-    rb <<= 2;
-    DO_DISS(statusMsg << "add SP,#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(13);
-    rc = ra + rb;
-    write_register(13, rc);
-    return 0;
-  }
-
-  //AND
-  if((inst & 0xFFC0) == 0x4000)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "ands r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra & rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //ASR(1) two register immediate
-  if((inst & 0xF800) == 0x1000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rm = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
-    rc = read_register(rm);
-    if(rb == 0)
+    //ADD(4) two registers one or both high no flags
+    case Op::add4:
     {
-      if(rc & 0x80000000)
+      if((inst >> 6) & 3)
       {
-        do_cflag_bit(1);
-        rc = ~0;
+        //UNPREDICTABLE
       }
-      else
+      rd  = (inst >> 0) & 0x7;
+      rd |= (inst >> 4) & 0x8;
+      rm  = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "add r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra + rb;
+      if(rd == 15)
       {
-        do_cflag_bit(0);
-        rc = 0;
+        if((rc & 1) == 0)
+          fatalError("add pc", pc, rc, " produced an arm address");
+
+        rc &= ~1; //write_register may do this as well
+        rc += 2;  //The program counter is special
       }
+      //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
+      write_register(rd, rc);
+      return 0;
     }
-    else
+
+    //ADD(5) rd = pc plus immediate
+    case Op::add5:
     {
-      do_cflag_bit(rc & (1 << (rb-1)));
-      ra = rc & 0x80000000;
-      rc >>= rb;
-      if(ra) //asr, sign is shifted in
-        rc |= (~0u) << (32-rb);
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x7;
+      rb <<= 2;
+      DO_DISS(statusMsg << "add r" << dec << rd << ",PC,#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(15);
+      rc = (ra & (~3u)) + rb;
+      write_register(rd, rc);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //ASR(2) two register
-  if((inst & 0xFFC0) == 0x4100)
-  {
-    rd = (inst >> 0) & 0x07;
-    rs = (inst >> 3) & 0x07;
-    DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rs << endl);
-    rc = read_register(rd);
-    rb = read_register(rs);
-    rb &= 0xFF;
-    if(rb == 0)
+    //ADD(6) rd = sp plus immediate
+    case Op::add6:
     {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x7;
+      rb <<= 2;
+      DO_DISS(statusMsg << "add r" << dec << rd << ",SP,#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(13);
+      rc = ra + rb;
+      write_register(rd, rc);
+      return 0;
     }
-    else if(rb < 32)
+
+    //ADD(7) sp plus immediate
+    case Op::add7:
     {
-      do_cflag_bit(rc & (1 << (rb-1)));
-      ra = rc & 0x80000000;
-      rc >>= rb;
-      if(ra) //asr, sign is shifted in
-      {
-        rc |= (~0u) << (32-rb);
-      }
+      rb = (inst >> 0) & 0x7F;
+      rb <<= 2;
+      DO_DISS(statusMsg << "add SP,#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(13);
+      rc = ra + rb;
+      write_register(13, rc);
+      return 0;
     }
-    else
+
+    //AND
+    case Op::and_:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "ands r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra & rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //ASR(1) two register immediate
+    case Op::asr1:
     {
-      if(rc & 0x80000000)
+      rd = (inst >> 0) & 0x07;
+      rm = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
+      rc = read_register(rm);
+      if(rb == 0)
       {
-        do_cflag_bit(1);
-        rc = (~0u);
+        if(rc & 0x80000000)
+        {
+          do_cflag_bit(1);
+          rc = ~0;
+        }
+        else
+        {
+          do_cflag_bit(0);
+          rc = 0;
+        }
       }
       else
       {
-        do_cflag_bit(0);
-        rc = 0;
+        do_cflag_bit(rc & (1 << (rb-1)));
+        ra = rc & 0x80000000;
+        rc >>= rb;
+        if(ra) //asr, sign is shifted in
+          rc |= (~0u) << (32-rb);
       }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
-
-  //B(1) conditional branch
-  if((inst & 0xF000) == 0xD000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    if(rb & 0x80)
-      rb |= (~0u) << 8;
-    op=(inst >> 8) & 0xF;
-    rb <<= 1;
-    rb += pc;
-    rb += 2;
-    switch(op)
-    {
-      case 0x0: //b eq  z set
-        DO_DISS(statusMsg << "beq 0x" << Base::HEX8 << (rb-3) << endl);
-        if(cpsr & CPSR_Z)
-          write_register(15, rb);
-        return 0;
-
-      case 0x1: //b ne  z clear
-        DO_DISS(statusMsg << "bne 0x" << Base::HEX8 << (rb-3) << endl);
-        if(!(cpsr & CPSR_Z))
-          write_register(15, rb);
-        return 0;
-
-      case 0x2: //b cs c set
-        DO_DISS(statusMsg << "bcs 0x" << Base::HEX8 << (rb-3) << endl);
-        if(cpsr & CPSR_C)
-          write_register(15, rb);
-        return 0;
-
-      case 0x3: //b cc c clear
-        DO_DISS(statusMsg << "bcc 0x" << Base::HEX8 << (rb-3) << endl);
-        if(!(cpsr & CPSR_C))
-          write_register(15, rb);
-        return 0;
-
-      case 0x4: //b mi n set
-        DO_DISS(statusMsg << "bmi 0x" << Base::HEX8 << (rb-3) << endl);
-        if(cpsr & CPSR_N)
-          write_register(15, rb);
-        return 0;
-
-      case 0x5: //b pl n clear
-        DO_DISS(statusMsg << "bpl 0x" << Base::HEX8 << (rb-3) << endl);
-        if(!(cpsr & CPSR_N))
-          write_register(15, rb);
-        return 0;
-
-      case 0x6: //b vs v set
-        DO_DISS(statusMsg << "bvs 0x" << Base::HEX8 << (rb-3) << endl);
-        if(cpsr & CPSR_V)
-          write_register(15,rb);
-        return 0;
-
-      case 0x7: //b vc v clear
-        DO_DISS(statusMsg << "bvc 0x" << Base::HEX8 << (rb-3) << endl);
-        if(!(cpsr & CPSR_V))
-          write_register(15, rb);
-        return 0;
-
-      case 0x8: //b hi c set z clear
-        DO_DISS(statusMsg << "bhi 0x" << Base::HEX8 << (rb-3) << endl);
-        if((cpsr & CPSR_C) && (!(cpsr & CPSR_Z)))
-          write_register(15, rb);
-        return 0;
-
-      case 0x9: //b ls c clear or z set
-        DO_DISS(statusMsg << "bls 0x" << Base::HEX8 << (rb-3) << endl);
-        if((cpsr & CPSR_Z) || (!(cpsr & CPSR_C)))
-          write_register(15, rb);
-        return 0;
-
-      case 0xA: //b ge N == V
-        DO_DISS(statusMsg << "bge 0x" << Base::HEX8 << (rb-3) << endl);
-        ra = 0;
-        if(  (cpsr & CPSR_N)  &&   (cpsr & CPSR_V) ) ra++;
-        if((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))) ra++;
-        if(ra)
-          write_register(15, rb);
-        return 0;
-
-      case 0xB: //b lt N != V
-        DO_DISS(statusMsg << "blt 0x" << Base::HEX8 << (rb-3) << endl);
-        ra = 0;
-        if((!(cpsr & CPSR_N)) && (cpsr & CPSR_V)) ra++;
-        if((!(cpsr & CPSR_V)) && (cpsr & CPSR_N)) ra++;
-        if(ra)
-          write_register(15, rb);
-        return 0;
-
-      case 0xC: //b gt Z==0 and N == V
-        DO_DISS(statusMsg << "bgt 0x" << Base::HEX8 << (rb-3) << endl);
-        ra = 0;
-        if(  (cpsr & CPSR_N)  &&   (cpsr & CPSR_V) ) ra++;
-        if((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))) ra++;
-        if(cpsr & CPSR_Z) ra = 0;
-        if(ra)
-          write_register(15, rb);
-        return 0;
-
-      case 0xD: //b le Z==1 or N != V
-        DO_DISS(statusMsg << "ble 0x" << Base::HEX8 << (rb-3) << endl);
-        ra = 0;
-        if((!(cpsr & CPSR_N)) && (cpsr & CPSR_V)) ra++;
-        if((!(cpsr & CPSR_V)) && (cpsr & CPSR_N)) ra++;
-        if(cpsr & CPSR_Z) ra++;
-        if(ra)
-          write_register(15, rb);
-        return 0;
-
-      case 0xE:
-        //undefined instruction
-        break;
-
-      case 0xF:
-        //swi
-        break;
-    }
-  }
-
-  //B(2) unconditional branch
-  if((inst & 0xF800) == 0xE000)
-  {
-    rb = (inst >> 0) & 0x7FF;
-    if(rb & (1 << 10))
-      rb |= (~0u) << 11;
-    rb <<= 1;
-    rb += pc;
-    rb += 2;
-    DO_DISS(statusMsg << "B 0x" << Base::HEX8 << (rb-3) << endl);
-    write_register(15, rb);
-    return 0;
-  }
-
-  //BIC
-  if((inst & 0xFFC0) == 0x4380)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "bics r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra & (~rb);
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
-
-  //BKPT
-  if((inst & 0xFF00) == 0xBE00)
-  {
-    rb = (inst >> 0) & 0xFF;
-    statusMsg << "bkpt 0x" << Base::HEX2 << rb << endl;
-    return 1;
-  }
 
-  //BL/BLX(1)
-  if((inst & 0xE000) == 0xE000) //BL,BLX
-  {
-    if((inst & 0x1800) == 0x1000) //H=b10
+    //ASR(2) two register
+    case Op::asr2:
     {
-      DO_DISS(statusMsg << endl);
-      rb = inst & ((1 << 11) - 1);
-      if(rb & 1<<10) rb |= (~((1 << 11) - 1)); //sign extend
-      rb <<= 12;
-      rb += pc;
-      write_register(14, rb);
+      rd = (inst >> 0) & 0x07;
+      rs = (inst >> 3) & 0x07;
+      DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rs << endl);
+      rc = read_register(rd);
+      rb = read_register(rs);
+      rb &= 0xFF;
+      if(rb == 0)
+      {
+      }
+      else if(rb < 32)
+      {
+        do_cflag_bit(rc & (1 << (rb-1)));
+        ra = rc & 0x80000000;
+        rc >>= rb;
+        if(ra) //asr, sign is shifted in
+        {
+          rc |= (~0u) << (32-rb);
+        }
+      }
+      else
+      {
+        if(rc & 0x80000000)
+        {
+          do_cflag_bit(1);
+          rc = (~0u);
+        }
+        else
+        {
+          do_cflag_bit(0);
+          rc = 0;
+        }
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
       return 0;
     }
-    else if((inst & 0x1800) == 0x1800) //H=b11
+
+    //B(1) conditional branch
+    case Op::b1:
     {
-      //branch to thumb
-      rb = read_register(14);
-      rb += (inst & ((1 << 11) - 1)) << 1;;
+      rb = (inst >> 0) & 0xFF;
+      if(rb & 0x80)
+        rb |= (~0u) << 8;
+      op=(inst >> 8) & 0xF;
+      rb <<= 1;
+      rb += pc;
       rb += 2;
-      DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
-      write_register(14, (pc-2) | 1);
-      write_register(15, rb);
-      return 0;
+      switch(op)
+      {
+        case 0x0: //b eq  z set
+          DO_DISS(statusMsg << "beq 0x" << Base::HEX8 << (rb-3) << endl);
+          if(cpsr & CPSR_Z)
+            write_register(15, rb);
+          return 0;
+
+        case 0x1: //b ne  z clear
+          DO_DISS(statusMsg << "bne 0x" << Base::HEX8 << (rb-3) << endl);
+          if(!(cpsr & CPSR_Z))
+            write_register(15, rb);
+          return 0;
+
+        case 0x2: //b cs c set
+          DO_DISS(statusMsg << "bcs 0x" << Base::HEX8 << (rb-3) << endl);
+          if(cpsr & CPSR_C)
+            write_register(15, rb);
+          return 0;
+
+        case 0x3: //b cc c clear
+          DO_DISS(statusMsg << "bcc 0x" << Base::HEX8 << (rb-3) << endl);
+          if(!(cpsr & CPSR_C))
+            write_register(15, rb);
+          return 0;
+
+        case 0x4: //b mi n set
+          DO_DISS(statusMsg << "bmi 0x" << Base::HEX8 << (rb-3) << endl);
+          if(cpsr & CPSR_N)
+            write_register(15, rb);
+          return 0;
+
+        case 0x5: //b pl n clear
+          DO_DISS(statusMsg << "bpl 0x" << Base::HEX8 << (rb-3) << endl);
+          if(!(cpsr & CPSR_N))
+            write_register(15, rb);
+          return 0;
+
+        case 0x6: //b vs v set
+          DO_DISS(statusMsg << "bvs 0x" << Base::HEX8 << (rb-3) << endl);
+          if(cpsr & CPSR_V)
+            write_register(15,rb);
+          return 0;
+
+        case 0x7: //b vc v clear
+          DO_DISS(statusMsg << "bvc 0x" << Base::HEX8 << (rb-3) << endl);
+          if(!(cpsr & CPSR_V))
+            write_register(15, rb);
+          return 0;
+
+        case 0x8: //b hi c set z clear
+          DO_DISS(statusMsg << "bhi 0x" << Base::HEX8 << (rb-3) << endl);
+          if((cpsr & CPSR_C) && (!(cpsr & CPSR_Z)))
+            write_register(15, rb);
+          return 0;
+
+        case 0x9: //b ls c clear or z set
+          DO_DISS(statusMsg << "bls 0x" << Base::HEX8 << (rb-3) << endl);
+          if((cpsr & CPSR_Z) || (!(cpsr & CPSR_C)))
+            write_register(15, rb);
+          return 0;
+
+        case 0xA: //b ge N == V
+          DO_DISS(statusMsg << "bge 0x" << Base::HEX8 << (rb-3) << endl);
+          ra = 0;
+          if(  (cpsr & CPSR_N)  &&   (cpsr & CPSR_V) ) ra++;
+          if((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))) ra++;
+          if(ra)
+            write_register(15, rb);
+          return 0;
+
+        case 0xB: //b lt N != V
+          DO_DISS(statusMsg << "blt 0x" << Base::HEX8 << (rb-3) << endl);
+          ra = 0;
+          if((!(cpsr & CPSR_N)) && (cpsr & CPSR_V)) ra++;
+          if((!(cpsr & CPSR_V)) && (cpsr & CPSR_N)) ra++;
+          if(ra)
+            write_register(15, rb);
+          return 0;
+
+        case 0xC: //b gt Z==0 and N == V
+          DO_DISS(statusMsg << "bgt 0x" << Base::HEX8 << (rb-3) << endl);
+          ra = 0;
+          if(  (cpsr & CPSR_N)  &&   (cpsr & CPSR_V) ) ra++;
+          if((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))) ra++;
+          if(cpsr & CPSR_Z) ra = 0;
+          if(ra)
+            write_register(15, rb);
+          return 0;
+
+        case 0xD: //b le Z==1 or N != V
+          DO_DISS(statusMsg << "ble 0x" << Base::HEX8 << (rb-3) << endl);
+          ra = 0;
+          if((!(cpsr & CPSR_N)) && (cpsr & CPSR_V)) ra++;
+          if((!(cpsr & CPSR_V)) && (cpsr & CPSR_N)) ra++;
+          if(cpsr & CPSR_Z) ra++;
+          if(ra)
+            write_register(15, rb);
+          return 0;
+
+        case 0xE:
+          //undefined instruction
+          break;
+
+        case 0xF:
+          //swi
+          break;
+      }
     }
-    else if((inst & 0x1800) == 0x0800) //H=b01
+    break;
+
+    //B(2) unconditional branch
+    case Op::b2:
     {
-      //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
-      // fxq: this should exit the code without having to detect it
-      rb = read_register(14);
-      rb += (inst & ((1 << 11) - 1)) << 1;;
-      rb &= 0xFFFFFFFC;
+      rb = (inst >> 0) & 0x7FF;
+      if(rb & (1 << 10))
+        rb |= (~0u) << 11;
+      rb <<= 1;
+      rb += pc;
       rb += 2;
-      DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
-      write_register(14, (pc-2) | 1);
+      DO_DISS(statusMsg << "B 0x" << Base::HEX8 << (rb-3) << endl);
       write_register(15, rb);
       return 0;
     }
-  }
 
-  //BLX(2)
-  if((inst & 0xFF87) == 0x4780)
-  {
-    rm = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "blx r" << dec << rm << endl);
-    rc = read_register(rm);
-    //fprintf(stderr,"blx r%u 0x%X 0x%X\n",rm,rc,pc);
-    rc += 2;
-    if(rc & 1)
+    //BIC
+    case Op::bic:
     {
-      write_register(14, (pc-2) | 1);
-      rc &= ~1;
-      write_register(15, rc);
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "bics r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra & (~rb);
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
       return 0;
     }
-    else
+
+    //BKPT
+    case Op::bkpt:
     {
-      //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
-      // fxq: this could serve as exit code
+      rb = (inst >> 0) & 0xFF;
+      statusMsg << "bkpt 0x" << Base::HEX2 << rb << endl;
       return 1;
     }
-  }
 
-  //BX
-  if((inst & 0xFF87) == 0x4700)
-  {
-    rm = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "bx r" << dec << rm << endl);
-    rc = read_register(rm);
-    rc += 2;
-    //fprintf(stderr,"bx r%u 0x%X 0x%X\n",rm,rc,pc);
-    if(rc & 1)
+    //BL/BLX(1)
+    case Op::bl: //BL,BLX
     {
-      // branch to odd address denotes 16 bit ARM code
-      rc &= ~1;
-      write_register(15, rc);
-      return 0;
+      if((inst & 0x1800) == 0x1000) //H=b10
+      {
+        DO_DISS(statusMsg << endl);
+        rb = inst & ((1 << 11) - 1);
+        if(rb & 1<<10) rb |= (~((1 << 11) - 1)); //sign extend
+        rb <<= 12;
+        rb += pc;
+        write_register(14, rb);
+        return 0;
+      }
+      else if((inst & 0x1800) == 0x1800) //H=b11
+      {
+        //branch to thumb
+        rb = read_register(14);
+        rb += (inst & ((1 << 11) - 1)) << 1;;
+        rb += 2;
+        DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
+        write_register(14, (pc-2) | 1);
+        write_register(15, rb);
+        return 0;
+      }
+      else if((inst & 0x1800) == 0x0800) //H=b01
+      {
+        //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
+        // fxq: this should exit the code without having to detect it
+        rb = read_register(14);
+        rb += (inst & ((1 << 11) - 1)) << 1;;
+        rb &= 0xFFFFFFFC;
+        rb += 2;
+        DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
+        write_register(14, (pc-2) | 1);
+        write_register(15, rb);
+        return 0;
+      }
     }
-    else
-    {
-      // branch to even address denotes 32 bit ARM code, which the Thumbulator
-      // class does not support. So capture relavent information and hand it
-      // off to the Cartridge class for it to handle.
-
-      bool handled = false;
-
-      switch(configuration)
-      {
-        case ConfigureFor::BUS:
-          // this subroutine interface is used in the BUS driver,
-          // it starts at address 0x000006d8
-          // _SetNote:
-          //   ldr     r4, =NoteStore
-          //   bx      r4   // bx instruction at 0x000006da
-          // _ResetWave:
-          //   ldr     r4, =ResetWaveStore
-          //   bx      r4   // bx instruction at 0x000006de
-          // _GetWavePtr:
-          //   ldr     r4, =WavePtrFetch
-          //   bx      r4   // bx instruction at 0x000006e2
-          // _SetWaveSize:
-          //   ldr     r4, =WaveSizeStore
-          //   bx      r4   // bx instruction at 0x000006e6
-
-          // address to test for is + 4 due to pipelining
-
-#define BUS_SetNote     (0x000006da + 4)
-#define BUS_ResetWave   (0x000006de + 4)
-#define BUS_GetWavePtr  (0x000006e2 + 4)
-#define BUS_SetWaveSize (0x000006e6 + 4)
-
-          if      (pc == BUS_SetNote)
-          {
-            myCartridge->thumbCallback(0, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == BUS_ResetWave)
-          {
-            myCartridge->thumbCallback(1, read_register(2), 0);
-            handled = true;
-          }
-          else if (pc == BUS_GetWavePtr)
-          {
-            write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
-            handled = true;
-          }
-          else if (pc == BUS_SetWaveSize)
-          {
-            myCartridge->thumbCallback(3, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == 0x0000083a)
-          {
-            // exiting Custom ARM code, returning to BUS Driver control
-          }
-          else
-          {
-#if 0  // uncomment this for testing
-            uInt32 r0 = read_register(0);
-            uInt32 r1 = read_register(1);
-            uInt32 r2 = read_register(2);
-            uInt32 r3 = read_register(3);
-            uInt32 r4 = read_register(4);
-#endif
-            myCartridge->thumbCallback(255, 0, 0);
-          }
-
-          break;
+    break;
 
-        case ConfigureFor::CDF:
-          // this subroutine interface is used in the CDF driver,
-          // it starts at address 0x000006e0
-          // _SetNote:
-          //   ldr     r4, =NoteStore
-          //   bx      r4   // bx instruction at 0x000006e2
-          // _ResetWave:
-          //   ldr     r4, =ResetWaveStore
-          //   bx      r4   // bx instruction at 0x000006e6
-          // _GetWavePtr:
-          //   ldr     r4, =WavePtrFetch
-          //   bx      r4   // bx instruction at 0x000006ea
-          // _SetWaveSize:
-          //   ldr     r4, =WaveSizeStore
-          //   bx      r4   // bx instruction at 0x000006ee
-
-          // address to test for is + 4 due to pipelining
-
-        #define CDF_SetNote     (0x000006e2 + 4)
-        #define CDF_ResetWave   (0x000006e6 + 4)
-        #define CDF_GetWavePtr  (0x000006ea + 4)
-        #define CDF_SetWaveSize (0x000006ee + 4)
-
-          if      (pc == CDF_SetNote)
-          {
-            myCartridge->thumbCallback(0, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == CDF_ResetWave)
-          {
-            myCartridge->thumbCallback(1, read_register(2), 0);
-            handled = true;
-          }
-          else if (pc == CDF_GetWavePtr)
-          {
-            write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
-            handled = true;
-          }
-          else if (pc == CDF_SetWaveSize)
-          {
-            myCartridge->thumbCallback(3, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == 0x0000083a)
-          {
-            // exiting Custom ARM code, returning to BUS Driver control
-          }
-          else
-          {
-          #if 0  // uncomment this for testing
-            uInt32 r0 = read_register(0);
-            uInt32 r1 = read_register(1);
-            uInt32 r2 = read_register(2);
-            uInt32 r3 = read_register(3);
-            uInt32 r4 = read_register(4);
-          #endif
-            myCartridge->thumbCallback(255, 0, 0);
-          }
-
-          break;
-
-        case ConfigureFor::CDF1:
-          // this subroutine interface is used in the CDF driver,
-          // it starts at address 0x00000750
-          // _SetNote:
-          //   ldr     r4, =NoteStore
-          //   bx      r4   // bx instruction at 0x000006e2
-          // _ResetWave:
-          //   ldr     r4, =ResetWaveStore
-          //   bx      r4   // bx instruction at 0x000006e6
-          // _GetWavePtr:
-          //   ldr     r4, =WavePtrFetch
-          //   bx      r4   // bx instruction at 0x000006ea
-          // _SetWaveSize:
-          //   ldr     r4, =WaveSizeStore
-          //   bx      r4   // bx instruction at 0x000006ee
-
-          // address to test for is + 4 due to pipelining
-
-#define CDF1_SetNote     (0x00000752 + 4)
-#define CDF1_ResetWave   (0x00000756 + 4)
-#define CDF1_GetWavePtr  (0x0000075a + 4)
-#define CDF1_SetWaveSize (0x0000075e + 4)
-
-          if      (pc == CDF1_SetNote)
-          {
-            myCartridge->thumbCallback(0, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == CDF1_ResetWave)
-          {
-            myCartridge->thumbCallback(1, read_register(2), 0);
-            handled = true;
-          }
-          else if (pc == CDF1_GetWavePtr)
-          {
-            write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
-            handled = true;
-          }
-          else if (pc == CDF1_SetWaveSize)
-          {
-            myCartridge->thumbCallback(3, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == 0x0000083a)
-          {
-            // exiting Custom ARM code, returning to BUS Driver control
-          }
-          else
-          {
-#if 0  // uncomment this for testing
-            uInt32 r0 = read_register(0);
-            uInt32 r1 = read_register(1);
-            uInt32 r2 = read_register(2);
-            uInt32 r3 = read_register(3);
-            uInt32 r4 = read_register(4);
-#endif
-            myCartridge->thumbCallback(255, 0, 0);
-          }
-
-          break;
-
-        case ConfigureFor::DPCplus:
-          // no 32-bit subroutines in DPC+
-          break;
+    //BLX(2)
+    case Op::blx2:
+    {
+      rm = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "blx r" << dec << rm << endl);
+      rc = read_register(rm);
+      //fprintf(stderr,"blx r%u 0x%X 0x%X\n",rm,rc,pc);
+      rc += 2;
+      if(rc & 1)
+      {
+        write_register(14, (pc-2) | 1);
+        rc &= ~1;
+        write_register(15, rc);
+        return 0;
+      }
+      else
+      {
+        //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
+        // fxq: this could serve as exit code
+        return 1;
       }
+    }
 
-      if (handled)
+    //BX
+    case Op::bx:
+    {
+      rm = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "bx r" << dec << rm << endl);
+      rc = read_register(rm);
+      rc += 2;
+      //fprintf(stderr,"bx r%u 0x%X 0x%X\n",rm,rc,pc);
+      if(rc & 1)
       {
-        rc = read_register(14); // lr
-        rc += 2;
+        // branch to odd address denotes 16 bit ARM code
         rc &= ~1;
         write_register(15, rc);
         return 0;
       }
+      else
+      {
+        // branch to even address denotes 32 bit ARM code, which the Thumbulator
+        // class does not support. So capture relavent information and hand it
+        // off to the Cartridge class for it to handle.
 
-      return 1;
-    }
-  }
+        bool handled = false;
 
-  //CMN
-  if((inst & 0xFFC0) == 0x42C0)
-  {
-    rn = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "cmns r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra + rb;
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, rb, 0);
-    do_vflag(ra, rb, 0);
-    return 0;
-  }
+        switch(configuration)
+        {
+          case ConfigureFor::BUS:
+            // this subroutine interface is used in the BUS driver,
+            // it starts at address 0x000006d8
+            // _SetNote:
+            //   ldr     r4, =NoteStore
+            //   bx      r4   // bx instruction at 0x000006da
+            // _ResetWave:
+            //   ldr     r4, =ResetWaveStore
+            //   bx      r4   // bx instruction at 0x000006de
+            // _GetWavePtr:
+            //   ldr     r4, =WavePtrFetch
+            //   bx      r4   // bx instruction at 0x000006e2
+            // _SetWaveSize:
+            //   ldr     r4, =WaveSizeStore
+            //   bx      r4   // bx instruction at 0x000006e6
+
+            // address to test for is + 4 due to pipelining
+
+  #define BUS_SetNote     (0x000006da + 4)
+  #define BUS_ResetWave   (0x000006de + 4)
+  #define BUS_GetWavePtr  (0x000006e2 + 4)
+  #define BUS_SetWaveSize (0x000006e6 + 4)
+
+            if      (pc == BUS_SetNote)
+            {
+              myCartridge->thumbCallback(0, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == BUS_ResetWave)
+            {
+              myCartridge->thumbCallback(1, read_register(2), 0);
+              handled = true;
+            }
+            else if (pc == BUS_GetWavePtr)
+            {
+              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+              handled = true;
+            }
+            else if (pc == BUS_SetWaveSize)
+            {
+              myCartridge->thumbCallback(3, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == 0x0000083a)
+            {
+              // exiting Custom ARM code, returning to BUS Driver control
+            }
+            else
+            {
+  #if 0  // uncomment this for testing
+              uInt32 r0 = read_register(0);
+              uInt32 r1 = read_register(1);
+              uInt32 r2 = read_register(2);
+              uInt32 r3 = read_register(3);
+              uInt32 r4 = read_register(4);
+  #endif
+              myCartridge->thumbCallback(255, 0, 0);
+            }
+
+            break;
+
+          case ConfigureFor::CDF:
+            // this subroutine interface is used in the CDF driver,
+            // it starts at address 0x000006e0
+            // _SetNote:
+            //   ldr     r4, =NoteStore
+            //   bx      r4   // bx instruction at 0x000006e2
+            // _ResetWave:
+            //   ldr     r4, =ResetWaveStore
+            //   bx      r4   // bx instruction at 0x000006e6
+            // _GetWavePtr:
+            //   ldr     r4, =WavePtrFetch
+            //   bx      r4   // bx instruction at 0x000006ea
+            // _SetWaveSize:
+            //   ldr     r4, =WaveSizeStore
+            //   bx      r4   // bx instruction at 0x000006ee
+
+            // address to test for is + 4 due to pipelining
+
+          #define CDF_SetNote     (0x000006e2 + 4)
+          #define CDF_ResetWave   (0x000006e6 + 4)
+          #define CDF_GetWavePtr  (0x000006ea + 4)
+          #define CDF_SetWaveSize (0x000006ee + 4)
+
+            if      (pc == CDF_SetNote)
+            {
+              myCartridge->thumbCallback(0, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == CDF_ResetWave)
+            {
+              myCartridge->thumbCallback(1, read_register(2), 0);
+              handled = true;
+            }
+            else if (pc == CDF_GetWavePtr)
+            {
+              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+              handled = true;
+            }
+            else if (pc == CDF_SetWaveSize)
+            {
+              myCartridge->thumbCallback(3, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == 0x0000083a)
+            {
+              // exiting Custom ARM code, returning to BUS Driver control
+            }
+            else
+            {
+            #if 0  // uncomment this for testing
+              uInt32 r0 = read_register(0);
+              uInt32 r1 = read_register(1);
+              uInt32 r2 = read_register(2);
+              uInt32 r3 = read_register(3);
+              uInt32 r4 = read_register(4);
+            #endif
+              myCartridge->thumbCallback(255, 0, 0);
+            }
+
+            break;
+
+          case ConfigureFor::CDF1:
+            // this subroutine interface is used in the CDF driver,
+            // it starts at address 0x00000750
+            // _SetNote:
+            //   ldr     r4, =NoteStore
+            //   bx      r4   // bx instruction at 0x000006e2
+            // _ResetWave:
+            //   ldr     r4, =ResetWaveStore
+            //   bx      r4   // bx instruction at 0x000006e6
+            // _GetWavePtr:
+            //   ldr     r4, =WavePtrFetch
+            //   bx      r4   // bx instruction at 0x000006ea
+            // _SetWaveSize:
+            //   ldr     r4, =WaveSizeStore
+            //   bx      r4   // bx instruction at 0x000006ee
+
+            // address to test for is + 4 due to pipelining
+
+  #define CDF1_SetNote     (0x00000752 + 4)
+  #define CDF1_ResetWave   (0x00000756 + 4)
+  #define CDF1_GetWavePtr  (0x0000075a + 4)
+  #define CDF1_SetWaveSize (0x0000075e + 4)
+
+            if      (pc == CDF1_SetNote)
+            {
+              myCartridge->thumbCallback(0, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == CDF1_ResetWave)
+            {
+              myCartridge->thumbCallback(1, read_register(2), 0);
+              handled = true;
+            }
+            else if (pc == CDF1_GetWavePtr)
+            {
+              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+              handled = true;
+            }
+            else if (pc == CDF1_SetWaveSize)
+            {
+              myCartridge->thumbCallback(3, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == 0x0000083a)
+            {
+              // exiting Custom ARM code, returning to BUS Driver control
+            }
+            else
+            {
+  #if 0  // uncomment this for testing
+              uInt32 r0 = read_register(0);
+              uInt32 r1 = read_register(1);
+              uInt32 r2 = read_register(2);
+              uInt32 r3 = read_register(3);
+              uInt32 r4 = read_register(4);
+  #endif
+              myCartridge->thumbCallback(255, 0, 0);
+            }
 
-  //CMP(1) compare immediate
-  if((inst & 0xF800) == 0x2800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rn = (inst >> 8) & 0x07;
-    DO_DISS(statusMsg << "cmp r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(rn);
-    rc = ra - rb;
-    //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
+            break;
 
-  //CMP(2) compare register
-  if((inst & 0xFFC0) == 0x4280)
-  {
-    rn = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra - rb;
-    //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
+          case ConfigureFor::DPCplus:
+            // no 32-bit subroutines in DPC+
+            break;
+        }
 
-  //CMP(3) compare high register
-  if((inst & 0xFF00) == 0x4500)
-  {
-    if(((inst >> 6) & 3) == 0x0)
-    {
-      //UNPREDICTABLE
-    }
-    rn = (inst >> 0) & 0x7;
-    rn |= (inst >> 4) & 0x8;
-    if(rn == 0xF)
-    {
-      //UNPREDICTABLE
-    }
-    rm = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra - rb;
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
+        if (handled)
+        {
+          rc = read_register(14); // lr
+          rc += 2;
+          rc &= ~1;
+          write_register(15, rc);
+          return 0;
+        }
 
-  //CPS
-  if((inst & 0xFFE8) == 0xB660)
-  {
-    DO_DISS(statusMsg << "cps TODO" << endl);
-    return 1;
-  }
+        return 1;
+      }
+    }
 
-  //CPY copy high register
-  if((inst & 0xFFC0) == 0x4600)
-  {
-    //same as mov except you can use both low registers
-    //going to let mov handle high registers
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "cpy r" << dec << rd << ",r" << dec << rm << endl);
-    rc = read_register(rm);
-    write_register(rd, rc);
-    return 0;
-  }
+    //CMN
+    case Op::cmn:
+    {
+      rn = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "cmns r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra + rb;
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, rb, 0);
+      do_vflag(ra, rb, 0);
+      return 0;
+    }
 
-  //EOR
-  if((inst & 0xFFC0) == 0x4040)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "eors r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra ^ rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    //CMP(1) compare immediate
+    case Op::cmp1:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rn = (inst >> 8) & 0x07;
+      DO_DISS(statusMsg << "cmp r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rn);
+      rc = ra - rb;
+      //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
+    }
 
-  //LDMIA
-  if((inst & 0xF800) == 0xC800)
-  {
-    rn = (inst >> 8) & 0x7;
-  #if defined(THUMB_DISS)
-    statusMsg << "ldmia r" << dec << rn << "!,{";
-    for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+    //CMP(2) compare register
+    case Op::cmp2:
     {
-      if(inst&rb)
-      {
-        if(rc) statusMsg << ",";
-        statusMsg << "r" << dec << ra;
-        rc++;
-      }
+      rn = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra - rb;
+      //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
     }
-    statusMsg << "}" << endl;
-  #endif
-    sp = read_register(rn);
-    for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+
+    //CMP(3) compare high register
+    case Op::cmp3:
     {
-      if(inst & rb)
+      if(((inst >> 6) & 3) == 0x0)
       {
-        write_register(ra, read32(sp));
-        sp += 4;
+        //UNPREDICTABLE
       }
+      rn = (inst >> 0) & 0x7;
+      rn |= (inst >> 4) & 0x8;
+      if(rn == 0xF)
+      {
+        //UNPREDICTABLE
+      }
+      rm = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra - rb;
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
     }
-    //there is a write back exception.
-    if((inst & (1 << rn)) == 0)
-      write_register(rn, sp);
 
-    return 0;
-  }
-
-  //LDR(1) two register immediate
-  if((inst & 0xF800) == 0x6800)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    rb <<= 2;
-    DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc = read32(rb);
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //LDR(2) three register
-  if((inst & 0xFE00) == 0x5800)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",r" << dec << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read32(rb);
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //LDR(3)
-  if((inst & 0xF800) == 0x4800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    rb <<= 2;
-    DO_DISS(statusMsg << "ldr r" << dec << rd << ",[PC+#0x" << Base::HEX2 << rb << "] ");
-    ra = read_register(15);
-    ra &= ~3;
-    rb += ra;
-    DO_DISS(statusMsg << ";@ 0x" << Base::HEX2 << rb << endl);
-    rc = read32(rb);
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //LDR(4)
-  if((inst & 0xF800) == 0x9800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    rb <<= 2;
-    DO_DISS(statusMsg << "ldr r" << dec << rd << ",[SP+#0x" << Base::HEX2 << rb << "]" << endl);
-    ra = read_register(13);
-    //ra&=~3;
-    rb += ra;
-    rc = read32(rb);
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //LDRB(1)
-  if((inst & 0xF800) == 0x7800)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc = read16(rb & (~1u));
-    if(rb & 1)
+    //CPS
+    case Op::cps:
     {
-      rc >>= 8;
+      DO_DISS(statusMsg << "cps TODO" << endl);
+      return 1;
     }
-    else
+
+    //CPY copy high register
+    case Op::cpy:
     {
+      //same as mov except you can use both low registers
+      //going to let mov handle high registers
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "cpy r" << dec << rd << ",r" << dec << rm << endl);
+      rc = read_register(rm);
+      write_register(rd, rc);
+      return 0;
     }
-    write_register(rd, rc & 0xFF);
-    return 0;
-  }
 
-  //LDRB(2)
-  if((inst & 0xFE00) == 0x5C00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read16(rb & (~1u));
-    if(rb & 1)
+    //EOR
+    case Op::eor:
     {
-      rc >>= 8;
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "eors r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra ^ rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    else
+
+    //LDMIA
+    case Op::ldmia:
     {
-    }
-    write_register(rd, rc & 0xFF);
-    return 0;
-  }
+      rn = (inst >> 8) & 0x7;
+    #if defined(THUMB_DISS)
+      statusMsg << "ldmia r" << dec << rn << "!,{";
+      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+      {
+        if(inst&rb)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "r" << dec << ra;
+          rc++;
+        }
+      }
+      statusMsg << "}" << endl;
+    #endif
+      sp = read_register(rn);
+      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+      {
+        if(inst & rb)
+        {
+          write_register(ra, read32(sp));
+          sp += 4;
+        }
+      }
+      //there is a write back exception.
+      if((inst & (1 << rn)) == 0)
+        write_register(rn, sp);
 
-  //LDRH(1)
-  if((inst & 0xF800) == 0x8800)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    rb <<= 1;
-    DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb=read_register(rn) + rb;
-    rc = read16(rb);
-    write_register(rd, rc & 0xFFFF);
-    return 0;
-  }
+      return 0;
+    }
 
-  //LDRH(2)
-  if((inst & 0xFE00) == 0x5A00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read16(rb);
-    write_register(rd, rc & 0xFFFF);
-    return 0;
-  }
+    //LDR(1) two register immediate
+    case Op::ldr1:
+    {
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      rb <<= 2;
+      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc = read32(rb);
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //LDRSB
-  if((inst & 0xFE00) == 0x5600)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldrsb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read16(rb & (~1u));
-    if(rb & 1)
+    //LDR(2) three register
+    case Op::ldr2:
     {
-      rc >>= 8;
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",r" << dec << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read32(rb);
+      write_register(rd, rc);
+      return 0;
     }
-    else
+
+    //LDR(3)
+    case Op::ldr3:
     {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      rb <<= 2;
+      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[PC+#0x" << Base::HEX2 << rb << "] ");
+      ra = read_register(15);
+      ra &= ~3;
+      rb += ra;
+      DO_DISS(statusMsg << ";@ 0x" << Base::HEX2 << rb << endl);
+      rc = read32(rb);
+      write_register(rd, rc);
+      return 0;
     }
-    rc &= 0xFF;
-    if(rc & 0x80)
-      rc |= ((~0u) << 8);
-    write_register(rd, rc);
-    return 0;
-  }
 
-  //LDRSH
-  if((inst & 0xFE00) == 0x5E00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldrsh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read16(rb);
-    rc &= 0xFFFF;
-    if(rc & 0x8000)
-      rc |= ((~0u) << 16);
-    write_register(rd, rc);
-    return 0;
-  }
+    //LDR(4)
+    case Op::ldr4:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      rb <<= 2;
+      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[SP+#0x" << Base::HEX2 << rb << "]" << endl);
+      ra = read_register(13);
+      //ra&=~3;
+      rb += ra;
+      rc = read32(rb);
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //LSL(1)
-  if((inst & 0xF800) == 0x0000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rm = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
-    rc = read_register(rm);
-    if(rb == 0)
+    //LDRB(1)
+    case Op::ldrb1:
     {
-      //if immed_5 == 0
-      //C unaffected
-      //result not shifted
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc = read16(rb & (~1u));
+      if(rb & 1)
+      {
+        rc >>= 8;
+      }
+      else
+      {
+      }
+      write_register(rd, rc & 0xFF);
+      return 0;
     }
-    else
+
+    //LDRB(2)
+    case Op::ldrb2:
     {
-      //else immed_5 > 0
-      do_cflag_bit(rc & (1 << (32-rb)));
-      rc <<= rb;
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read16(rb & (~1u));
+      if(rb & 1)
+      {
+        rc >>= 8;
+      }
+      else
+      {
+      }
+      write_register(rd, rc & 0xFF);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //LSL(2) two register
-  if((inst & 0xFFC0) == 0x4080)
-  {
-    rd = (inst >> 0) & 0x07;
-    rs = (inst >> 3) & 0x07;
-    DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rs << endl);
-    rc = read_register(rd);
-    rb = read_register(rs);
-    rb &= 0xFF;
-    if(rb == 0)
+    //LDRH(1)
+    case Op::ldrh1:
     {
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      rb <<= 1;
+      DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb=read_register(rn) + rb;
+      rc = read16(rb);
+      write_register(rd, rc & 0xFFFF);
+      return 0;
     }
-    else if(rb < 32)
+
+    //LDRH(2)
+    case Op::ldrh2:
     {
-      do_cflag_bit(rc & (1 << (32-rb)));
-      rc <<= rb;
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read16(rb);
+      write_register(rd, rc & 0xFFFF);
+      return 0;
     }
-    else if(rb == 32)
+
+    //LDRSB
+    case Op::ldrsb:
     {
-      do_cflag_bit(rc & 1);
-      rc = 0;
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldrsb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read16(rb & (~1u));
+      if(rb & 1)
+      {
+        rc >>= 8;
+      }
+      else
+      {
+      }
+      rc &= 0xFF;
+      if(rc & 0x80)
+        rc |= ((~0u) << 8);
+      write_register(rd, rc);
+      return 0;
     }
-    else
+
+    //LDRSH
+    case Op::ldrsh:
     {
-      do_cflag_bit(0);
-      rc = 0;
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldrsh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read16(rb);
+      rc &= 0xFFFF;
+      if(rc & 0x8000)
+        rc |= ((~0u) << 16);
+      write_register(rd, rc);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //LSR(1) two register immediate
-  if((inst & 0xF800) == 0x0800)
-  {
-    rd = (inst >> 0) & 0x07;
-    rm = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
-    rc = read_register(rm);
-    if(rb == 0)
+    //LSL(1)
+    case Op::lsl1:
     {
-      do_cflag_bit(rc & 0x80000000);
-      rc = 0;
+      rd = (inst >> 0) & 0x07;
+      rm = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
+      rc = read_register(rm);
+      if(rb == 0)
+      {
+        //if immed_5 == 0
+        //C unaffected
+        //result not shifted
+      }
+      else
+      {
+        //else immed_5 > 0
+        do_cflag_bit(rc & (1 << (32-rb)));
+        rc <<= rb;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    else
+
+    //LSL(2) two register
+    case Op::lsl2:
     {
-      do_cflag_bit(rc & (1 << (rb-1)));
-      rc >>= rb;
+      rd = (inst >> 0) & 0x07;
+      rs = (inst >> 3) & 0x07;
+      DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rs << endl);
+      rc = read_register(rd);
+      rb = read_register(rs);
+      rb &= 0xFF;
+      if(rb == 0)
+      {
+      }
+      else if(rb < 32)
+      {
+        do_cflag_bit(rc & (1 << (32-rb)));
+        rc <<= rb;
+      }
+      else if(rb == 32)
+      {
+        do_cflag_bit(rc & 1);
+        rc = 0;
+      }
+      else
+      {
+        do_cflag_bit(0);
+        rc = 0;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //LSR(2) two register
-  if((inst & 0xFFC0) == 0x40C0)
-  {
-    rd = (inst >> 0) & 0x07;
-    rs = (inst >> 3) & 0x07;
-    DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rs << endl);
-    rc = read_register(rd);
-    rb = read_register(rs);
-    rb &= 0xFF;
-    if(rb == 0)
+    //LSR(1) two register immediate
+    case Op::lsr1:
     {
+      rd = (inst >> 0) & 0x07;
+      rm = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
+      rc = read_register(rm);
+      if(rb == 0)
+      {
+        do_cflag_bit(rc & 0x80000000);
+        rc = 0;
+      }
+      else
+      {
+        do_cflag_bit(rc & (1 << (rb-1)));
+        rc >>= rb;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    else if(rb < 32)
+
+    //LSR(2) two register
+    case Op::lsr2:
     {
-      do_cflag_bit(rc & (1 << (rb-1)));
-      rc >>= rb;
+      rd = (inst >> 0) & 0x07;
+      rs = (inst >> 3) & 0x07;
+      DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rs << endl);
+      rc = read_register(rd);
+      rb = read_register(rs);
+      rb &= 0xFF;
+      if(rb == 0)
+      {
+      }
+      else if(rb < 32)
+      {
+        do_cflag_bit(rc & (1 << (rb-1)));
+        rc >>= rb;
+      }
+      else if(rb == 32)
+      {
+        do_cflag_bit(rc & 0x80000000);
+        rc = 0;
+      }
+      else
+      {
+        do_cflag_bit(0);
+        rc = 0;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    else if(rb == 32)
+
+    //MOV(1) immediate
+    case Op::mov1:
     {
-      do_cflag_bit(rc & 0x80000000);
-      rc = 0;
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      DO_DISS(statusMsg << "movs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
+      write_register(rd, rb);
+      do_nflag(rb);
+      do_zflag(rb);
+      return 0;
     }
-    else
+
+    //MOV(2) two low registers
+    case Op::mov2:
     {
+      rd = (inst >> 0) & 7;
+      rn = (inst >> 3) & 7;
+      DO_DISS(statusMsg << "movs r" << dec << rd << ",r" << dec << rn << endl);
+      rc = read_register(rn);
+      //fprintf(stderr,"0x%08X\n",rc);
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
       do_cflag_bit(0);
-      rc = 0;
+      do_vflag_bit(0);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //MOV(1) immediate
-  if((inst & 0xF800) == 0x2000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    DO_DISS(statusMsg << "movs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
-    write_register(rd, rb);
-    do_nflag(rb);
-    do_zflag(rb);
-    return 0;
-  }
-
-  //MOV(2) two low registers
-  if((inst & 0xFFC0) == 0x1C00)
-  {
-    rd = (inst >> 0) & 7;
-    rn = (inst >> 3) & 7;
-    DO_DISS(statusMsg << "movs r" << dec << rd << ",r" << dec << rn << endl);
-    rc = read_register(rn);
-    //fprintf(stderr,"0x%08X\n",rc);
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag_bit(0);
-    do_vflag_bit(0);
-    return 0;
-  }
-
-  //MOV(3)
-  if((inst & 0xFF00) == 0x4600)
-  {
-    rd  = (inst >> 0) & 0x7;
-    rd |= (inst >> 4) & 0x8;
-    rm  = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "mov r" << dec << rd << ",r" << dec << rm << endl);
-    rc = read_register(rm);
-    if((rd == 14) && (rm == 15))
+    //MOV(3)
+    case Op::mov3:
     {
-      //printf("mov lr,pc warning 0x%08X\n",pc-2);
-      //rc|=1;
+      rd  = (inst >> 0) & 0x7;
+      rd |= (inst >> 4) & 0x8;
+      rm  = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "mov r" << dec << rd << ",r" << dec << rm << endl);
+      rc = read_register(rm);
+      if((rd == 14) && (rm == 15))
+      {
+        //printf("mov lr,pc warning 0x%08X\n",pc-2);
+        //rc|=1;
+      }
+      if(rd == 15)
+      {
+        rc &= ~1; //write_register may do this as well
+        rc += 2;  //The program counter is special
+      }
+      write_register(rd, rc);
+      return 0;
     }
-    if(rd == 15)
+
+    //MUL
+    case Op::mul:
     {
-      rc &= ~1; //write_register may do this as well
-      rc += 2;  //The program counter is special
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "muls r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra * rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    write_register(rd, rc);
-    return 0;
-  }
 
-  //MUL
-  if((inst & 0xFFC0) == 0x4340)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "muls r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra * rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
-
-  //MVN
-  if((inst & 0xFFC0) == 0x43C0)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "mvns r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = (~ra);
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    //MVN
+    case Op::mvn:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "mvns r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = (~ra);
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
 
-  //NEG
-  if((inst & 0xFFC0) == 0x4240)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "negs r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = 0 - ra;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(0, ~ra, 1);
-    do_vflag(0, ~ra, 1);
-    return 0;
-  }
+    //NEG
+    case Op::neg:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "negs r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = 0 - ra;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(0, ~ra, 1);
+      do_vflag(0, ~ra, 1);
+      return 0;
+    }
 
-  //ORR
-  if((inst & 0xFFC0) == 0x4300)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "orrs r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra | rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    //ORR
+    case Op::orr:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "orrs r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra | rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
 
-  //POP
-  if((inst & 0xFE00) == 0xBC00)
-  {
-  #if defined(THUMB_DISS)
-    statusMsg << "pop {";
-    for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+    //POP
+    case Op::pop:
     {
-      if(inst&rb)
+    #if defined(THUMB_DISS)
+      statusMsg << "pop {";
+      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+      {
+        if(inst&rb)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "r" << dec << ra;
+          rc++;
+        }
+      }
+      if(inst&0x100)
       {
         if(rc) statusMsg << ",";
-        statusMsg << "r" << dec << ra;
-        rc++;
+        statusMsg << "pc";
       }
-    }
-    if(inst&0x100)
-    {
-      if(rc) statusMsg << ",";
-      statusMsg << "pc";
-    }
-    statusMsg << "}" << endl;
-  #endif
+      statusMsg << "}" << endl;
+    #endif
 
-    sp = read_register(13);
-    for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
-    {
-      if(inst & rb)
+      sp = read_register(13);
+      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+      {
+        if(inst & rb)
+        {
+          write_register(ra, read32(sp));
+          sp += 4;
+        }
+      }
+      if(inst & 0x100)
       {
-        write_register(ra, read32(sp));
+        rc = read32(sp);
+        rc += 2;
+        write_register(15, rc);
         sp += 4;
       }
+      write_register(13, sp);
+      return 0;
     }
-    if(inst & 0x100)
-    {
-      rc = read32(sp);
-      rc += 2;
-      write_register(15, rc);
-      sp += 4;
-    }
-    write_register(13, sp);
-    return 0;
-  }
 
-  //PUSH
-  if((inst & 0xFE00) == 0xB400)
-  {
-  #if defined(THUMB_DISS)
-    statusMsg << "push {";
-    for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+    //PUSH
+    case Op::push:
     {
-      if(inst&rb)
+    #if defined(THUMB_DISS)
+      statusMsg << "push {";
+      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+      {
+        if(inst&rb)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "r" << dec << ra;
+          rc++;
+        }
+      }
+      if(inst&0x100)
       {
         if(rc) statusMsg << ",";
-        statusMsg << "r" << dec << ra;
-        rc++;
+        statusMsg << "lr";
       }
-    }
-    if(inst&0x100)
-    {
-      if(rc) statusMsg << ",";
-      statusMsg << "lr";
-    }
-    statusMsg << "}" << endl;
-  #endif
+      statusMsg << "}" << endl;
+    #endif
 
-    sp = read_register(13);
-    //fprintf(stderr,"sp 0x%08X\n",sp);
-    for(ra = 0, rb = 0x01, rc = 0; rb; rb = (rb << 1) & 0xFF, ra++)
-    {
-      if(inst & rb)
+      sp = read_register(13);
+      //fprintf(stderr,"sp 0x%08X\n",sp);
+      for(ra = 0, rb = 0x01, rc = 0; rb; rb = (rb << 1) & 0xFF, ra++)
       {
-        rc++;
+        if(inst & rb)
+        {
+          rc++;
+        }
       }
-    }
-    if(inst & 0x100) rc++;
-    rc <<= 2;
-    sp -= rc;
-    rd = sp;
-    for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
-    {
-      if(inst & rb)
+      if(inst & 0x100) rc++;
+      rc <<= 2;
+      sp -= rc;
+      rd = sp;
+      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
       {
-        write32(rd, read_register(ra));
-        rd += 4;
+        if(inst & rb)
+        {
+          write32(rd, read_register(ra));
+          rd += 4;
+        }
       }
-    }
-    if(inst & 0x100)
-    {
-      rc = read_register(14);
-      write32(rd, rc);
-      if((rc & 1) == 0)
+      if(inst & 0x100)
       {
-        // FIXME fprintf(stderr,"push {lr} with an ARM address pc 0x%08X popped 0x%08X\n",pc,rc);
+        rc = read_register(14);
+        write32(rd, rc);
+        if((rc & 1) == 0)
+        {
+          // FIXME fprintf(stderr,"push {lr} with an ARM address pc 0x%08X popped 0x%08X\n",pc,rc);
+        }
       }
+      write_register(13, sp);
+      return 0;
     }
-    write_register(13, sp);
-    return 0;
-  }
-
-  //REV
-  if((inst & 0xFFC0) == 0xBA00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "rev r" << dec << rd << ",r" << dec << rn << endl);
-    ra = read_register(rn);
-    rc  = ((ra >>  0) & 0xFF) << 24;
-    rc |= ((ra >>  8) & 0xFF) << 16;
-    rc |= ((ra >> 16) & 0xFF) <<  8;
-    rc |= ((ra >> 24) & 0xFF) <<  0;
-    write_register(rd, rc);
-    return 0;
-  }
 
-  //REV16
-  if((inst & 0xFFC0) == 0xBA40)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "rev16 r" << dec << rd << ",r" << dec << rn << endl);
-    ra = read_register(rn);
-    rc  = ((ra >>  0) & 0xFF) <<  8;
-    rc |= ((ra >>  8) & 0xFF) <<  0;
-    rc |= ((ra >> 16) & 0xFF) << 24;
-    rc |= ((ra >> 24) & 0xFF) << 16;
-    write_register(rd, rc);
-    return 0;
-  }
+    //REV
+    case Op::rev:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "rev r" << dec << rd << ",r" << dec << rn << endl);
+      ra = read_register(rn);
+      rc  = ((ra >>  0) & 0xFF) << 24;
+      rc |= ((ra >>  8) & 0xFF) << 16;
+      rc |= ((ra >> 16) & 0xFF) <<  8;
+      rc |= ((ra >> 24) & 0xFF) <<  0;
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //REVSH
-  if((inst & 0xFFC0) == 0xBAC0)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "revsh r" << dec << rd << ",r" << dec << rn << endl);
-    ra = read_register(rn);
-    rc  = ((ra >> 0) & 0xFF) << 8;
-    rc |= ((ra >> 8) & 0xFF) << 0;
-    if(rc & 0x8000) rc |= 0xFFFF0000;
-    else            rc &= 0x0000FFFF;
-    write_register(rd, rc);
-    return 0;
-  }
+    //REV16
+    case Op::rev16:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "rev16 r" << dec << rd << ",r" << dec << rn << endl);
+      ra = read_register(rn);
+      rc  = ((ra >>  0) & 0xFF) <<  8;
+      rc |= ((ra >>  8) & 0xFF) <<  0;
+      rc |= ((ra >> 16) & 0xFF) << 24;
+      rc |= ((ra >> 24) & 0xFF) << 16;
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //ROR
-  if((inst & 0xFFC0) == 0x41C0)
-  {
-    rd = (inst >> 0) & 0x7;
-    rs = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "rors r" << dec << rd << ",r" << dec << rs << endl);
-    rc = read_register(rd);
-    ra = read_register(rs);
-    ra &= 0xFF;
-    if(ra == 0)
+    //REVSH
+    case Op::revsh:
     {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "revsh r" << dec << rd << ",r" << dec << rn << endl);
+      ra = read_register(rn);
+      rc  = ((ra >> 0) & 0xFF) << 8;
+      rc |= ((ra >> 8) & 0xFF) << 0;
+      if(rc & 0x8000) rc |= 0xFFFF0000;
+      else            rc &= 0x0000FFFF;
+      write_register(rd, rc);
+      return 0;
     }
-    else
+
+    //ROR
+    case Op::ror:
     {
-      ra &= 0x1F;
+      rd = (inst >> 0) & 0x7;
+      rs = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "rors r" << dec << rd << ",r" << dec << rs << endl);
+      rc = read_register(rd);
+      ra = read_register(rs);
+      ra &= 0xFF;
       if(ra == 0)
       {
-        do_cflag_bit(rc & 0x80000000);
       }
       else
       {
-        do_cflag_bit(rc & (1 << (ra-1)));
-        rb = rc << (32-ra);
-        rc >>= ra;
-        rc |= rb;
+        ra &= 0x1F;
+        if(ra == 0)
+        {
+          do_cflag_bit(rc & 0x80000000);
+        }
+        else
+        {
+          do_cflag_bit(rc & (1 << (ra-1)));
+          rb = rc << (32-ra);
+          rc >>= ra;
+          rc |= rb;
+        }
       }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //SBC
-  if((inst & 0xFFC0) == 0x4180)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "sbc r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra - rb;
-    if(!(cpsr & CPSR_C)) rc--;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    if(cpsr & CPSR_C)
+    //SBC
+    case Op::sbc:
     {
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "sbc r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra - rb;
+      if(!(cpsr & CPSR_C)) rc--;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      if(cpsr & CPSR_C)
+      {
+        do_cflag(ra, ~rb, 1);
+        do_vflag(ra, ~rb, 1);
+      }
+      else
+      {
+        do_cflag(ra, ~rb, 0);
+        do_vflag(ra, ~rb, 0);
+      }
+      return 0;
     }
-    else
+
+    //SETEND
+    case Op::setend:
     {
-      do_cflag(ra, ~rb, 0);
-      do_vflag(ra, ~rb, 0);
+      statusMsg << "setend not implemented" << endl;
+      return 1;
     }
-    return 0;
-  }
-
-  //SETEND
-  if((inst & 0xFFF7) == 0xB650)
-  {
-    statusMsg << "setend not implemented" << endl;
-    return 1;
-  }
 
-  //STMIA
-  if((inst & 0xF800) == 0xC000)
-  {
-    rn = (inst >> 8) & 0x7;
-  #if defined(THUMB_DISS)
-    statusMsg << "stmia r" << dec << rn << "!,{";
-    for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+    //STMIA
+    case Op::stmia:
     {
-      if(inst & rb)
+      rn = (inst >> 8) & 0x7;
+    #if defined(THUMB_DISS)
+      statusMsg << "stmia r" << dec << rn << "!,{";
+      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
       {
-        if(rc) statusMsg << ",";
-        statusMsg << "r" << dec << ra;
-        rc++;
+        if(inst & rb)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "r" << dec << ra;
+          rc++;
+        }
       }
-    }
-    statusMsg << "}" << endl;
-  #endif
+      statusMsg << "}" << endl;
+    #endif
 
-    sp = read_register(rn);
-    for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
-    {
-      if(inst & rb)
+      sp = read_register(rn);
+      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
       {
-        write32(sp, read_register(ra));
-        sp += 4;
+        if(inst & rb)
+        {
+          write32(sp, read_register(ra));
+          sp += 4;
+        }
       }
+      write_register(rn, sp);
+      return 0;
     }
-    write_register(rn, sp);
-    return 0;
-  }
-
-  //STR(1)
-  if((inst & 0xF800) == 0x6000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    rb <<= 2;
-    DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc = read_register(rd);
-    write32(rb, rc);
-    return 0;
-  }
 
-  //STR(2)
-  if((inst & 0xFE00) == 0x5000)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read_register(rd);
-    write32(rb, rc);
-    return 0;
-  }
+    //STR(1)
+    case Op::str1:
+    {
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      rb <<= 2;
+      DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc = read_register(rd);
+      write32(rb, rc);
+      return 0;
+    }
 
-  //STR(3)
-  if((inst & 0xF800) == 0x9000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    rb <<= 2;
-    DO_DISS(statusMsg << "str r" << dec << rd << ",[SP,#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(13) + rb;
-    //fprintf(stderr,"0x%08X\n",rb);
-    rc = read_register(rd);
-    write32(rb, rc);
-    return 0;
-  }
+    //STR(2)
+    case Op::str2:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read_register(rd);
+      write32(rb, rc);
+      return 0;
+    }
 
-  //STRB(1)
-  if((inst & 0xF800) == 0x7000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX8 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc = read_register(rd);
-    ra = read16(rb & (~1u));
-    if(rb & 1)
-    {
-      ra &= 0x00FF;
-      ra |= rc << 8;
+    //STR(3)
+    case Op::str3:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      rb <<= 2;
+      DO_DISS(statusMsg << "str r" << dec << rd << ",[SP,#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(13) + rb;
+      //fprintf(stderr,"0x%08X\n",rb);
+      rc = read_register(rd);
+      write32(rb, rc);
+      return 0;
     }
-    else
+
+    //STRB(1)
+    case Op::strb1:
     {
-      ra &= 0xFF00;
-      ra |= rc & 0x00FF;
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX8 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc = read_register(rd);
+      ra = read16(rb & (~1u));
+      if(rb & 1)
+      {
+        ra &= 0x00FF;
+        ra |= rc << 8;
+      }
+      else
+      {
+        ra &= 0xFF00;
+        ra |= rc & 0x00FF;
+      }
+      write16(rb & (~1u), ra & 0xFFFF);
+      return 0;
     }
-    write16(rb & (~1u), ra & 0xFFFF);
-    return 0;
-  }
 
-  //STRB(2)
-  if((inst & 0xFE00) == 0x5400)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",r" << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read_register(rd);
-    ra = read16(rb & (~1u));
-    if(rb & 1)
-    {
-      ra &= 0x00FF;
-      ra |= rc << 8;
+    //STRB(2)
+    case Op::strb2:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",r" << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read_register(rd);
+      ra = read16(rb & (~1u));
+      if(rb & 1)
+      {
+        ra &= 0x00FF;
+        ra |= rc << 8;
+      }
+      else
+      {
+        ra &= 0xFF00;
+        ra |= rc & 0x00FF;
+      }
+      write16(rb & (~1u), ra & 0xFFFF);
+      return 0;
     }
-    else
+
+    //STRH(1)
+    case Op::strh1:
     {
-      ra &= 0xFF00;
-      ra |= rc & 0x00FF;
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      rb <<= 1;
+      DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc=  read_register(rd);
+      write16(rb, rc & 0xFFFF);
+      return 0;
     }
-    write16(rb & (~1u), ra & 0xFFFF);
-    return 0;
-  }
 
-  //STRH(1)
-  if((inst & 0xF800) == 0x8000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    rb <<= 1;
-    DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc=  read_register(rd);
-    write16(rb, rc & 0xFFFF);
-    return 0;
-  }
+    //STRH(2)
+    case Op::strh2:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read_register(rd);
+      write16(rb, rc & 0xFFFF);
+      return 0;
+    }
 
-  //STRH(2)
-  if((inst & 0xFE00) == 0x5200)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read_register(rd);
-    write16(rb, rc & 0xFFFF);
-    return 0;
-  }
+    //SUB(1)
+    case Op::sub1:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rb = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rn);
+      rc = ra - rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
+    }
 
-  //SUB(1)
-  if((inst & 0xFE00) == 0x1E00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rb = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(rn);
-    rc = ra - rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
+    //SUB(2)
+    case Op::sub2:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      DO_DISS(statusMsg << "subs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rd);
+      rc = ra - rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
+    }
 
-  //SUB(2)
-  if((inst & 0xF800) == 0x3800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    DO_DISS(statusMsg << "subs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(rd);
-    rc = ra - rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
+    //SUB(3)
+    case Op::sub3:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra - rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
+    }
 
-  //SUB(3)
-  if((inst & 0xFE00) == 0x1A00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra - rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
+    //SUB(4)
+    case Op::sub4:
+    {
+      rb = inst & 0x7F;
+      rb <<= 2;
+      DO_DISS(statusMsg << "sub SP,#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(13);
+      ra -= rb;
+      write_register(13, ra);
+      return 0;
+    }
 
-  //SUB(4)
-  if((inst & 0xFF80) == 0xB080)
-  {
-    rb = inst & 0x7F;
-    rb <<= 2;
-    DO_DISS(statusMsg << "sub SP,#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(13);
-    ra -= rb;
-    write_register(13, ra);
-    return 0;
-  }
+    //SWI
+    case Op::swi:
+    {
+      rb = inst & 0xFF;
+      DO_DISS(statusMsg << "swi 0x" << Base::HEX2 << rb << endl);
 
-  //SWI
-  if((inst & 0xFF00) == 0xDF00)
-  {
-    rb = inst & 0xFF;
-    DO_DISS(statusMsg << "swi 0x" << Base::HEX2 << rb << endl);
+      if((inst & 0xFF) == 0xCC)
+      {
+        write_register(0, cpsr);
+        return 0;
+      }
+      else
+      {
+        statusMsg << endl << endl << "swi 0x" << Base::HEX2 << rb << endl;
+        return 1;
+      }
+    }
 
-    if((inst & 0xFF) == 0xCC)
+    //SXTB
+    case Op::sxtb:
     {
-      write_register(0, cpsr);
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "sxtb r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = ra & 0xFF;
+      if(rc & 0x80)
+        rc |= (~0u) << 8;
+      write_register(rd, rc);
       return 0;
     }
-    else
+
+    //SXTH
+    case Op::sxth:
     {
-      statusMsg << endl << endl << "swi 0x" << Base::HEX2 << rb << endl;
-      return 1;
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "sxth r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = ra & 0xFFFF;
+      if(rc & 0x8000)
+        rc |= (~0u) << 16;
+      write_register(rd, rc);
+      return 0;
     }
-  }
-
-  //SXTB
-  if((inst & 0xFFC0) == 0xB240)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "sxtb r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = ra & 0xFF;
-    if(rc & 0x80)
-      rc |= (~0u) << 8;
-    write_register(rd, rc);
-    return 0;
-  }
 
-  //SXTH
-  if((inst & 0xFFC0) == 0xB200)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "sxth r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = ra & 0xFFFF;
-    if(rc & 0x8000)
-      rc |= (~0u) << 16;
-    write_register(rd, rc);
-    return 0;
-  }
+    //TST
+    case Op::tst:
+    {
+      rn = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "tst r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra & rb;
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
 
-  //TST
-  if((inst & 0xFFC0) == 0x4200)
-  {
-    rn = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "tst r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra & rb;
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    //UXTB
+    case Op::uxtb:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "uxtb r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = ra & 0xFF;
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //UXTB
-  if((inst & 0xFFC0) == 0xB2C0)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "uxtb r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = ra & 0xFF;
-    write_register(rd, rc);
-    return 0;
-  }
+    //UXTH
+    case Op::uxth:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "uxth r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = ra & 0xFFFF;
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //UXTH
-  if((inst & 0xFFC0) == 0xB280)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "uxth r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = ra & 0xFFFF;
-    write_register(rd, rc);
-    return 0;
+    case Op::invalid:
+      break;
   }
 
   statusMsg << "invalid instruction " << Base::HEX8 << pc << " " << Base::HEX4 << inst << endl;
@@ -96,6 +96,87 @@ class Thumbulator
     void setConsoleTiming(ConsoleTiming timing);
 
   private:
+    // Instructions, as identified by decodeInstructionWord()
+    enum class Op : uInt8 {
+      invalid,
+      adc,
+      add1,
+      add2,
+      add3,
+      add4,
+      add5,
+      add6,
+      add7,
+      and_,
+      asr1,
+      asr2,
+      b1,
+      b2,
+      bic,
+      bkpt,
+      bl,
+      blx2,
+      bx,
+      cmn,
+      cmp1,
+      cmp2,
+      cmp3,
+      cps,
+      cpy,
+      eor,
+      ldmia,
+      ldr1,
+      ldr2,
+      ldr3,
+      ldr4,
+      ldrb1,
+      ldrb2,
+      ldrh1,
+      ldrh2,
+      ldrsb,
+      ldrsh,
+      lsl1,
+      lsl2,
+      lsr1,
+      lsr2,
+      mov1,
+      mov2,
+      mov3,
+      mul,
+      mvn,
+      neg,
+      orr,
+      pop,
+      push,
+      rev,
+      rev16,
+      revsh,
+      ror,
+      sbc,
+      setend,
+      stmia,
+      str1,
+      str2,
+      str3,
+      strb1,
+      strb2,
+      strh1,
+      strh2,
+      sub1,
+      sub2,
+      sub3,
+      sub4,
+      swi,
+      sxtb,
+      sxth,
+      tst,
+      uxtb,
+      uxth
+    };
+
+  private:
+    static Op decodeInstructionWord(uInt16 inst);
+
     uInt32 read_register(uInt32 reg);
     void write_register(uInt32 reg, uInt32 data);
     uInt32 fetch16(uInt32 addr);
@@ -129,6 +210,10 @@ class Thumbulator
     const uInt16* rom;
     uInt16* ram;
 
+    // Decoded form of every halfword in ROM, so execute() can dispatch
+    // directly instead of testing each instruction pattern in turn
+    unique_ptr<Op[]> decodedRom;
+
     uInt32 reg_norm[16]; // normal execution mode, do not have a thread mode
     uInt32 cpsr, mamcr;
     bool handler_mode;
@@ -25,6 +25,11 @@
 #define RESID_INLINE inline
 #define RESID_BRANCH_HINTS 1
 
+// Use SSE2/NEON kernels for the resampling FIR convolution when the
+// CPU supports them and they pass a self test against the scalar path
+// at startup, otherwise the scalar path is used.
+#define RESID_USE_SIMD 1
+
 // Compiler specifics.
 #define HAVE_BOOL 1
 #define HAVE_BUILTIN_EXPECT 1
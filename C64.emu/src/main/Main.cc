@@ -20,8 +20,11 @@
 #include <imagine/thread/Thread.hh>
 #include <imagine/thread/Semaphore.hh>
 #include <imagine/gui/AlertView.hh>
+#include <imagine/io/BufferMapIO.hh>
+#include <imagine/io/IOStream.hh>
 #include "internal.hh"
 #include <sys/time.h>
+#include <algorithm>
 
 extern "C"
 {
@@ -369,31 +372,93 @@ static void saveSnapshotTrap(WORD, void *data)
 		snapData->hasError = false;
 }
 
-EmuSystem::Error EmuSystem::saveState(const char *path)
+static bool saveSnapshot(const char *path)
 {
 	SnapshotTrapData data;
 	data.pathStr = path;
 	plugin.interrupt_maincpu_trigger_trap(saveSnapshotTrap, (void*)&data);
-	skipFrames(1, false); // execute cpu trap
-	return data.hasError ? makeFileWriteError() : Error{};
+	EmuSystem::skipFrames(1, false); // execute cpu trap
+	return !data.hasError;
 }
 
-EmuSystem::Error EmuSystem::loadState(const char *path)
+static bool loadSnapshot(const char *path, FILE *stream = nullptr)
 {
 	plugin.resources_set_int("WarpMode", 0);
 	SnapshotTrapData data;
 	data.pathStr = path;
-	skipFrames(1, false); // run extra frame in case C64 was just started
+	EmuSystem::skipFrames(1, false); // run extra frame in case C64 was just started
 	plugin.interrupt_maincpu_trigger_trap(loadSnapshotTrap, (void*)&data);
-	skipFrames(1, false); // execute cpu trap, snapshot load may cause reboot from a C64 model change
+	EmuSystem::skipFrames(1, false); // execute cpu trap, snapshot load may cause reboot from a C64 model change
 	if(data.hasError)
-		return makeFileReadError();
+		return false;
 	// reload snapshot in case last load caused a reboot
+	if(stream)
+		fseek(stream, 0, SEEK_SET);
 	plugin.interrupt_maincpu_trigger_trap(loadSnapshotTrap, (void*)&data);
-	skipFrames(1, false); // execute cpu trap
-	bool hasError = data.hasError;
+	EmuSystem::skipFrames(1, false); // execute cpu trap
 	isPal = sysIsPal();
-	return hasError ? makeFileReadError() : Error{};
+	return !data.hasError;
+}
+
+EmuSystem::Error EmuSystem::saveState(const char *path)
+{
+	return saveSnapshot(path) ? Error{} : makeFileWriteError();
+}
+
+EmuSystem::Error EmuSystem::loadState(const char *path)
+{
+	return loadSnapshot(path) ? Error{} : makeFileReadError();
+}
+
+// memory states pass the stream to VICE's snapshot code in place of a file name,
+// like file states they run the frame executing the cpu trap
+
+static bool saveSnapshotToStream(FILE *stream)
+{
+	if(!plugin.snapshot_set_stream(stream))
+		return false;
+	bool success = saveSnapshot("");
+	plugin.snapshot_set_stream(nullptr);
+	return success;
+}
+
+// snapshots embed the ROMs & attached disk images so their size varies,
+// measuring it would mean running a save, so estimate it from the last one
+static constexpr size_t DEFAULT_STATE_SIZE_HINT = 4 * 1024 * 1024;
+static constexpr size_t MAX_STATE_SIZE_HINT = 64 * 1024 * 1024;
+static size_t stateSizeHint = DEFAULT_STATE_SIZE_HINT;
+
+size_t EmuSystem::stateDataSize()
+{
+	return stateSizeHint;
+}
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	BufferMapIO io;
+	io.openForWrite(data, size);
+	IOStream<BufferMapIO> stream{std::move(io), "wb"};
+	if(!saveSnapshotToStream(stream))
+	{
+		stateSizeHint = std::min(std::max(stateSizeHint, size * 2), MAX_STATE_SIZE_HINT);
+		return makeError("State buffer too small");
+	}
+	dataSize = ftell(stream);
+	// leave room for disk images growing from writes
+	stateSizeHint = dataSize + dataSize / 4;
+	return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	BufferMapIO io;
+	io.open(data, size);
+	IOStream<BufferMapIO> stream{std::move(io), "rb"};
+	if(!plugin.snapshot_set_stream(stream))
+		return makeError("Memory states not supported");
+	bool success = loadSnapshot("", stream);
+	plugin.snapshot_set_stream(nullptr);
+	return success ? Error{} : makeError("Invalid state data");
 }
 
 void EmuSystem::saveBackupMem()
@@ -165,6 +165,14 @@ int VicePlugin::machine_read_snapshot(const char *name, int event_mode)
 	return -1;
 }
 
+bool VicePlugin::snapshot_set_stream(FILE *f)
+{
+	if(!snapshot_set_stream_)
+		return false;
+	snapshot_set_stream_(f);
+	return true;
+}
+
 void VicePlugin::machine_set_restore_key(int v)
 {
 	if(machine_set_restore_key_)
@@ -361,6 +369,7 @@ VicePlugin commonVicePlugin(void *lib, ViceSystem system)
 	plugin.resources_get_default_value_ = (typeof plugin.resources_get_default_value_)dlsym(lib, "resources_get_default_value");
 	plugin.machine_write_snapshot_ = (typeof plugin.machine_write_snapshot_)dlsym(lib, "machine_write_snapshot");
 	plugin.machine_read_snapshot_ = (typeof plugin.machine_read_snapshot_)dlsym(lib, "machine_read_snapshot");
+	plugin.snapshot_set_stream_ = (typeof plugin.snapshot_set_stream_)dlsym(lib, "snapshot_set_stream");
 	plugin.machine_set_restore_key_ = (typeof plugin.machine_set_restore_key_)dlsym(lib, "machine_set_restore_key");
 	plugin.machine_trigger_reset_ = (typeof plugin.machine_trigger_reset_)dlsym(lib, "machine_trigger_reset");
 	plugin.interrupt_maincpu_trigger_trap_ = (typeof plugin.interrupt_maincpu_trigger_trap_)dlsym(lib, "interrupt_maincpu_trigger_trap");
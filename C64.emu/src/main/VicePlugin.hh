@@ -58,6 +58,7 @@ struct VicePlugin
 	int (*resources_get_default_value_)(const char *name, void *value_return){};
 	int (*machine_write_snapshot_)(const char *name, int save_roms, int save_disks, int even_mode){};
 	int (*machine_read_snapshot_)(const char *name, int event_mode){};
+	void (*snapshot_set_stream_)(FILE *f){};
 	void (*machine_set_restore_key_)(int v){};
 	void (*machine_trigger_reset_)(const unsigned int mode){};
 	void (*interrupt_maincpu_trigger_trap_)(void (*trap_func_)(WORD, void *data), void *data){};
@@ -98,6 +99,7 @@ struct VicePlugin
 	int resources_get_default_value(const char *name, void *value_return);
 	int machine_write_snapshot(const char *name, int save_roms, int save_disks, int even_mode);
 	int machine_read_snapshot(const char *name, int event_mode);
+	bool snapshot_set_stream(FILE *f);
 	void machine_set_restore_key(int v);
 	void machine_trigger_reset(const unsigned int mode);
 	void interrupt_maincpu_trigger_trap(void trap_func(WORD, void *data), void *data);
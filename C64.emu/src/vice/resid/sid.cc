@@ -27,6 +27,21 @@
 #include "sid.h"
 #include <math.h>
 
+// The SSE2 kernel is built for any x86 target and only used when the CPU
+// reports SSE2, 32-bit builds don't assume it. NEON is only used when the
+// target is built for it.
+#if RESID_USE_SIMD && (defined(__i386__) || defined(__x86_64__)) && defined(__GNUC__)
+#include <emmintrin.h>
+#define RESID_HAVE_SIMD 1
+#define RESID_SIMD_TARGET __attribute__((target("sse2")))
+#elif RESID_USE_SIMD && (defined(__ARM_NEON__) || defined(__ARM_NEON))
+#include <arm_neon.h>
+#define RESID_HAVE_SIMD 1
+#define RESID_SIMD_TARGET
+#else
+#define RESID_HAVE_SIMD 0
+#endif
+
 #ifndef round
 #define round(x) (x>=0.0?floor(x+0.5):ceil(x-0.5))
 #endif
@@ -47,6 +62,7 @@ SID::SID()
   fir_beta = 0;
   fir_f_cycles_per_sample = 0;
   fir_filter_scale = 0;
+  use_simd = has_simd();
 
   sid_model = MOS6581;
   voice[0].set_sync_source(&voice[2]);
@@ -860,6 +876,114 @@ int SID::clock_interpolate(cycle_count& delta_t, short* buf, int n, int interlea
 }
 
 
+// ----------------------------------------------------------------------------
+// FIR convolution kernels.
+// The products of two 16-bit values are accumulated in 32 bits with
+// wrap-around, so the summation order doesn't affect the result and the
+// vectorized kernels match the scalar loop bit for bit.
+// ----------------------------------------------------------------------------
+static int convolve(const short* a, const short* b, int n)
+{
+  int out = 0;
+  for (int i = 0; i < n; i++) {
+    out += a[i]*b[i];
+  }
+  return out;
+}
+
+#if RESID_HAVE_SIMD
+RESID_SIMD_TARGET
+static int convolve_simd(const short* a, const short* b, int n)
+{
+  int i = 0;
+  int out;
+#if defined(__i386__) || defined(__x86_64__)
+  __m128i acc = _mm_setzero_si128();
+  for (; i + 8 <= n; i += 8) {
+    __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+    __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(va, vb));
+  }
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+  out = _mm_cvtsi128_si32(acc);
+#else
+  int32x4_t acc = vdupq_n_s32(0);
+  for (; i + 8 <= n; i += 8) {
+    int16x8_t va = vld1q_s16(a + i);
+    int16x8_t vb = vld1q_s16(b + i);
+    acc = vmlal_s16(acc, vget_low_s16(va), vget_low_s16(vb));
+    acc = vmlal_s16(acc, vget_high_s16(va), vget_high_s16(vb));
+  }
+  int32x2_t sum2 = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+  out = vget_lane_s32(vpadd_s32(sum2, sum2), 0);
+#endif
+  return out + convolve(a + i, b + i, n - i);
+}
+
+
+// Runs both kernels on the same pseudo-random input, covering every tail
+// length and full-scale values that wrap the accumulator.
+static bool convolve_simd_self_test()
+{
+  enum { TEST_LEN = 256 };
+  short a[TEST_LEN + 8], b[TEST_LEN + 8];
+  unsigned int seed = 0x5eed1234;
+  for (int i = 0; i < TEST_LEN + 8; i++) {
+    seed = seed*1103515245 + 12345;
+    a[i] = short(seed >> 16);
+    seed = seed*1103515245 + 12345;
+    b[i] = (i & 7) ? short(seed >> 16) : short(-32768);
+  }
+  for (int n = 0; n <= TEST_LEN; n++) {
+    // odd offsets also check unaligned loads
+    for (int offset = 0; offset < 2; offset++) {
+      if (convolve(a + offset, b + offset, n) != convolve_simd(a + offset, b + offset, n)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// Check if the SIMD FIR kernel can be used. It must be supported by the CPU
+// and match the scalar loop on the self test, otherwise the scalar loop is
+// used. The result is computed once on first use.
+// ----------------------------------------------------------------------------
+bool SID::has_simd()
+{
+#if RESID_HAVE_SIMD
+  static const bool usable = []()
+  {
+#if (defined(__i386__) || defined(__x86_64__)) && !defined(__SSE2__)
+    if (!__builtin_cpu_supports("sse2")) {
+      return false;
+    }
+#endif
+    return convolve_simd_self_test();
+  }();
+  return usable;
+#else
+  return false;
+#endif
+}
+
+RESID_INLINE
+int SID::convolve_fir(const short* a, const short* b, int n)
+{
+  // Both paths produce bit-identical output, the scalar one is used on
+  // CPUs without SSE2/NEON.
+#if RESID_HAVE_SIMD
+  if (likely(use_simd)) {
+    return convolve_simd(a, b, n);
+  }
+#endif
+  return convolve(a, b, n);
+}
+
+
 // ----------------------------------------------------------------------------
 // SID clocking with audio sampling - cycle based with audio resampling.
 //
@@ -927,10 +1051,7 @@ int SID::clock_resample(cycle_count& delta_t, short* buf, int n, int interleave)
     short* sample_start = sample + sample_index - fir_N - 1 + RINGSIZE;
 
     // Convolution with filter impulse response.
-    int v1 = 0;
-    for (int j = 0; j < fir_N; j++) {
-      v1 += sample_start[j]*fir_start[j];
-    }
+    int v1 = convolve_fir(sample_start, fir_start, fir_N);
 
     // Use next FIR table, wrap around to first FIR table using
     // next sample.
@@ -941,10 +1062,7 @@ int SID::clock_resample(cycle_count& delta_t, short* buf, int n, int interleave)
     fir_start = fir + fir_offset*fir_N;
 
     // Convolution with filter impulse response.
-    int v2 = 0;
-    for (int k = 0; k < fir_N; k++) {
-      v2 += sample_start[k]*fir_start[k];
-    }
+    int v2 = convolve_fir(sample_start, fir_start, fir_N);
 
     // Linear interpolation.
     // fir_offset_rmd is equal for all samples, it can thus be factorized out:
@@ -1002,10 +1120,7 @@ int SID::clock_resample_fastmem(cycle_count& delta_t, short* buf, int n, int int
     short* sample_start = sample + sample_index - fir_N + RINGSIZE;
 
     // Convolution with filter impulse response.
-    int v = 0;
-    for (int j = 0; j < fir_N; j++) {
-      v += sample_start[j]*fir_start[j];
-    }
+    int v = convolve_fir(sample_start, fir_start, fir_N);
 
     v >>= FIR_SHIFT;
 
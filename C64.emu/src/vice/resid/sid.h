@@ -42,6 +42,7 @@ public:
   void enable_filter(bool enable);
   void adjust_filter_bias(double dac_bias);
   void enable_external_filter(bool enable);
+  static bool has_simd();
   bool set_sampling_parameters(double clock_freq, sampling_method method,
   double sample_freq, double pass_freq = -1,
   double filter_scale = 0.97);
@@ -102,6 +103,7 @@ public:
   int clock_interpolate(cycle_count& delta_t, short* buf, int n, int interleave);
   int clock_resample(cycle_count& delta_t, short* buf, int n, int interleave);
   int clock_resample_fastmem(cycle_count& delta_t, short* buf, int n, int interleave);
+  int convolve_fir(const short* a, const short* b, int n);
   void write();
 
   chip_model sid_model;
@@ -152,6 +154,7 @@ public:
   short sample_prev, sample_now;
   int fir_N;
   int fir_RES;
+  bool use_simd;
   double fir_beta;
   double fir_f_cycles_per_sample;
   double fir_filter_scale;
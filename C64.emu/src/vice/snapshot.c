@@ -84,8 +84,15 @@ struct snapshot_s {
 
     /* Flag: are we writing it?  */
     int write_mode;
+
+    /* Flag: is the file owned by the caller of snapshot_set_stream()?  */
+    int external_stream;
 };
 
+/* If set, snapshots are created in and opened from this stream instead of
+   the given filename.  */
+static FILE *snapshot_stream = NULL;
+
 /* ------------------------------------------------------------------------- */
 
 static int snapshot_write_byte(FILE *f, BYTE data)
@@ -676,7 +683,7 @@ snapshot_t *snapshot_create(const char *filename, BYTE major_version, BYTE minor
 
     current_filename = (char *)filename;
 
-    f = fopen(filename, MODE_WRITE);
+    f = snapshot_stream ? snapshot_stream : fopen(filename, MODE_WRITE);
     if (f == NULL) {
         snapshot_error = SNAPSHOT_CANNOT_CREATE_SNAPSHOT_ERROR;
         return NULL;
@@ -724,12 +731,15 @@ snapshot_t *snapshot_create(const char *filename, BYTE major_version, BYTE minor
     s->file = f;
     s->first_module_offset = ftell(f);
     s->write_mode = 1;
+    s->external_stream = f == snapshot_stream;
 
     return s;
 
 fail:
-    fclose(f);
-    ioutil_remove(filename);
+    if (f != snapshot_stream) {
+        fclose(f);
+        ioutil_remove(filename);
+    }
     return NULL;
 }
 
@@ -749,7 +759,7 @@ snapshot_t *snapshot_open(const char *filename, BYTE *major_version_return, BYTE
     current_filename = (char *)filename;
     current_module = NULL;
 
-    f = zfile_fopen(filename, MODE_READ);
+    f = snapshot_stream ? snapshot_stream : zfile_fopen(filename, MODE_READ);
     if (f == NULL) {
         snapshot_error = SNAPSHOT_CANNOT_OPEN_FOR_READ_ERROR;
         return NULL;
@@ -810,12 +820,15 @@ snapshot_t *snapshot_open(const char *filename, BYTE *major_version_return, BYTE
     s->file = f;
     s->first_module_offset = ftell(f);
     s->write_mode = 0;
+    s->external_stream = f == snapshot_stream;
 
     vsync_suspend_speed_eval();
     return s;
 
 fail:
-    fclose(f);
+    if (f != snapshot_stream) {
+        fclose(f);
+    }
     return NULL;
 }
 
@@ -823,7 +836,15 @@ int snapshot_close(snapshot_t *s)
 {
     int retval;
 
-    if (!s->write_mode) {
+    if (s->external_stream) {
+        /* The caller closes the stream, just make sure all data reached it.  */
+        if (s->write_mode && fflush(s->file) == EOF) {
+            snapshot_error = SNAPSHOT_WRITE_CLOSE_EOF_ERROR;
+            retval = -1;
+        } else {
+            retval = 0;
+        }
+    } else if (!s->write_mode) {
         if (zfile_fclose(s->file) == EOF) {
             snapshot_error = SNAPSHOT_READ_CLOSE_EOF_ERROR;
             retval = -1;
@@ -843,6 +864,11 @@ int snapshot_close(snapshot_t *s)
     return retval;
 }
 
+void snapshot_set_stream(FILE *f)
+{
+    snapshot_stream = f;
+}
+
 static void display_error_with_vice_version(char *text, char *filename)
 {
     char *vmessage = lib_malloc(0x100);
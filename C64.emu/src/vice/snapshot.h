@@ -28,6 +28,8 @@
 #ifndef SNAPSHOT_H
 #define SNAPSHOT_H
 
+#include <stdio.h>
+
 #include "types.h"
 
 #define SNAPSHOT_MACHINE_NAME_LEN       16
@@ -145,6 +147,11 @@ extern snapshot_t *snapshot_open(const char *filename,
                                  const char *snapshot_machine_name);
 extern int snapshot_close(snapshot_t *s);
 
+/* Use an already open stream for the following snapshot_create() and
+   snapshot_open() calls instead of their filename, NULL to stop.  The stream
+   is left open by snapshot_close().  */
+extern void snapshot_set_stream(FILE *f);
+
 extern void snapshot_set_error(int error);
 
 extern int snapshot_version_at_least(BYTE major_version, BYTE minor_version, BYTE major_version_required, BYTE minor_version_required);
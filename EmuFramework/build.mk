@@ -9,6 +9,7 @@ MsgPopup.cc \
 FilePicker.cc \
 EmuSystem.cc \
 Screenshot.cc \
+ScreenshotWriter.cc \
 ButtonConfigView.cc \
 VideoImageOverlay.cc \
 StateSlotView.cc \
@@ -30,7 +31,13 @@ EmuVideoLayer.cc \
 Cheats.cc \
 Recent.cc \
 EmuLoadProgressView.cc \
-RecentGameView.cc
+RecentGameView.cc \
+FrameHash.cc \
+InputLatency.cc \
+VideoCapture.cc \
+CpuVideoFilter.cc \
+hqx/hq2x.c \
+hqx/hq3x.c
 
 ifeq ($(emuFramework_onScreenControls), 1)
  SRC += TouchConfigView.cc \
@@ -58,6 +65,7 @@ LDLIBS := -l$(libName) $(LDLIBS)
 
 include $(IMAGINE_PATH)/make/package/imagine.mk
 include $(IMAGINE_PATH)/make/package/stdc++.mk
+include $(IMAGINE_PATH)/make/package/zlib.mk
 
 include $(IMAGINE_PATH)/make/imagineStaticLibTarget.mk
 
@@ -142,6 +142,9 @@ public:
 	static bool sessionOptionsSet;
 
 	static Error onInit();
+	// implemented by systems with a headless command line mode,
+	// returns the exit code if argv selected it and it ran
+	static std::optional<int> runCommandLineTool(int argc, char** argv);
 	static bool isActive() { return state == State::ACTIVE; }
 	static bool isStarted() { return state == State::ACTIVE || state == State::PAUSED; }
 	static bool isPaused() { return state == State::PAUSED; }
@@ -149,6 +152,16 @@ public:
 	static void startAutoSaveStateTimer();
 	static Error loadState(const char *path);
 	static Error saveState(const char *path);
+	// memory-backed states, a versioned header followed by the system's state data
+	static size_t stateSize();
+	static Error saveStateToMemory(void *buff, size_t size, size_t &bytesWritten);
+	static Error loadStateFromMemory(const void *buff, size_t size);
+	// implemented per system, stateDataSize() returns the most bytes saveStateData() writes,
+	// or for systems with variable sized states an estimate based on the last save that's
+	// raised whenever saveStateData() fails due to a too small buffer
+	static size_t stateDataSize();
+	static Error saveStateData(void *data, size_t size, size_t &dataSize);
+	static Error loadStateData(const void *data, size_t size);
 	static bool stateExists(int slot);
 	static bool shouldOverwriteExistingState();
 	static const char *systemName();
@@ -220,6 +233,8 @@ public:
 	static void closeSound();
 	static void flushSound();
 	static void writeSound(const void *samples, uint framesToWrite);
+	static void *startSoundWrite(uint framesToWrite);
+	static void commitSoundWrite(uint framesWritten);
 	static uint advanceFramesWithTime(Base::FrameTimeBase time);
 	static void setupGamePaths(const char *filePath);
 	static void setGameSavePath(const char *path);
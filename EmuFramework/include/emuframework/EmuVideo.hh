@@ -17,6 +17,8 @@
 
 #include <imagine/gfx/Gfx.hh>
 #include <imagine/gfx/Texture.hh>
+#include <array>
+#include <atomic>
 
 class EmuVideo;
 
@@ -53,7 +55,24 @@ private:
 class EmuVideo
 {
 public:
+	static constexpr uint MAX_BUFFERS = 3;
+
 	EmuVideo(Gfx::Renderer &r): r{r} {}
+	// With more than 1 buffer the core writes a frame into a texture the
+	// renderer isn't using while the last finished one is drawn. Only textures
+	// that need an exclusive lock use the extra buffers, with a sync fence per
+	// buffer so one isn't written until the GPU is done reading it. Other textures
+	// are updated in order with draws by the renderer and always use 1 buffer.
+	void setBuffers(uint buffers);
+	uint buffers() const { return buffers_; }
+	// periodically logs how many frames halted the renderer and how many
+	// would have without extra buffers
+	void setLogBufferStats(bool on) { logBufferStats = on; }
+	// called by the renderer after issuing the draw commands for the current frame
+	void addDrawFence(Gfx::RendererCommands &cmds);
+	// scales frames from the core on the CPU before they reach the texture,
+	// takes a CpuVideoFilter::Type
+	void setCpuFilter(uint type);
 	void setFormat(IG::PixmapDesc desc);
 	void resetImage();
 	EmuVideoImage startFrame();
@@ -61,16 +80,46 @@ public:
 	void finishFrame(Gfx::LockedTextureBuffer texBuff);
 	void finishFrame(IG::Pixmap pix);
 	void takeGameScreenshot();
+	// writes count screenshots, one every frameInterval frames starting with the next one
+	void takeGameScreenshots(uint count, uint frameInterval);
 	bool isExternalTexture();
+	// the most recently finished frame
 	Gfx::PixmapTexture &image();
+	// call on the render thread, returns the most recently finished frame and
+	// keeps it from being written until a newer frame is drawn
+	Gfx::PixmapTexture &imageForDraw();
 	Gfx::Renderer &renderer() { return r; }
 	IG::WP size() const;
+	// size of frames from the core, before any CPU filtering
+	IG::WP gameSize() const;
 
 protected:
 	Gfx::Renderer &r;
-	Gfx::PixmapTexture vidImg{};
+	std::array<Gfx::PixmapTexture, MAX_BUFFERS> vidImg{};
+	// presented and drawn buffer indices packed together so the renderer
+	// only ever takes the frame that's presented at that moment
+	std::atomic_uint bufferState{};
+	uint buffers_ = 1;
+	uint usedBuffers = 1;
+	uint writeIdx = 0;
+	// signaled when the GPU is done with the last draw reading each buffer
+	std::array<Gfx::SyncFence, MAX_BUFFERS> drawFence{};
+	uint statFrames = 0;
+	uint statHalts = 0;
+	uint statAvoidedHalts = 0;
+	uint statFenceWaits = 0;
+	bool logBufferStats = false;
 	IG::MemPixmap memPix{};
-	bool screenshotNextFrame = false;
+	IG::PixmapDesc srcDesc{};
+	IG::MemPixmap filterSrcPix{};
+	bool isFiltering = false;
+	uint screenshotsLeft = 0;
+	uint screenshotInterval = 1;
+	uint screenshotFrameDelay = 0;
 
 	void doScreenshot(IG::Pixmap pix);
+	void prepareWriteBuffer();
+	void clearDrawFences();
+	void presentWriteBuffer();
+	void writeFilteredFrame(IG::Pixmap pix);
 };
@@ -62,6 +62,8 @@ protected:
 	TextMenuItem imgEffectItem[4];
 	MultiChoiceMenuItem imgEffect;
 	#endif
+	TextMenuItem cpuFilterItem[6];
+	MultiChoiceMenuItem cpuFilter;
 	TextMenuItem overlayEffectItem[6];
 	MultiChoiceMenuItem overlayEffect;
 	TextMenuItem overlayEffectLevelItem[7];
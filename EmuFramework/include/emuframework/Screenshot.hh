@@ -19,4 +19,5 @@
 #include <imagine/fs/FS.hh>
 
 bool writeScreenshot(const IG::Pixmap &vidPix, const char *fname);
-int sprintScreenshotFilename(FS::PathString &str);
+// returns the first unused screenshot number >= startNum, or -1 if none are left
+int sprintScreenshotFilename(FS::PathString &str, uint startNum = 0);
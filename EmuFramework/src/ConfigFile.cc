@@ -133,6 +133,7 @@ static OptionBase *cfgFileOption[] =
 	&optionImgEffect,
 	&optionImageEffectPixelFormat,
 	#endif
+	&optionCpuVideoFilter,
 	&optionGPUMultiThreading,
 	&optionOverlayEffect,
 	&optionOverlayEffectLevel,
@@ -466,6 +467,7 @@ void loadConfigFile()
 				bcase CFGKEY_IMAGE_EFFECT: optionImgEffect.readFromIO(io, size);
 				bcase CFGKEY_IMAGE_EFFECT_PIXEL_FORMAT: optionImageEffectPixelFormat.readFromIO(io, size);
 				#endif
+				bcase CFGKEY_CPU_VIDEO_FILTER: optionCpuVideoFilter.readFromIO(io, size);
 				bcase CFGKEY_GPU_MULTITHREADING: optionGPUMultiThreading.readFromIO(io, size);
 				bcase CFGKEY_OVERLAY_EFFECT: optionOverlayEffect.readFromIO(io, size);
 				bcase CFGKEY_OVERLAY_EFFECT_LEVEL: optionOverlayEffectLevel.readFromIO(io, size);
@@ -0,0 +1,407 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "CpuVideoFilter"
+#include "CpuVideoFilter.hh"
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <thread>
+
+extern "C"
+{
+	#include "hqx/hq2x.h"
+	#include "hqx/hq3x.h"
+}
+
+// Per-component blending without unpacking, the low bits of each component
+// are masked off so sums never carry into the neighboring component
+template <class T>
+struct PixelMasks;
+
+template <>
+struct PixelMasks<uint16> // RGB565
+{
+	static constexpr uint16 LOW_BIT = 0x0821;
+	static constexpr uint16 LOW_2_BITS = 0x1863;
+};
+
+template <>
+struct PixelMasks<uint32> // 8-bit components in any order
+{
+	static constexpr uint32 LOW_BIT = 0x01010101;
+	static constexpr uint32 LOW_2_BITS = 0x03030303;
+};
+
+template <class T>
+static T interpolate(T a, T b)
+{
+	return (a & b) + (((a ^ b) & (T)~PixelMasks<T>::LOW_BIT) >> 1);
+}
+
+template <class T>
+static T qInterpolate(T a, T b, T c, T d)
+{
+	constexpr T low = PixelMasks<T>::LOW_2_BITS;
+	constexpr T high = ~low;
+	T highSum = ((a & high) >> 2) + ((b & high) >> 2) + ((c & high) >> 2) + ((d & high) >> 2);
+	T lowSum = (((a & low) + (b & low) + (c & low) + (d & low)) >> 2) & low;
+	return highSum + lowSum;
+}
+
+// rows above and below the frame repeat the edge row
+template <class T>
+static const T *srcRow(const IG::Pixmap &src, int y)
+{
+	y = std::clamp(y, 0, (int)src.h() - 1);
+	return (const T*)src.pixel({0, y});
+}
+
+template <class T>
+static T *destRow(const IG::Pixmap &dest, int y)
+{
+	return (T*)dest.pixel({0, y});
+}
+
+// Scale2x & Scale3x (AdvanceMAME) and 2xSaI are written as branch-free selects
+// over whole rows with the edge columns peeled off so the compiler can vectorize
+// the inner loops. Scale2x gives the same output as the bundled Scalebit code
+// (MSX.emu's blueMSX/VideoRender) whose C version doesn't vectorize, while its
+// Scale3x is a reduced variant that only fills in the corner pixels.
+
+template <class T>
+static inline void scale2xPixel(T B, T D, T E, T F, T H, T *d0, T *d1)
+{
+	bool c = B != H && D != F;
+	d0[0] = c && D == B ? D : E;
+	d0[1] = c && B == F ? F : E;
+	d1[0] = c && D == H ? D : E;
+	d1[1] = c && H == F ? F : E;
+}
+
+template <class T>
+static void scale2xRows(const IG::Pixmap &dest, const IG::Pixmap &src, int yStart, int yEnd)
+{
+	int w = src.w();
+	for(int y = yStart; y < yEnd; y++)
+	{
+		auto b = srcRow<T>(src, y - 1), e = srcRow<T>(src, y), h = srcRow<T>(src, y + 1);
+		auto d0 = destRow<T>(dest, y * 2), d1 = destRow<T>(dest, y * 2 + 1);
+		if(w == 1)
+		{
+			scale2xPixel(b[0], e[0], e[0], e[0], h[0], d0, d1);
+			continue;
+		}
+		scale2xPixel(b[0], e[0], e[0], e[1], h[0], d0, d1);
+		for(int x = 1; x < w - 1; x++)
+		{
+			scale2xPixel(b[x], e[x - 1], e[x], e[x + 1], h[x], &d0[x * 2], &d1[x * 2]);
+		}
+		scale2xPixel(b[w - 1], e[w - 2], e[w - 1], e[w - 1], h[w - 1], &d0[(w - 1) * 2], &d1[(w - 1) * 2]);
+	}
+}
+
+// the 8 output pixels that aren't just E, in row order
+template <class T>
+static inline void scale3xPixel(T A, T B, T C, T D, T E, T F, T G, T H, T I, T (&p)[8][CpuVideoFilter::MAX_SOURCE_SIZE], int x)
+{
+	bool c = (B != H) & (D != F);
+	bool db = c & (D == B), bf = c & (B == F), dh = c & (D == H), hf = c & (H == F);
+	p[0][x] = db ? D : E;
+	p[1][x] = (db & (E != C)) | (bf & (E != A)) ? B : E;
+	p[2][x] = bf ? F : E;
+	p[3][x] = (db & (E != G)) | (dh & (E != A)) ? D : E;
+	p[4][x] = (bf & (E != I)) | (hf & (E != C)) ? F : E;
+	p[5][x] = dh ? D : E;
+	p[6][x] = (dh & (E != I)) | (hf & (E != G)) ? H : E;
+	p[7][x] = hf ? F : E;
+}
+
+template <class T>
+static void scale3xRow(const T *__restrict r0, const T *__restrict r1, const T *__restrict r2,
+	T *__restrict d0, T *__restrict d1, T *__restrict d2, int w)
+{
+	// the pixels are computed into separate arrays first since storing 3 per
+	// source pixel only vectorizes with byte shuffles (SSSE3 or NEON)
+	T p[8][CpuVideoFilter::MAX_SOURCE_SIZE];
+	int xr = std::min(1, w - 1);
+	scale3xPixel(r0[0], r0[0], r0[xr], r1[0], r1[0], r1[xr], r2[0], r2[0], r2[xr], p, 0);
+	for(int x = 1; x < w - 1; x++)
+	{
+		scale3xPixel(r0[x - 1], r0[x], r0[x + 1], r1[x - 1], r1[x], r1[x + 1], r2[x - 1], r2[x], r2[x + 1], p, x);
+	}
+	if(w > 1)
+	{
+		int x = w - 1;
+		scale3xPixel(r0[x - 1], r0[x], r0[x], r1[x - 1], r1[x], r1[x], r2[x - 1], r2[x], r2[x], p, x);
+	}
+	for(int x = 0; x < w; x++)
+	{
+		d0[x * 3] = p[0][x];
+		d0[x * 3 + 1] = p[1][x];
+		d0[x * 3 + 2] = p[2][x];
+		d1[x * 3] = p[3][x];
+		d1[x * 3 + 1] = r1[x];
+		d1[x * 3 + 2] = p[4][x];
+		d2[x * 3] = p[5][x];
+		d2[x * 3 + 1] = p[6][x];
+		d2[x * 3 + 2] = p[7][x];
+	}
+}
+
+template <class T>
+static void scale3xRows(const IG::Pixmap &dest, const IG::Pixmap &src, int yStart, int yEnd)
+{
+	for(int y = yStart; y < yEnd; y++)
+	{
+		scale3xRow(srcRow<T>(src, y - 1), srcRow<T>(src, y), srcRow<T>(src, y + 1),
+			destRow<T>(dest, y * 3), destRow<T>(dest, y * 3 + 1), destRow<T>(dest, y * 3 + 2), src.w());
+	}
+}
+
+// 2xSaI, adapted from the Kreed filter in GBC.emu's videolink to work on
+// any frame size in RGB565 or 32-bit formats
+
+// +1 if a matches c & d more than b does, -1 if less
+template <class T>
+static int saiScore(T a, T b, T c, T d)
+{
+	int x = (a == c) + (a == d);
+	int y = ((a != c) & (b == c)) + ((a != d) & (b == d));
+	return (x <= 1) - (y <= 1);
+}
+
+template <class T>
+static inline void sai2xPixel(T I, T E, T F, T J, T G, T A, T B, T K, T H, T C, T D, T L, T M, T N, T O,
+	T *d0, T *d1)
+{
+	// Map of the pixels: I|E F|J
+	//                    G|A B|K
+	//                    H|C D|L
+	//                    M|N O|P
+	bool ad = A == D, bc = B == C;
+	bool diagA = ad & !bc, diagB = bc & !ad, both = ad & bc, neither = !ad & !bc;
+	bool edgeA0 = (A == C) & (A == F) & (B != E) & (B == J);
+	bool edgeB0 = (B == E) & (B == D) & (A != F) & (A == I);
+	bool edgeA1 = (A == B) & (A == H) & (G != C) & (C == M);
+	bool edgeC1 = (C == G) & (C == D) & (A != H) & (A == I);
+	bool a0 = (diagA & (((A == E) & (B == L)) | edgeA0)) | (neither & edgeA0);
+	bool b0 = (diagB & (((B == F) & (A == H)) | edgeB0)) | (neither & edgeB0);
+	bool a1 = (diagA & (((A == G) & (C == O)) | edgeA1)) | (neither & edgeA1);
+	bool c1 = (diagB & (((C == H) & (A == F)) | edgeC1)) | (neither & edgeC1);
+	int score = saiScore(A, B, G, E) - saiScore(B, A, K, F) - saiScore(B, A, H, N) + saiScore(A, B, L, O);
+	bool a2 = diagA | (both & ((A == B) | (score > 0)));
+	bool b2 = diagB | (both & (A != B) & (score < 0));
+	d0[0] = A;
+	d0[1] = a0 ? A : b0 ? B : interpolate(A, B);
+	d1[0] = a1 ? A : c1 ? C : interpolate(A, C);
+	d1[1] = a2 ? A : b2 ? B : qInterpolate(A, B, C, D);
+}
+
+template <class T>
+static void sai2xEdgePixel(const T *r0, const T *r1, const T *r2, const T *r3, T *d0, T *d1, int w, int x)
+{
+	int xl = std::max(x - 1, 0), xr = std::min(x + 1, w - 1), xr2 = std::min(x + 2, w - 1);
+	sai2xPixel(r0[xl], r0[x], r0[xr], r0[xr2], r1[xl], r1[x], r1[xr], r1[xr2],
+		r2[xl], r2[x], r2[xr], r2[xr2], r3[xl], r3[x], r3[xr], &d0[x * 2], &d1[x * 2]);
+}
+
+template <class T>
+static void sai2xRow(const T *__restrict r0, const T *__restrict r1, const T *__restrict r2, const T *__restrict r3,
+	T *__restrict d0, T *__restrict d1, int w)
+{
+	sai2xEdgePixel(r0, r1, r2, r3, d0, d1, w, 0);
+	for(int x = 1; x < w - 2; x++)
+	{
+		sai2xPixel(r0[x - 1], r0[x], r0[x + 1], r0[x + 2], r1[x - 1], r1[x], r1[x + 1], r1[x + 2],
+			r2[x - 1], r2[x], r2[x + 1], r2[x + 2], r3[x - 1], r3[x], r3[x + 1], &d0[x * 2], &d1[x * 2]);
+	}
+	for(int x = std::max(w - 2, 1); x < w; x++)
+	{
+		sai2xEdgePixel(r0, r1, r2, r3, d0, d1, w, x);
+	}
+}
+
+template <class T>
+static void sai2xRows(const IG::Pixmap &dest, const IG::Pixmap &src, int yStart, int yEnd)
+{
+	for(int y = yStart; y < yEnd; y++)
+	{
+		sai2xRow(srcRow<T>(src, y - 1), srcRow<T>(src, y), srcRow<T>(src, y + 1), srcRow<T>(src, y + 2),
+			destRow<T>(dest, y * 2), destRow<T>(dest, y * 2 + 1), src.w());
+	}
+}
+
+template <class T>
+static void filterRows(uint type, const IG::Pixmap &dest, const IG::Pixmap &src, int yStart, int yEnd)
+{
+	switch(type)
+	{
+		bcase CpuVideoFilter::SCALE2X: scale2xRows<T>(dest, src, yStart, yEnd);
+		bcase CpuVideoFilter::SCALE3X: scale3xRows<T>(dest, src, yStart, yEnd);
+		bcase CpuVideoFilter::SAI2X: sai2xRows<T>(dest, src, yStart, yEnd);
+	}
+}
+
+// hq2x & hq3x use the blueMSX code shared with MSX.emu, which converts RGB565
+// to 32-bit RGBA and takes a row range so each band reads its neighboring rows
+// directly. It's a scalar case table per pixel and doesn't vectorize.
+static void hqxRows(uint type, const IG::Pixmap &dest, const IG::Pixmap &src, int yStart, int yEnd)
+{
+	auto hqxFunc = type == CpuVideoFilter::HQ2X ? hq2x_32_rows : hq3x_32_rows;
+	hqxFunc(src.pixel({}), src.pitchBytes(), dest.pixel({}), dest.pitchBytes(),
+		src.w(), src.h(), yStart, yEnd);
+}
+
+CpuVideoFilter::~CpuVideoFilter()
+{
+	if(workers.empty())
+		return;
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		quitWorkers = true;
+		jobCond.notify_all();
+	}
+	for(auto &t : workers)
+	{
+		t.join();
+	}
+}
+
+void CpuVideoFilter::setType(uint type)
+{
+	type_ = std::min(type, (uint)LAST_TYPE);
+	// lookup tables are built on first use, before any worker can read them
+	static bool hq2xIsInit = false, hq3xIsInit = false;
+	if(type_ == HQ2X && !hq2xIsInit)
+	{
+		hq2x_init(1);
+		hq2xIsInit = true;
+	}
+	else if(type_ == HQ3X && !hq3xIsInit)
+	{
+		hq3x_init(1);
+		hq3xIsInit = true;
+	}
+}
+
+uint CpuVideoFilter::scaleFactor(uint type)
+{
+	switch(type)
+	{
+		case SCALE2X:
+		case SAI2X:
+		case HQ2X: return 2;
+		case SCALE3X:
+		case HQ3X: return 3;
+	}
+	return 1;
+}
+
+bool CpuVideoFilter::isActiveFor(IG::PixmapDesc srcDesc) const
+{
+	if(type_ == OFF || !srcDesc.w() || !srcDesc.h()
+		|| srcDesc.w() > MAX_SOURCE_SIZE || srcDesc.h() > MAX_SOURCE_SIZE)
+		return false;
+	if(isHqx(type_))
+		return srcDesc.format() == IG::PIXEL_RGB565;
+	switch(srcDesc.format().id())
+	{
+		case IG::PIXEL_RGB565:
+		case IG::PIXEL_RGBA8888:
+		case IG::PIXEL_BGRA8888:
+		case IG::PIXEL_ARGB8888:
+		case IG::PIXEL_ABGR8888:
+		case IG::PIXEL_RGBX8888:
+			return true;
+		default:
+			return false;
+	}
+}
+
+IG::PixmapDesc CpuVideoFilter::outputDesc(IG::PixmapDesc srcDesc) const
+{
+	int scale = scaleFactor(type_);
+	auto format = isHqx(type_) ? IG::PIXEL_FMT_RGBA8888 : srcDesc.format();
+	return {{srcDesc.size().x * scale, srcDesc.size().y * scale}, format};
+}
+
+void CpuVideoFilter::startWorkers()
+{
+	uint bands = std::clamp(std::thread::hardware_concurrency(), 1u, MAX_BANDS);
+	logMsg("filtering in %u bands", bands);
+	workers.reserve(bands - 1);
+	for(uint band = 1; band < bands; band++)
+	{
+		// the worker may start after the first job is posted, so it's given
+		// the id of the last job it shouldn't run
+		workers.emplace_back([this, band, lastJobId = jobId](){ runWorker(band, lastJobId); });
+	}
+}
+
+void CpuVideoFilter::run(IG::Pixmap dest, IG::Pixmap src)
+{
+	assumeExpr(dest.w() == src.w() * scaleFactor(type_));
+	if(workers.empty() && std::thread::hardware_concurrency() > 1)
+	{
+		startWorkers();
+	}
+	Job frameJob{dest, src, type_, (uint)workers.size() + 1};
+	if(workers.empty())
+	{
+		filterBand(frameJob, 0);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		job = frameJob;
+		bandsLeft = workers.size();
+		jobId++;
+		jobCond.notify_all();
+	}
+	filterBand(frameJob, 0);
+	std::unique_lock<std::mutex> lock{mutex};
+	doneCond.wait(lock, [this](){ return !bandsLeft; });
+}
+
+void CpuVideoFilter::runWorker(uint band, uint lastJobId)
+{
+	std::unique_lock<std::mutex> lock{mutex};
+	while(true)
+	{
+		jobCond.wait(lock, [&](){ return quitWorkers || jobId != lastJobId; });
+		if(quitWorkers)
+			return;
+		lastJobId = jobId;
+		auto bandJob = job;
+		lock.unlock();
+		filterBand(bandJob, band);
+		lock.lock();
+		if(!--bandsLeft)
+			doneCond.notify_one();
+	}
+}
+
+void CpuVideoFilter::filterBand(const Job &job, uint band)
+{
+	int h = job.src.h();
+	int yStart = h * band / job.bands;
+	int yEnd = h * (band + 1) / job.bands;
+	if(isHqx(job.type))
+		hqxRows(job.type, job.dest, job.src, yStart, yEnd);
+	else if(job.src.format().bytesPerPixel() == 2)
+		filterRows<uint16>(job.type, job.dest, job.src, yStart, yEnd);
+	else
+		filterRows<uint32>(job.type, job.dest, job.src, yStart, yEnd);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/pixmap/Pixmap.hh>
+#include <imagine/thread/Thread.hh>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+// Pixel art scalers run on the CPU between the emulated frame and the video
+// texture, for devices where the shader based VideoImageEffect is too slow or
+// unavailable. Scale2x/Scale3x are the cheap choices there, hq2x/hq3x are much
+// heavier. The output is split into horizontal bands, one per thread, with
+// the emulation thread filtering the first band itself. Each band reads the
+// source rows it needs directly so no band waits on another.
+
+class CpuVideoFilter
+{
+public:
+	enum Type : uint8
+	{
+		OFF = 0,
+		SCALE2X = 1,
+		SCALE3X = 2,
+		SAI2X = 3,
+		HQ2X = 4,
+		HQ3X = 5,
+		LAST_TYPE = HQ3X
+	};
+	// larger frames (hi-res & interlaced modes) are passed through unfiltered
+	static constexpr uint MAX_SOURCE_SIZE = 400;
+
+	CpuVideoFilter() {}
+	~CpuVideoFilter();
+	void setType(uint type);
+	uint type() const { return type_; }
+	static uint scaleFactor(uint type);
+	// hqx types only filter RGB565 frames and output RGBA8888, they run a scalar
+	// case table per pixel and cost about twice the CPU of Scale2x/3x
+	static bool isHqx(uint type) { return type == HQ2X || type == HQ3X; }
+	// true if frames in this format get filtered with the current type
+	bool isActiveFor(IG::PixmapDesc srcDesc) const;
+	IG::PixmapDesc outputDesc(IG::PixmapDesc srcDesc) const;
+	// filters src into dest, which must be in outputDesc(src)
+	void run(IG::Pixmap dest, IG::Pixmap src);
+
+private:
+	static constexpr uint MAX_BANDS = 4;
+
+	struct Job
+	{
+		IG::Pixmap dest{};
+		IG::Pixmap src{};
+		uint type = OFF;
+		uint bands = 1;
+	};
+
+	std::vector<IG::thread> workers{};
+	std::mutex mutex{};
+	std::condition_variable jobCond{};
+	std::condition_variable doneCond{};
+	Job job{};
+	uint jobId = 0;
+	uint bandsLeft = 0;
+	bool quitWorkers = false;
+	uint8 type_ = OFF;
+
+	void startWorkers();
+	void runWorker(uint band, uint lastJobId);
+	static void filterBand(const Job &job, uint band);
+};
@@ -26,10 +26,14 @@
 #include <imagine/util/ScopeGuard.hh>
 #include <imagine/base/Pipe.hh>
 #include <imagine/thread/Thread.hh>
+#include <imagine/logger/Trace.hh>
 #include <cmath>
 #include "private.hh"
 #include "privateInput.hh"
 #include "configFile.hh"
+#include "FrameHash.hh"
+#include "InputLatency.hh"
+#include "VideoCapture.hh"
 
 class AutoStateConfirmAlertView : public YesNoAlertView
 {
@@ -413,8 +417,9 @@ void setEmuViewOnExtraWindow(bool on)
 				}
 				emuView2.prepareDraw();
 				auto fence = renderer.addResourceSyncFence();
+				bool tracksInputLatency = emuWin == &extraWin && EmuSystem::isActive() && InputLatency::prepareDraw();
 				rendererTask.draw(extraWin.drawableHolder, win, params,
-					[fence](Gfx::Drawable &drawable, const Base::Window &win, Gfx::RendererDrawTask task)
+					[fence, tracksInputLatency](Gfx::Drawable &drawable, const Base::Window &win, Gfx::RendererDrawTask task)
 					{
 						auto cmds = task.makeRendererCommands(drawable, extraWin.viewport(), extraWin.projectionMat);
 						cmds.clear();
@@ -422,6 +427,8 @@ void setEmuViewOnExtraWindow(bool on)
 						if(EmuSystem::isActive())
 						{
 							drawEmuFrame(cmds);
+							if(tracksInputLatency)
+								InputLatency::onPresent();
 						}
 						else
 						{
@@ -578,6 +585,9 @@ void EmuApp::showExitAlert(ViewAttachParams attach, Input::Event e)
 	modalViewController.pushAndShow(*new ExitConfirmAlertView(attach), e, false);
 }
 
+static FrameHash::Config frameHashConf{};
+static uint videoBuffers = 0; // 0 picks based on the renderer thread mode
+
 static const char *parseCmdLineArgs(int argc, char** argv)
 {
 	if(argc < 2)
@@ -586,11 +596,77 @@ static const char *parseCmdLineArgs(int argc, char** argv)
 	}
 	auto launchGame = argv[1];
 	logMsg("starting game from command line: %s", launchGame);
+	const char *capturePath{};
+	auto captureFormat = VideoCapture::Format::DELTA;
+	uint screenshots = 0, screenshotInterval = 1;
+	// frame hash check options:
+	// -frame-hash <hash file> [-state <state file>] [-input <input log>] [-frames <count>]
+	// [-state-roundtrip <frame>]
+	// audio output override:
+	// -audio-sink <null | file.wav | file.raw>
+	// gameplay capture, see VideoCapture.hh:
+	// -capture <base path> [-capture-format <y4m | delta>]
+	// screenshot burst, one every interval frames starting with the first:
+	// -screenshots <count> [-screenshot-interval <frames>]
+	// video texture ring:
+	// -video-buffers <1-3> -video-buffer-stats <0 | 1>
+	// input latency tracking, written to inputLatency.txt in the save path on game close:
+	// -input-latency <0 | 1>
+	for(int i = 2; i + 1 < argc; i += 2)
+	{
+		auto opt = argv[i];
+		auto val = argv[i + 1];
+		if(string_equal(opt, "-frame-hash"))
+			frameHashConf.hashPath = val;
+		else if(string_equal(opt, "-state"))
+			frameHashConf.statePath = val;
+		else if(string_equal(opt, "-input"))
+			frameHashConf.inputLogPath = val;
+		else if(string_equal(opt, "-frames"))
+			frameHashConf.frames = atoi(val);
+		else if(string_equal(opt, "-state-roundtrip"))
+			frameHashConf.stateRoundTripFrame = atoi(val);
+		else if(string_equal(opt, "-audio-sink"))
+			setAudioSink(val);
+		else if(string_equal(opt, "-capture"))
+			capturePath = val;
+		else if(string_equal(opt, "-capture-format"))
+			captureFormat = string_equal(val, "y4m") ? VideoCapture::Format::Y4M : VideoCapture::Format::DELTA;
+		else if(string_equal(opt, "-screenshots"))
+			screenshots = atoi(val);
+		else if(string_equal(opt, "-screenshot-interval"))
+			screenshotInterval = atoi(val);
+		else if(string_equal(opt, "-video-buffers"))
+			videoBuffers = atoi(val);
+		else if(string_equal(opt, "-video-buffer-stats"))
+			emuVideo.setLogBufferStats(atoi(val));
+		else if(string_equal(opt, "-input-latency"))
+			InputLatency::setEnabled(atoi(val));
+		else
+			logWarn("unknown command line option: %s", opt);
+	}
+	if(capturePath)
+		VideoCapture::startWithNextGame(capturePath, captureFormat);
+	if(screenshots)
+		emuVideo.takeGameScreenshots(screenshots, screenshotInterval);
 	return launchGame;
 }
 
+static void runFrameHashCheck(const char *path)
+{
+	logMsg("running frame hash check with %s", frameHashConf.hashPath);
+	EmuApp::createSystemWithMedia({}, path, "", Input::defaultEvent(),
+		[](Input::Event)
+		{
+			bool passed = FrameHash::run(frameHashConf);
+			EmuSystem::closeGame(false);
+			Base::exit(passed ? 0 : 1);
+		});
+}
+
 void mainInitCommon(int argc, char** argv)
 {
+	Trace::setThreadName("Main");
 	Base::registerInstance(appID(), argc, argv);
 	Base::setAcceptIPC(appID(), true);
 	Base::setOnInterProcessMessage(
@@ -600,6 +676,12 @@ void mainInitCommon(int argc, char** argv)
 			handleOpenFileCommand(filename);
 		});
 	initOptions();
+	if(auto exitCode = EmuSystem::runCommandLineTool(argc, argv);
+		exitCode)
+	{
+		Base::exit(*exitCode);
+		return;
+	}
 	auto launchGame = parseCmdLineArgs(argc, argv);
 	loadConfigFile();
 	if(auto err = EmuSystem::onOptionsLoaded();
@@ -629,6 +711,12 @@ void mainInitCommon(int argc, char** argv)
 			return;
 		}
 		rendererTask.start(2);
+		// with a separate render thread the core can write the next frame
+		// while the last one is drawn, EmuVideo drops back to 1 buffer
+		// for textures that don't need an exclusive lock
+		if(!videoBuffers)
+			videoBuffers = renderer.threadMode() == Gfx::Renderer::ThreadMode::MULTI ? 3 : 1;
+		emuVideo.setBuffers(videoBuffers);
 	}
 
 	auto compiled = renderer.texAlphaProgram.compile(renderer);
@@ -662,6 +750,7 @@ void mainInitCommon(int argc, char** argv)
 	#endif
 	updateInputDevices();
 
+	emuVideo.setCpuFilter(optionCpuVideoFilter);
 	emuVideoLayer.setLinearFilter(optionImgFilter);
 	emuVideoLayer.setOverlay(optionOverlayEffect);
 	emuVideoLayer.setOverlayIntensity(optionOverlayEffectLevel/100.);
@@ -783,6 +872,7 @@ void mainInitCommon(int argc, char** argv)
 
 	onFrameUpdate = [](Base::Screen::FrameParams params)
 		{
+			TRACE_ZONE("onFrameUpdate");
 			commonUpdateInput();
 			bool doFrame = false;
 			if(unlikely(fastForwardActive || EmuSystem::shouldFastForward()))
@@ -829,6 +919,7 @@ void mainInitCommon(int argc, char** argv)
 						bool renderAudio = optionSound;
 						iterateTimes(framesToSkip, i)
 						{
+							TRACE_ZONE("EmuSystem::runFrame");
 							EmuSystem::runFrame(nullptr, renderAudio);
 						}
 					}
@@ -836,8 +927,10 @@ void mainInitCommon(int argc, char** argv)
 			}
 			if(doFrame)
 			{
+				TRACE_ZONE("EmuSystem::runFrame");
 				bool renderAudio = optionSound;
 				EmuSystem::runFrame(&emuVideo, renderAudio);
+				InputLatency::onFrameFinished();
 			}
 			return true;
 		};
@@ -887,8 +980,9 @@ void mainInitCommon(int argc, char** argv)
 				viewStack.prepareDraw();
 			}
 			auto fence = renderer.addResourceSyncFence();
+			bool tracksInputLatency = emuWin == &mainWin && EmuSystem::isActive() && InputLatency::prepareDraw();
 			rendererTask.draw(mainWin.drawableHolder, win, params,
-				[fence](Gfx::Drawable &drawable, const Base::Window &win, Gfx::RendererDrawTask task)
+				[fence, tracksInputLatency](Gfx::Drawable &drawable, const Base::Window &win, Gfx::RendererDrawTask task)
 				{
 					auto cmds = task.makeRendererCommands(drawable, mainWin.viewport(), mainWin.projectionMat);
 					cmds.clear();
@@ -896,7 +990,11 @@ void mainInitCommon(int argc, char** argv)
 					if(EmuSystem::isActive())
 					{
 						if(emuView.hasLayer())
+						{
 							drawEmuFrame(cmds);
+							if(tracksInputLatency)
+								InputLatency::onPresent();
+						}
 						else
 						{
 							emuView.draw(cmds);
@@ -986,7 +1084,10 @@ void mainInitCommon(int argc, char** argv)
 
 	if(launchGame)
 	{
-		handleOpenFileCommand(launchGame);
+		if(frameHashConf.hashPath)
+			runFrameHashCheck(launchGame);
+		else
+			handleOpenFileCommand(launchGame);
 	}
 }
 
@@ -21,6 +21,7 @@
 #include <emuframework/FilePicker.hh>
 #include "private.hh"
 #include "privateInput.hh"
+#include "InputLatency.hh"
 
 extern bool touchControlsAreOn;
 
@@ -254,6 +255,7 @@ bool EmuInputView::inputEvent(Input::Event e)
 							}
 						}
 						EmuSystem::handleInputAction(e.state(), sysAction);
+						InputLatency::onInputAction(e);
 					}
 				}
 			}
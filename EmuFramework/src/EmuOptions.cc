@@ -19,6 +19,7 @@
 #include <emuframework/VideoImageEffect.hh>
 #include <emuframework/VController.hh>
 #include "private.hh"
+#include "CpuVideoFilter.hh"
 #include "privateInput.hh"
 #ifdef CONFIG_EMUFRAMEWORK_VCONTROLS
 extern SysVController vController;
@@ -109,6 +110,7 @@ Byte1Option optionImgFilter(CFGKEY_GAME_IMG_FILTER, 1, 0);
 #ifdef CONFIG_GFX_OPENGL_SHADER_PIPELINE
 Byte1Option optionImgEffect(CFGKEY_IMAGE_EFFECT, 0, 0, optionIsValidWithMax<VideoImageEffect::LAST_EFFECT_VAL-1>);
 #endif
+Byte1Option optionCpuVideoFilter(CFGKEY_CPU_VIDEO_FILTER, CpuVideoFilter::OFF, 0, optionIsValidWithMax<CpuVideoFilter::LAST_TYPE>);
 Byte1Option optionOverlayEffect(CFGKEY_OVERLAY_EFFECT, 0, 0, optionIsValidWithMax<VideoImageOverlay::MAX_EFFECT_VAL>);
 Byte1Option optionOverlayEffectLevel(CFGKEY_OVERLAY_EFFECT_LEVEL, 25, 0, optionIsValidWithMax<100>);
 
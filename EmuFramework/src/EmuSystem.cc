@@ -24,10 +24,14 @@
 #include <imagine/util/math/int.hh>
 #include <imagine/util/ScopeGuard.hh>
 #include <imagine/util/ringbuffer/sys.hh>
+#include <imagine/logger/Trace.hh>
 #include <algorithm>
 #include <string>
 #include <atomic>
 #include "private.hh"
+#include "FrameHash.hh"
+#include "InputLatency.hh"
+#include "VideoCapture.hh"
 
 struct AudioStats
 {
@@ -74,7 +78,8 @@ double EmuSystem::frameTimePAL = 1./50.;
 [[gnu::weak]] int EmuSystem::forcedSoundRate = 0;
 [[gnu::weak]] bool EmuSystem::constFrameRate = false;
 bool EmuSystem::sessionOptionsSet = false;
-static std::unique_ptr<Audio::SysOutputStream> audioStream;
+static std::unique_ptr<Audio::OutputStream> audioStream;
+static const char *audioSink{}; // "null" or a .wav/raw file path to use instead of the system output
 static IG::SysRingBuffer rBuff{};
 enum class AudioWriteState
 {
@@ -167,6 +172,22 @@ void EmuSystem::startAutoSaveStateTimer()
 	}
 }
 
+void setAudioSink(const char *sink)
+{
+	audioSink = sink;
+}
+
+static std::unique_ptr<Audio::OutputStream> makeAudioOutputStream()
+{
+	if(!audioSink)
+		return std::make_unique<Audio::SysOutputStream>();
+	if(string_equal(audioSink, "null"))
+		return std::make_unique<Audio::NullOutputStream>();
+	auto fileFormat = string_hasDotExtension(audioSink, "wav") ?
+		Audio::FileOutputStream::FileFormat::WAV : Audio::FileOutputStream::FileFormat::RAW;
+	return std::make_unique<Audio::FileOutputStream>(audioSink, fileFormat);
+}
+
 void EmuSystem::startSound()
 {
 	assert(audioFramesPerVideoFrame);
@@ -174,7 +195,7 @@ void EmuSystem::startSound()
 	{
 		if(!audioStream)
 		{
-			audioStream = std::make_unique<Audio::SysOutputStream>();
+			audioStream = makeAudioOutputStream();
 		}
 		if(!audioStream->isOpen())
 		{
@@ -191,6 +212,7 @@ void EmuSystem::startSound()
 				pcmFormat,
 				[](void *samples, uint bytes)
 				{
+					TRACE_ZONE("audio callback");
 					#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 					audioStats.callbacks++;
 					audioStats.callbackBytes += bytes;
@@ -224,7 +246,14 @@ void EmuSystem::startSound()
 			};
 			outputConf.setWantedLatencyHint(0);
 			startAudioStats();
-			audioStream->open(outputConf);
+			if(auto ec = audioStream->open(outputConf);
+				ec && !audioSink)
+			{
+				// keep the same pacing on systems without a usable sound device
+				logErr("error opening audio output, using null output");
+				audioStream = std::make_unique<Audio::NullOutputStream>();
+				audioStream->open(outputConf);
+			}
 		}
 		else
 		{
@@ -273,19 +302,42 @@ void EmuSystem::flushSound()
 	}
 }
 
-void EmuSystem::writeSound(const void *samples, uint framesToWrite)
+static void prepareAudioWrite()
 {
 	if(unlikely(audioWriteState == AudioWriteState::UNDERRUN))
 	{
-		if(pcmFormat.bytesToSecs(rBuff.capacity()) <= 1.) // hard cap buffer increase to 1 sec
+		if(EmuSystem::pcmFormat.bytesToSecs(rBuff.capacity()) <= 1.) // hard cap buffer increase to 1 sec
 		{
-			auto addedBuffTime = std::round(1000000. * frameTime());
-			uint newSize = rBuff.capacity() + pcmFormat.uSecsToBytes(addedBuffTime);
+			auto addedBuffTime = std::round(1000000. * EmuSystem::frameTime());
+			uint newSize = rBuff.capacity() + EmuSystem::pcmFormat.uSecsToBytes(addedBuffTime);
 			logMsg("increasing sound buffer size to %u bytes due to underrun", newSize);
-			rBuff.init(rBuff.capacity() + pcmFormat.uSecsToBytes(addedBuffTime));
+			rBuff.init(rBuff.capacity() + EmuSystem::pcmFormat.uSecsToBytes(addedBuffTime));
 		}
 		audioWriteState = AudioWriteState::BUFFER;
 	}
+}
+
+static void finishAudioWrite()
+{
+	if(audioWriteState == AudioWriteState::BUFFER && shouldStartAudioWrites())
+	{
+		logMsg("starting audio writes with buffer fill %u/%u bytes", rBuff.size(), rBuff.capacity());
+		audioWriteState = AudioWriteState::ACTIVE;
+	}
+}
+
+void EmuSystem::writeSound(const void *samples, uint framesToWrite)
+{
+	if(unlikely(FrameHash::isActive()))
+	{
+		FrameHash::addAudio(samples, pcmFormat.framesToBytes(framesToWrite));
+		return;
+	}
+	if(unlikely(VideoCapture::isActive()))
+	{
+		VideoCapture::addAudio(samples, pcmFormat.framesToBytes(framesToWrite));
+	}
+	prepareAudioWrite();
 	uint bytes = pcmFormat.framesToBytes(framesToWrite);
 	uint freeBytes = rBuff.freeSpace();
 	if(bytes <= freeBytes)
@@ -307,11 +359,29 @@ void EmuSystem::writeSound(const void *samples, uint framesToWrite)
 		}
 		rBuff.commitWrite(freeBytes);
 	}
-	if(audioWriteState == AudioWriteState::BUFFER && shouldStartAudioWrites())
+	finishAudioWrite();
+}
+
+void *EmuSystem::startSoundWrite(uint framesToWrite)
+{
+	// returns a pointer to write the frames directly into the audio buffer,
+	// or null if they don't fit and writeSound() should be used instead
+	if(unlikely(FrameHash::isActive()))
+		return nullptr;
+	prepareAudioWrite();
+	if(pcmFormat.framesToBytes(framesToWrite) > rBuff.freeContiguousSpace())
+		return nullptr;
+	return rBuff.writeAddr();
+}
+
+void EmuSystem::commitSoundWrite(uint framesWritten)
+{
+	if(unlikely(VideoCapture::isActive()))
 	{
-		logMsg("starting audio writes with buffer fill %u/%u bytes", rBuff.size(), rBuff.capacity());
-		audioWriteState = AudioWriteState::ACTIVE;
+		VideoCapture::addAudio(rBuff.writeAddr(), pcmFormat.framesToBytes(framesWritten));
 	}
+	rBuff.commitWrite(pcmFormat.framesToBytes(framesWritten));
+	finishAudioWrite();
 }
 
 bool EmuSystem::stateExists(int slot)
@@ -325,6 +395,68 @@ bool EmuSystem::shouldOverwriteExistingState()
 	return !optionConfirmOverwriteState || !EmuSystem::stateExists(EmuSystem::saveStateSlot);
 }
 
+struct MemoryStateHeader
+{
+	std::array<char, 4> magic;
+	uint32_t version;
+	uint32_t headerSize;
+	uint32_t dataSize;
+	std::array<char, 16> system;
+};
+
+static constexpr std::array<char, 4> MEMORY_STATE_MAGIC{'E', 'M', 'S', 'T'};
+static constexpr uint32_t MEMORY_STATE_VERSION = 1;
+
+size_t EmuSystem::stateSize()
+{
+	if(!gameIsRunning())
+		return 0;
+	auto dataSize = stateDataSize();
+	if(!dataSize)
+		return 0;
+	return sizeof(MemoryStateHeader) + dataSize;
+}
+
+EmuSystem::Error EmuSystem::saveStateToMemory(void *buff, size_t size, size_t &bytesWritten)
+{
+	bytesWritten = 0;
+	if(!gameIsRunning())
+		return makeError("No game is running");
+	if(size < sizeof(MemoryStateHeader))
+		return makeError("State buffer too small");
+	size_t dataSize = 0;
+	if(auto err = saveStateData((char*)buff + sizeof(MemoryStateHeader), size - sizeof(MemoryStateHeader), dataSize);
+		err)
+	{
+		return err;
+	}
+	assumeExpr(dataSize <= size - sizeof(MemoryStateHeader));
+	MemoryStateHeader header{MEMORY_STATE_MAGIC, MEMORY_STATE_VERSION, sizeof(MemoryStateHeader), (uint32_t)dataSize, {}};
+	string_copy(header.system, shortSystemName());
+	memcpy(buff, &header, sizeof(header));
+	bytesWritten = sizeof(MemoryStateHeader) + dataSize;
+	return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateFromMemory(const void *buff, size_t size)
+{
+	if(!gameIsRunning())
+		return makeError("No game is running");
+	MemoryStateHeader header;
+	if(size < sizeof(header))
+		return makeError("Invalid state data");
+	memcpy(&header, buff, sizeof(header));
+	if(header.magic != MEMORY_STATE_MAGIC)
+		return makeError("Invalid state data");
+	if(header.version != MEMORY_STATE_VERSION || header.headerSize != sizeof(header))
+		return makeError("Unsupported state version %u", header.version);
+	if(strncmp(header.system.data(), shortSystemName(), header.system.size()) != 0)
+		return makeError("State is from another system");
+	if(header.dataSize > size - sizeof(header))
+		return makeError("Truncated state data");
+	return loadStateData((const char*)buff + sizeof(header), header.dataSize);
+}
+
 uint EmuSystem::advanceFramesWithTime(Base::FrameTimeBase time)
 {
 	if(unlikely(!startFrameTime))
@@ -521,9 +653,12 @@ void EmuSystem::closeGame(bool allowAutosaveState)
 	if(gameIsRunning())
 	{
 		flushSound();
+		VideoCapture::stop();
 		if(allowAutosaveState)
 			EmuApp::saveAutoState();
 		EmuApp::saveSessionOptions();
+		if(InputLatency::isEnabled())
+			InputLatency::report(FS::makePathStringPrintf("%s/inputLatency.txt", savePath()).data());
 		logMsg("closing game %s", gameName_.data());
 		closeSystem();
 		cancelAutoSaveStateTimer();
@@ -579,6 +714,7 @@ void EmuSystem::skipFrames(uint frames, bool renderAudio)
 		audioWriteState = AudioWriteState::BUFFER;
 	iterateTimes(frames, i)
 	{
+		TRACE_ZONE("EmuSystem::runFrame");
 		bool renderAudioThisFrame = renderAudio && audioFramesWritten() <= EmuSystem::audioFramesPerVideoFrame;
 		runFrame(nullptr, renderAudioThisFrame);
 	}
@@ -661,6 +797,7 @@ void EmuSystem::prepareAudioVideo()
 {
 	EmuSystem::configAudioPlayback();
 	EmuSystem::onPrepareVideo(emuVideo);
+	VideoCapture::startPending();
 }
 
 static void closeAndSetupNew(const char *path)
@@ -819,6 +956,8 @@ void EmuSystem::sessionOptionSet()
 
 [[gnu::weak]] EmuSystem::Error EmuSystem::onInit() { return {}; }
 
+[[gnu::weak]] std::optional<int> EmuSystem::runCommandLineTool(int argc, char** argv) { return {}; }
+
 [[gnu::weak]] void EmuSystem::initOptions() {}
 
 [[gnu::weak]] EmuSystem::Error EmuSystem::onOptionsLoaded() { return {}; }
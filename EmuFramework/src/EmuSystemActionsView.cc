@@ -27,7 +27,9 @@
 #include <emuframework/InputManagerView.hh>
 #include <emuframework/TouchConfigView.hh>
 #include <emuframework/BundledGamesView.hh>
+#include <imagine/logger/Trace.hh>
 #include "private.hh"
+#include "VideoCapture.hh"
 
 class ResetAlertView : public BaseAlertView
 {
@@ -92,6 +94,11 @@ void EmuSystemActionsView::onShow()
 	stateSlotText[12] = EmuSystem::saveSlotChar(EmuSystem::saveStateSlot);
 	stateSlot.compile(renderer(), projP);
 	screenshot.setActive(EmuSystem::gameIsRunning());
+	frameTrace.t.setString(Trace::isEnabled() ? "Save Frame Trace" : "Start Frame Trace");
+	frameTrace.compile(renderer(), projP);
+	videoCapture.setActive(EmuSystem::gameIsRunning());
+	videoCapture.t.setString(VideoCapture::isActive() ? "Stop Video Capture" : "Start Video Capture");
+	videoCapture.compile(renderer(), projP);
 	#if defined CONFIG_BASE_ANDROID && !defined CONFIG_MACHINE_OUYA
 	addLauncherIcon.setActive(EmuSystem::gameIsRunning());
 	#endif
@@ -114,6 +121,8 @@ void EmuSystemActionsView::loadStandardItems()
 	item.emplace_back(&addLauncherIcon);
 	#endif
 	item.emplace_back(&screenshot);
+	item.emplace_back(&frameTrace);
+	item.emplace_back(&videoCapture);
 	item.emplace_back(&resetSessionOptions);
 	item.emplace_back(&close);
 }
@@ -275,6 +284,63 @@ EmuSystemActionsView::EmuSystemActionsView(ViewAttachParams attach, bool customM
 			}
 		}
 	},
+	frameTrace
+	{
+		"Start Frame Trace",
+		[this]()
+		{
+			if(!Trace::isEnabled())
+			{
+				Trace::setEnabled(true);
+				frameTrace.t.setString("Save Frame Trace");
+				frameTrace.compile(renderer(), projP);
+				popup.post("Started recording frame timings");
+				return;
+			}
+			auto path = FS::makePathStringPrintf("%s/frameTrace.json", EmuSystem::savePath());
+			if(auto ec = Trace::writeChromeJSON(path.data());
+				ec)
+			{
+				popup.post("Error writing frame trace", ec);
+			}
+			else
+			{
+				popup.printf(3, 0, "Wrote %s", path.data());
+			}
+		}
+	},
+	videoCapture
+	{
+		"Start Video Capture",
+		[this]()
+		{
+			if(VideoCapture::isActive())
+			{
+				VideoCapture::stop();
+				videoCapture.t.setString("Start Video Capture");
+				videoCapture.compile(renderer(), projP);
+				popup.post("Stopped video capture");
+				return;
+			}
+			if(!EmuSystem::gameIsRunning())
+				return;
+			FS::PathString basePath{};
+			iterateTimes(999, i)
+			{
+				string_printf(basePath, "%s/%s.%.3d", EmuSystem::savePath(), EmuSystem::gameName().data(), i);
+				if(!FS::exists(FS::makePathStringPrintf("%s.y4m", basePath.data())))
+					break;
+			}
+			if(!VideoCapture::start(basePath.data(), VideoCapture::Format::Y4M))
+			{
+				popup.postError("Error starting video capture");
+				return;
+			}
+			videoCapture.t.setString("Stop Video Capture");
+			videoCapture.compile(renderer(), projP);
+			popup.printf(3, 0, "Capturing to %s.y4m", basePath.data());
+		}
+	},
 	resetSessionOptions
 	{
 		"Reset Saved Options",
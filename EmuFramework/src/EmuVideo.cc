@@ -18,34 +18,122 @@
 #include "EmuOptions.hh"
 #include <emuframework/EmuApp.hh>
 #include <emuframework/Screenshot.hh>
+#include <imagine/logger/Trace.hh>
 #include "private.hh"
+#include "FrameHash.hh"
+#include "ScreenshotWriter.hh"
+#include "VideoCapture.hh"
+#include "CpuVideoFilter.hh"
+#include <algorithm>
+
+static ScreenshotWriter screenshotWriter{};
+static CpuVideoFilter cpuFilter{};
+
+static uint makeBufferState(uint presented, uint drawn)
+{
+	return presented | (drawn << 8);
+}
+
+static uint presentedBuffer(uint state)
+{
+	return state & 0xFF;
+}
+
+static uint drawnBuffer(uint state)
+{
+	return state >> 8;
+}
+
+void EmuVideo::setBuffers(uint buffers)
+{
+	buffers = std::clamp(buffers, 1u, MAX_BUFFERS);
+	if(buffers == buffers_)
+		return;
+	logMsg("using %u video buffers", buffers);
+	buffers_ = buffers;
+	if(vidImg[0])
+		resetImage();
+}
 
 void EmuVideo::resetImage()
 {
-	auto desc = vidImg.usedPixmapDesc();
-	vidImg.deinit();
-	setFormat(desc);
+	for(auto &img : vidImg)
+	{
+		img.deinit();
+	}
+	setFormat(srcDesc);
+}
+
+void EmuVideo::setCpuFilter(uint type)
+{
+	cpuFilter.setType(type);
+	if(vidImg[0])
+		setFormat(srcDesc);
 }
 
 void EmuVideo::setFormat(IG::PixmapDesc desc)
 {
-	if(vidImg && desc == vidImg.usedPixmapDesc())
+	srcDesc = desc;
+	isFiltering = cpuFilter.isActiveFor(desc);
+	if(filterSrcPix && (!isFiltering || (IG::PixmapDesc)filterSrcPix != desc))
+	{
+		filterSrcPix = {};
+	}
+	if(isFiltering)
+	{
+		desc = cpuFilter.outputDesc(desc);
+	}
+	if(vidImg[0] && desc == vidImg[0].usedPixmapDesc())
 	{
 		return; // no change to format
 	}
 	memPix = {};
-	if(!vidImg)
+	if(vidImg[0])
 	{
-		Gfx::TextureConfig conf{desc};
-		conf.setWillWriteOften(true);
-		vidImg = r.makePixmapTexture(conf);
+		rendererTask.haltDrawing();
 	}
-	else
+	clearDrawFences();
+	usedBuffers = buffers_;
+	for(uint i = 0; i < usedBuffers; i++)
 	{
-		rendererTask.haltDrawing();
-		vidImg.setFormat(desc, 1);
+		auto &img = vidImg[i];
+		if(!img)
+		{
+			Gfx::TextureConfig conf{desc};
+			conf.setWillWriteOften(true);
+			img = r.makePixmapTexture(conf);
+		}
+		else
+		{
+			img.setFormat(desc, 1);
+		}
+		if(i == 0 && usedBuffers > 1)
+		{
+			// the renderer orders other texture updates with its draws,
+			// so extra buffers only avoid halts with an exclusive lock
+			if(!img.needsExclusiveLock())
+			{
+				logMsg("texture doesn't need an exclusive lock, using 1 video buffer");
+				usedBuffers = 1;
+			}
+			// the renderer being done with a texture doesn't mean the GPU is
+			else if(!r.hasSyncFences())
+			{
+				logMsg("no sync fences to track GPU reads, using 1 video buffer");
+				usedBuffers = 1;
+			}
+		}
 	}
-	logMsg("resized to:%dx%d", desc.w(), desc.h());
+	for(uint i = usedBuffers; i < MAX_BUFFERS; i++)
+	{
+		vidImg[i].deinit();
+	}
+	writeIdx = 0;
+	bufferState = makeBufferState(0, 0);
+	if(isFiltering)
+		logMsg("resized to:%dx%d (filtered from %dx%d)", desc.w(), desc.h(), srcDesc.w(), srcDesc.h());
+	else
+		logMsg("resized to:%dx%d", desc.w(), desc.h());
 	// update all EmuVideoLayers
 	#ifdef CONFIG_GFX_OPENGL_SHADER_PIPELINE
 	emuVideoLayer.setEffect(optionImgEffect);
@@ -56,17 +144,102 @@ void EmuVideo::setFormat(IG::PixmapDesc desc)
 		placeEmuViews();
 }
 
+void EmuVideo::prepareWriteBuffer()
+{
+	statFrames++;
+	if(usedBuffers == 1)
+	{
+		if(vidImg[0].needsExclusiveLock())
+		{
+			rendererTask.haltDrawing();
+			statHalts++;
+		}
+		return;
+	}
+	// only exclusively locked textures use extra buffers
+	statAvoidedHalts++;
+	auto state = bufferState.load(std::memory_order_acquire);
+	while(true)
+	{
+		iterateTimes(usedBuffers, i)
+		{
+			if(i != presentedBuffer(state) && i != drawnBuffer(state))
+			{
+				writeIdx = i;
+				if(r.clientWaitSync(drawFence[i]))
+					statFenceWaits++;
+				drawFence[i] = {};
+				return;
+			}
+		}
+		// only possible with 2 buffers when the renderer hasn't picked up the
+		// last frame yet, take it back so the new frame replaces it
+		auto retractedState = makeBufferState(drawnBuffer(state), drawnBuffer(state));
+		if(bufferState.compare_exchange_weak(state, retractedState,
+			std::memory_order_acquire, std::memory_order_acquire))
+		{
+			state = retractedState;
+		}
+	}
+}
+
+void EmuVideo::presentWriteBuffer()
+{
+	if(unlikely(logBufferStats) && statFrames >= 600)
+	{
+		logMsg("%u video buffers: %u/%u frames halted the renderer, %u would have with 1 buffer (%u waited on the GPU)",
+			usedBuffers, statHalts, statFrames, statAvoidedHalts, statFenceWaits);
+		statFrames = statHalts = statAvoidedHalts = statFenceWaits = 0;
+	}
+	if(usedBuffers == 1)
+		return;
+	auto state = bufferState.load(std::memory_order_relaxed);
+	while(!bufferState.compare_exchange_weak(state, makeBufferState(writeIdx, drawnBuffer(state)),
+		std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+void EmuVideo::addDrawFence(Gfx::RendererCommands &cmds)
+{
+	if(usedBuffers == 1)
+		return;
+	// only the renderer changes the drawn buffer, the core never writes it
+	auto idx = drawnBuffer(bufferState.load(std::memory_order_relaxed));
+	cmds.deleteSyncFence(drawFence[idx]);
+	drawFence[idx] = cmds.addSyncFence();
+}
+
+void EmuVideo::clearDrawFences()
+{
+	if(std::none_of(drawFence.begin(), drawFence.end(), [](auto &f){ return f.sync; }))
+		return;
+	rendererTask.haltDrawing();
+	for(auto &f : drawFence)
+	{
+		r.clientWaitSync(f);
+		f = {};
+	}
+}
+
 EmuVideoImage EmuVideo::startFrame()
 {
-	if(vidImg.needsExclusiveLock())
-		rendererTask.haltDrawing();
-	auto lockedTex = vidImg.lock(0);
+	TRACE_ZONE("EmuVideo::startFrame");
+	prepareWriteBuffer();
+	if(isFiltering)
+	{
+		// the core renders at its native size, the filter fills the texture in finishFrame()
+		if(!filterSrcPix)
+		{
+			filterSrcPix = {srcDesc};
+		}
+		return {*this, (IG::Pixmap)filterSrcPix};
+	}
+	auto lockedTex = vidImg[writeIdx].lock(0);
 	if(!lockedTex)
 	{
 		if(!memPix)
 		{
 			logMsg("created backing memory pixmap");
-			memPix = {vidImg.usedPixmapDesc()};
+			memPix = {vidImg[writeIdx].usedPixmapDesc()};
 		}
 		return {*this, (IG::Pixmap)memPix};
 	}
@@ -75,52 +248,110 @@ EmuVideoImage EmuVideo::startFrame()
 
 void EmuVideo::startFrame(IG::Pixmap pix)
 {
-	if(vidImg.needsExclusiveLock())
-		rendererTask.haltDrawing();
+	TRACE_ZONE("EmuVideo::startFrame");
+	prepareWriteBuffer();
 	finishFrame(pix);
 }
 
 void EmuVideo::finishFrame(Gfx::LockedTextureBuffer texBuff)
 {
-	if(unlikely(screenshotNextFrame))
+	TRACE_ZONE("EmuVideo::finishFrame");
+	if(unlikely(screenshotsLeft))
 	{
 		doScreenshot(texBuff.pixmap());
 	}
-	vidImg.unlock(texBuff);
+	if(unlikely(FrameHash::isActive()))
+	{
+		FrameHash::addVideoFrame(texBuff.pixmap());
+	}
+	if(unlikely(VideoCapture::isActive()))
+	{
+		VideoCapture::addVideoFrame(texBuff.pixmap());
+	}
+	vidImg[writeIdx].unlock(texBuff);
+	presentWriteBuffer();
 }
 
 void EmuVideo::finishFrame(IG::Pixmap pix)
 {
-	if(unlikely(screenshotNextFrame))
+	TRACE_ZONE("EmuVideo::finishFrame");
+	if(unlikely(screenshotsLeft))
 	{
 		doScreenshot(pix);
 	}
-	vidImg.write(0, pix, {}, vidImg.bestAlignment(pix));
+	if(unlikely(FrameHash::isActive()))
+	{
+		FrameHash::addVideoFrame(pix);
+	}
+	if(unlikely(VideoCapture::isActive()))
+	{
+		VideoCapture::addVideoFrame(pix);
+	}
+	if(isFiltering)
+	{
+		writeFilteredFrame(pix);
+	}
+	else
+	{
+		vidImg[writeIdx].write(0, pix, {}, Gfx::Texture::bestAlignment(pix));
+	}
+	presentWriteBuffer();
+}
+
+void EmuVideo::writeFilteredFrame(IG::Pixmap pix)
+{
+	TRACE_ZONE("EmuVideo::writeFilteredFrame");
+	auto &img = vidImg[writeIdx];
+	auto lockedTex = img.lock(0);
+	if(lockedTex)
+	{
+		cpuFilter.run(lockedTex.pixmap(), pix);
+		img.unlock(lockedTex);
+		return;
+	}
+	if(!memPix)
+	{
+		logMsg("created backing memory pixmap");
+		memPix = {img.usedPixmapDesc()};
+	}
+	cpuFilter.run(memPix, pix);
+	img.write(0, memPix, {}, Gfx::Texture::bestAlignment(memPix));
 }
 
 void EmuVideo::takeGameScreenshot()
 {
-	screenshotNextFrame = true;
+	takeGameScreenshots(1, 1);
+}
+
+void EmuVideo::takeGameScreenshots(uint count, uint frameInterval)
+{
+	screenshotsLeft = count;
+	screenshotInterval = std::max(frameInterval, 1u);
+	screenshotFrameDelay = 0;
 }
 
 void EmuVideo::doScreenshot(IG::Pixmap pix)
 {
-	screenshotNextFrame = false;
-	FS::PathString path;
-	int screenshotNum = sprintScreenshotFilename(path);
-	if(screenshotNum == -1)
+	if(screenshotFrameDelay)
 	{
-		popup.postError("Too many screenshots");
+		screenshotFrameDelay--;
+		return;
 	}
-	else
+	screenshotsLeft--;
+	screenshotFrameDelay = screenshotInterval - 1;
+	switch(screenshotWriter.write(pix))
 	{
-		if(!writeScreenshot(pix, path.data()))
+		bcase ScreenshotWriter::Result::QUEUED:
+		{}
+		bcase ScreenshotWriter::Result::POOL_FULL:
 		{
-			popup.printf(2, 1, "Error writing screenshot #%d", screenshotNum);
+			// the encoder is behind, drop this frame instead of waiting on it
+			logWarn("skipped screenshot, encoder busy");
 		}
-		else
+		bcase ScreenshotWriter::Result::NO_FILENAMES_LEFT:
 		{
-			popup.printf(2, 0, "Wrote screenshot #%d", screenshotNum);
+			screenshotsLeft = 0;
+			popup.postError("Too many screenshots");
 		}
 	}
 }
@@ -128,7 +359,7 @@ void EmuVideo::doScreenshot(IG::Pixmap pix)
 bool EmuVideo::isExternalTexture()
 {
 	#ifdef __ANDROID__
-	return vidImg.isExternal();
+	return vidImg[0].isExternal();
 	#else
 	return false;
 	#endif
@@ -136,7 +367,15 @@ bool EmuVideo::isExternalTexture()
 
 Gfx::PixmapTexture &EmuVideo::image()
 {
-	return vidImg;
+	return vidImg[presentedBuffer(bufferState.load(std::memory_order_acquire))];
+}
+
+Gfx::PixmapTexture &EmuVideo::imageForDraw()
+{
+	auto state = bufferState.load(std::memory_order_acquire);
+	while(!bufferState.compare_exchange_weak(state, makeBufferState(presentedBuffer(state), presentedBuffer(state)),
+		std::memory_order_acq_rel, std::memory_order_acquire)) {}
+	return vidImg[presentedBuffer(state)];
 }
 
 void EmuVideoImage::endFrame()
@@ -153,8 +392,16 @@ void EmuVideoImage::endFrame()
 
 IG::WP EmuVideo::size() const
 {
-	if(!vidImg)
+	if(!vidImg[0])
+		return {};
+	else
+		return vidImg[0].usedPixmapDesc().size();
+}
+
+IG::WP EmuVideo::gameSize() const
+{
+	if(!vidImg[0])
 		return {};
 	else
-		return vidImg.usedPixmapDesc().size();
+		return srcDesc.size();
 }
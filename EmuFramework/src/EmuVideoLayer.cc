@@ -60,9 +60,9 @@ void EmuVideoLayer::place(const IG::WindowRect &viewportRect, const Gfx::Project
 		float viewportAspectRatio = viewportRect.xSize()/(float)viewportRect.ySize();
 		// compute the video rectangle in pixel coordinates
 		if(((uint)optionImageZoom == optionImageZoomIntegerOnly || (uint)optionImageZoom == optionImageZoomIntegerOnlyY)
-			&& video.size().x)
+			&& video.gameSize().x)
 		{
-			uint gameX = video.size().x, gameY = video.size().y;
+			uint gameX = video.gameSize().x, gameY = video.gameSize().y;
 
 			// Halve pixel sizes if image has mixed low/high-res content so scaling is based on lower res,
 			// this prevents jumping between two screen sizes in games like Seiken Densetsu 3 on SNES
@@ -238,6 +238,7 @@ void EmuVideoLayer::draw(Gfx::RendererCommands &cmds, const Gfx::ProjectionPlane
 		}
 
 		cmds.setBlendMode(0);
+		auto &img = video.imageForDraw();
 		#ifdef CONFIG_GFX_OPENGL_SHADER_PIPELINE
 		if(vidImgEffect.program())
 		{
@@ -247,7 +248,7 @@ void EmuVideoLayer::draw(Gfx::RendererCommands &cmds, const Gfx::ProjectionPlane
 			cmds.setRenderTarget(vidImgEffect.renderTarget());
 			cmds.setDither(false);
 			cmds.clear();
-			vidImgEffect.drawRenderTarget(cmds, video.image());
+			vidImgEffect.drawRenderTarget(cmds, img);
 			cmds.setDefaultRenderTarget();
 			cmds.setDither(true);
 			cmds.setViewport(prevViewport);
@@ -256,6 +257,11 @@ void EmuVideoLayer::draw(Gfx::RendererCommands &cmds, const Gfx::ProjectionPlane
 		else
 		#endif
 		{
+			// all video buffers share the same format and UV bounds
+			#ifdef CONFIG_GFX_OPENGL_SHADER_PIPELINE
+			if(!vidImgEffect.renderTarget())
+			#endif
+				disp.setImg(&img);
 			disp.setCommonProgram(cmds, videoActive ? IMG_MODE_REPLACE : IMG_MODE_MODULATE, projP.makeTranslate());
 		}
 		if(useLinearFilter)
@@ -263,6 +269,7 @@ void EmuVideoLayer::draw(Gfx::RendererCommands &cmds, const Gfx::ProjectionPlane
 		else
 			cmds.setCommonTextureSampler(Gfx::CommonTextureSampler::NO_LINEAR_NO_MIP_CLAMP);
 		disp.draw(cmds);
+		video.addDrawFence(cmds);
 		vidImgOverlay.draw(cmds);
 	}
 }
@@ -279,7 +286,7 @@ void EmuVideoLayer::setOverlayIntensity(Gfx::GC intensity)
 
 void EmuVideoLayer::placeOverlay()
 {
-	vidImgOverlay.place(disp, video.size().y);
+	vidImgOverlay.place(disp, video.gameSize().y);
 }
 
 void EmuVideoLayer::setEffectBitDepth(uint bits)
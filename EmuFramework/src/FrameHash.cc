@@ -0,0 +1,300 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "FrameHash"
+#include "FrameHash.hh"
+#include <emuframework/EmuSystem.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <vector>
+#include <cstdio>
+#include "private.hh"
+
+namespace FrameHash
+{
+
+struct InputLogEvent
+{
+	uint frame;
+	uint action;
+	uint state;
+};
+
+struct Hashes
+{
+	uint64_t video;
+	uint64_t audio;
+
+	bool operator==(const Hashes &rhs) const
+	{
+		return video == rhs.video && audio == rhs.audio;
+	}
+};
+
+// 64-bit FNV-1a
+static constexpr uint64_t HASH_BASIS = 0xcbf29ce484222325;
+static constexpr uint64_t HASH_PRIME = 0x100000001b3;
+
+bool isActive_ = false;
+static uint64_t videoHash = HASH_BASIS;
+static uint64_t audioHash = HASH_BASIS;
+
+static uint64_t addBytes(uint64_t hash, const void *data, size_t bytes)
+{
+	auto byte = (const uint8*)data;
+	iterateTimes(bytes, i)
+	{
+		hash = (hash ^ byte[i]) * HASH_PRIME;
+	}
+	return hash;
+}
+
+void addVideoFrame(const IG::Pixmap &pix)
+{
+	// hash only the visible part of each line, not the pitch padding
+	auto lineBytes = pix.w() * pix.format().bytesPerPixel();
+	iterateTimes(pix.h(), y)
+	{
+		videoHash = addBytes(videoHash, pix.pixel({0, (int)y}), lineBytes);
+	}
+}
+
+void addAudio(const void *samples, uint bytes)
+{
+	audioHash = addBytes(audioHash, samples, bytes);
+}
+
+// input log lines are "<frame> <action> <state>" using the core's
+// EmuSystem::handleInputAction() numbering, '#' starts a comment line
+static bool readInputLog(const char *path, std::vector<InputLogEvent> &events)
+{
+	auto f = fopen(path, "rb");
+	if(!f)
+	{
+		logErr("error opening input log %s", path);
+		return false;
+	}
+	char line[128];
+	while(fgets(line, sizeof(line), f))
+	{
+		InputLogEvent e;
+		if(line[0] == '#' || sscanf(line, "%u %u %u", &e.frame, &e.action, &e.state) != 3)
+			continue;
+		events.push_back(e);
+	}
+	fclose(f);
+	std::stable_sort(events.begin(), events.end(),
+		[](const InputLogEvent &lhs, const InputLogEvent &rhs){ return lhs.frame < rhs.frame; });
+	logMsg("read %zu input events from %s", events.size(), path);
+	return true;
+}
+
+static bool readHashes(const char *path, std::vector<Hashes> &hashes)
+{
+	auto f = fopen(path, "rb");
+	if(!f)
+	{
+		logErr("error opening hash file %s", path);
+		return false;
+	}
+	uint frame;
+	unsigned long long video, audio;
+	while(fscanf(f, "%u %llx %llx", &frame, &video, &audio) == 3)
+	{
+		if(frame != hashes.size())
+		{
+			logErr("expected frame %zu in hash file, got %u", hashes.size(), frame);
+			fclose(f);
+			return false;
+		}
+		hashes.push_back({(uint64_t)video, (uint64_t)audio});
+	}
+	fclose(f);
+	return true;
+}
+
+static bool writeHashes(const char *path, const std::vector<Hashes> &hashes)
+{
+	auto f = fopen(path, "wb");
+	if(!f)
+	{
+		logErr("error creating hash file %s", path);
+		return false;
+	}
+	iterateTimes(hashes.size(), i)
+	{
+		fprintf(f, "%u %016llx %016llx\n", i,
+			(unsigned long long)hashes[i].video, (unsigned long long)hashes[i].audio);
+	}
+	return fclose(f) == 0;
+}
+
+static void applyInput(std::vector<InputLogEvent>::const_iterator &nextInput,
+	std::vector<InputLogEvent>::const_iterator end, uint frame)
+{
+	for(; nextInput != end && nextInput->frame <= frame; ++nextInput)
+	{
+		EmuSystem::handleInputAction(nextInput->state ? Input::PUSHED : Input::RELEASED, nextInput->action);
+	}
+}
+
+static Hashes runHashedFrame()
+{
+	videoHash = HASH_BASIS;
+	audioHash = HASH_BASIS;
+	EmuSystem::runFrame(&emuVideo, true);
+	return {videoHash, audioHash};
+}
+
+static bool saveMemoryState(std::vector<char> &state)
+{
+	state.resize(EmuSystem::stateSize());
+	size_t bytes = 0;
+	auto err = EmuSystem::saveStateToMemory(state.data(), state.size(), bytes);
+	if(err)
+	{
+		// variable sized states raise their size estimate on failure, try once more
+		state.resize(EmuSystem::stateSize());
+		err = EmuSystem::saveStateToMemory(state.data(), state.size(), bytes);
+	}
+	if(err)
+	{
+		logErr("error saving memory state: %s", err->what());
+		return false;
+	}
+	state.resize(bytes);
+	return true;
+}
+
+// reloads the state saved before frame startFrame, puts the buttons back in the
+// state the input log had them at that frame, and runs the remaining frames again
+static bool checkStateRoundTrip(const Config &conf, const std::vector<InputLogEvent> &input,
+	const std::vector<char> &state, const std::vector<Hashes> &hashes)
+{
+	uint startFrame = conf.stateRoundTripFrame;
+	if(auto err = EmuSystem::loadStateFromMemory(state.data(), state.size());
+		err)
+	{
+		logErr("error loading memory state: %s", err->what());
+		return false;
+	}
+	std::vector<char> reloadedState;
+	if(!saveMemoryState(reloadedState))
+		return false;
+	if(reloadedState != state)
+	{
+		logWarn("state data from frame %u differs after reloading it", startFrame);
+	}
+	for(auto &e : input)
+	{
+		EmuSystem::handleInputAction(Input::RELEASED, e.action);
+	}
+	auto nextInput = input.cbegin();
+	if(startFrame)
+		applyInput(nextInput, input.cend(), startFrame - 1);
+	for(uint frame = startFrame; frame < conf.frames; frame++)
+	{
+		applyInput(nextInput, input.cend(), frame);
+		auto h = runHashedFrame();
+		if(!(h == hashes[frame]))
+		{
+			logErr("first diverging frame after reloading the state from frame %u: %u (%s%s)", startFrame, frame,
+				h.video != hashes[frame].video ? "video " : "",
+				h.audio != hashes[frame].audio ? "audio" : "");
+			return false;
+		}
+	}
+	logMsg("state round trip from frame %u matches over %u frames (%zu bytes)",
+		startFrame, conf.frames - startFrame, state.size());
+	return true;
+}
+
+bool run(const Config &conf)
+{
+	if(conf.stateRoundTripFrame >= 0 && (uint)conf.stateRoundTripFrame >= conf.frames)
+	{
+		logErr("state round trip frame %d is past the last frame", conf.stateRoundTripFrame);
+		return false;
+	}
+	if(conf.statePath)
+	{
+		if(auto err = EmuSystem::loadState(conf.statePath);
+			err)
+		{
+			logErr("error loading state %s: %s", conf.statePath, err->what());
+			return false;
+		}
+	}
+	std::vector<InputLogEvent> input;
+	if(conf.inputLogPath && !readInputLog(conf.inputLogPath, input))
+		return false;
+	std::vector<Hashes> golden;
+	bool writeGolden = !FS::exists(conf.hashPath);
+	if(!writeGolden && !readHashes(conf.hashPath, golden))
+		return false;
+
+	std::vector<Hashes> hashes;
+	hashes.reserve(conf.frames);
+	std::vector<char> roundTripState;
+	auto nextInput = input.cbegin();
+	isActive_ = true;
+	auto startTime = IG::Time::now();
+	iterateTimes(conf.frames, frame)
+	{
+		if((int)frame == conf.stateRoundTripFrame && !saveMemoryState(roundTripState))
+		{
+			isActive_ = false;
+			return false;
+		}
+		applyInput(nextInput, input.cend(), frame);
+		hashes.push_back(runHashedFrame());
+	}
+	auto time = IG::Time::now() - startTime;
+	logMsg("ran %u frames in %f secs (%.2f fps)", conf.frames, double(time), conf.frames / double(time));
+	if(conf.stateRoundTripFrame >= 0 && !checkStateRoundTrip(conf, input, roundTripState, hashes))
+	{
+		isActive_ = false;
+		return false;
+	}
+	isActive_ = false;
+
+	if(writeGolden)
+	{
+		if(!writeHashes(conf.hashPath, hashes))
+			return false;
+		logMsg("wrote golden hashes to %s", conf.hashPath);
+		return true;
+	}
+	auto frames = std::min(hashes.size(), golden.size());
+	auto mismatch = std::mismatch(hashes.begin(), hashes.begin() + frames, golden.begin());
+	if(mismatch.first != hashes.begin() + frames)
+	{
+		auto frame = mismatch.first - hashes.begin();
+		logErr("first diverging frame: %zu (%s%s)", (size_t)frame,
+			mismatch.first->video != mismatch.second->video ? "video " : "",
+			mismatch.first->audio != mismatch.second->audio ? "audio" : "");
+		return false;
+	}
+	if(hashes.size() > golden.size())
+	{
+		logWarn("only the first %zu frames have golden hashes", golden.size());
+	}
+	logMsg("all %zu frames match", frames);
+	return true;
+}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/pixmap/Pixmap.hh>
+
+// Deterministic regression check, runs the loaded game for a fixed number of
+// frames with an optional savestate and input log, hashing every video frame
+// and audio block. Without an existing hash file the hashes are written as the
+// golden reference, otherwise they're compared and the first diverging frame
+// is reported. Optionally a memory state is saved at a given frame and after
+// the run it's loaded back and the remaining frames are run again, which must
+// give the same hashes.
+
+namespace FrameHash
+{
+
+struct Config
+{
+	const char *hashPath{};
+	const char *statePath{};
+	const char *inputLogPath{};
+	uint frames = 600;
+	int stateRoundTripFrame = -1; // -1 for no memory state round trip
+};
+
+// returns true when all frames matched or the hash file was written
+bool run(const Config &conf);
+
+extern bool isActive_;
+
+static bool isActive() { return isActive_; }
+void addVideoFrame(const IG::Pixmap &pix);
+void addAudio(const void *samples, uint bytes);
+
+}
@@ -0,0 +1,236 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "InputLatency"
+#include "InputLatency.hh"
+#include <imagine/time/Time.hh>
+#include <imagine/logger/logger.h>
+#include <imagine/util/algorithm.h>
+#include <imagine/util/string.h>
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <cstdio>
+
+namespace InputLatency
+{
+
+static constexpr uint MAX_DEVICES = 8;
+static constexpr uint BUCKET_MSECS = 4;
+static constexpr uint BUCKETS = 32; // the last bucket also counts anything slower
+static constexpr uint64_t NSEC_PER_MSEC = 1000000;
+// reject event times that aren't from the same clock as IG::Time::now()
+static constexpr uint64_t MAX_EVENT_AGE_NSECS = 1000 * NSEC_PER_MSEC;
+
+struct DeviceStats
+{
+	// main thread
+	const Input::Device *dev{};
+	std::array<char, 64> name{};
+	uint64_t eventNSecs{}; // earliest press not run by a frame yet
+	uint64_t frameEventNSecs{}; // earliest press run by a frame not drawn yet
+	uint64_t handledTotalNSecs{};
+	uint64_t frameTotalNSecs{};
+	uint handledSamples{};
+	uint frameSamples{};
+	// handed to the presenting thread
+	std::atomic<uint64_t> drawEventNSecs{};
+	// presenting thread
+	std::atomic<uint64_t> presentTotalNSecs{};
+	std::atomic<uint64_t> presentMinNSecs{};
+	std::atomic<uint64_t> presentMaxNSecs{};
+	std::atomic_uint presentSamples{};
+	std::atomic_uint bucket[BUCKETS]{};
+};
+
+static DeviceStats devStats[MAX_DEVICES];
+static uint devices = 0;
+static bool hasPendingEvents = false;
+static bool hasFrameEvents = false;
+static bool enabled = false;
+
+static DeviceStats *statsForDevice(const Input::Device &dev)
+{
+	iterateTimes(devices, i)
+	{
+		if(devStats[i].dev == &dev)
+			return &devStats[i];
+	}
+	if(devices == MAX_DEVICES)
+		return nullptr;
+	auto &stats = devStats[devices++];
+	stats.dev = &dev;
+	string_copy(stats.name, dev.name());
+	return &stats;
+}
+
+void setEnabled(bool on)
+{
+	enabled = on;
+}
+
+bool isEnabled()
+{
+	return enabled;
+}
+
+void onInputAction(Input::Event e)
+{
+	if(likely(!enabled))
+		return;
+	if(!e.pushed() || e.repeated() || !e.device())
+		return;
+	auto now = IG::Time::now().nSecs();
+	auto eventNSecs = IG::Time(e.time()).nSecs();
+	if(!eventNSecs || eventNSecs > now || now - eventNSecs > MAX_EVENT_AGE_NSECS)
+		return;
+	auto stats = statsForDevice(*e.device());
+	if(!stats || stats->eventNSecs)
+		return; // an earlier press is already waiting for the next frame
+	stats->eventNSecs = eventNSecs;
+	stats->handledTotalNSecs += now - eventNSecs;
+	stats->handledSamples++;
+	hasPendingEvents = true;
+}
+
+void onFrameFinished()
+{
+	if(likely(!hasPendingEvents))
+		return;
+	hasPendingEvents = false;
+	auto now = IG::Time::now().nSecs();
+	iterateTimes(devices, i)
+	{
+		auto &stats = devStats[i];
+		if(!stats.eventNSecs)
+			continue;
+		stats.frameTotalNSecs += now - stats.eventNSecs;
+		stats.frameSamples++;
+		if(!stats.frameEventNSecs)
+			stats.frameEventNSecs = stats.eventNSecs;
+		stats.eventNSecs = 0;
+	}
+	hasFrameEvents = true;
+}
+
+bool prepareDraw()
+{
+	if(likely(!hasFrameEvents))
+		return false;
+	hasFrameEvents = false;
+	iterateTimes(devices, i)
+	{
+		auto &stats = devStats[i];
+		if(!stats.frameEventNSecs)
+			continue;
+		// keep the older press if the previous draw hasn't been presented yet
+		uint64_t expected = 0;
+		stats.drawEventNSecs.compare_exchange_strong(expected, stats.frameEventNSecs, std::memory_order_release);
+		stats.frameEventNSecs = 0;
+	}
+	return true;
+}
+
+void onPresent()
+{
+	auto now = IG::Time::now().nSecs();
+	for(auto &stats : devStats)
+	{
+		auto eventNSecs = stats.drawEventNSecs.exchange(0, std::memory_order_acquire);
+		if(!eventNSecs)
+			continue;
+		auto latency = now - eventNSecs;
+		uint bucketIdx = std::min(latency / (BUCKET_MSECS * NSEC_PER_MSEC), (uint64_t)BUCKETS - 1);
+		stats.bucket[bucketIdx].fetch_add(1, std::memory_order_relaxed);
+		stats.presentTotalNSecs.fetch_add(latency, std::memory_order_relaxed);
+		// only one thread presents at a time so min/max don't need a CAS loop
+		if(!stats.presentSamples.load(std::memory_order_relaxed) || latency < stats.presentMinNSecs.load(std::memory_order_relaxed))
+			stats.presentMinNSecs.store(latency, std::memory_order_relaxed);
+		if(latency > stats.presentMaxNSecs.load(std::memory_order_relaxed))
+			stats.presentMaxNSecs.store(latency, std::memory_order_relaxed);
+		stats.presentSamples.fetch_add(1, std::memory_order_release);
+	}
+}
+
+static double avgMSecs(uint64_t totalNSecs, uint samples)
+{
+	return samples ? (double)totalNSecs / samples / NSEC_PER_MSEC : 0.;
+}
+
+void report(const char *path)
+{
+	if(!devices)
+		return;
+	FILE *f = path ? fopen(path, "wb") : nullptr;
+	if(path && !f)
+	{
+		logErr("error creating %s", path);
+	}
+	char line[256];
+	auto writeLine =
+		[&]()
+		{
+			logMsg("%s", line);
+			if(f)
+				fprintf(f, "%s\n", line);
+		};
+	iterateTimes(devices, i)
+	{
+		auto &stats = devStats[i];
+		uint samples = stats.presentSamples.load(std::memory_order_acquire);
+		snprintf(line, sizeof(line), "%s: %u presses, avg %.2fms to core, %.2fms to frame end, %.2fms to present (min %.2fms, max %.2fms)",
+			stats.name.data(), samples,
+			avgMSecs(stats.handledTotalNSecs, stats.handledSamples),
+			avgMSecs(stats.frameTotalNSecs, stats.frameSamples),
+			avgMSecs(stats.presentTotalNSecs.load(std::memory_order_relaxed), samples),
+			(double)stats.presentMinNSecs.load(std::memory_order_relaxed) / NSEC_PER_MSEC,
+			(double)stats.presentMaxNSecs.load(std::memory_order_relaxed) / NSEC_PER_MSEC);
+		writeLine();
+		iterateTimes(BUCKETS, b)
+		{
+			uint count = stats.bucket[b].load(std::memory_order_relaxed);
+			if(!count)
+				continue;
+			if(b == BUCKETS - 1)
+				snprintf(line, sizeof(line), "  >=%3ums: %u", b * BUCKET_MSECS, count);
+			else
+				snprintf(line, sizeof(line), "  %3u-%3ums: %u", b * BUCKET_MSECS, (b + 1) * BUCKET_MSECS, count);
+			writeLine();
+		}
+	}
+	if(f)
+	{
+		fclose(f);
+	}
+	// reset for the next session
+	for(auto &stats : devStats)
+	{
+		stats.dev = {};
+		stats.eventNSecs = stats.frameEventNSecs = 0;
+		stats.handledTotalNSecs = stats.frameTotalNSecs = 0;
+		stats.handledSamples = stats.frameSamples = 0;
+		stats.drawEventNSecs.store(0, std::memory_order_relaxed);
+		stats.presentTotalNSecs.store(0, std::memory_order_relaxed);
+		stats.presentMinNSecs.store(0, std::memory_order_relaxed);
+		stats.presentMaxNSecs.store(0, std::memory_order_relaxed);
+		stats.presentSamples.store(0, std::memory_order_relaxed);
+		for(auto &b : stats.bucket)
+			b.store(0, std::memory_order_relaxed);
+	}
+	devices = 0;
+	hasPendingEvents = hasFrameEvents = false;
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/input/Input.hh>
+
+// Tracks the time from a key press event to the presentation of the first
+// emulated frame that ran after it, per input device.
+// Stages: event -> EmuSystem::handleInputAction() -> end of runFrame() -> present
+
+namespace InputLatency
+{
+
+// tracking is off unless enabled, see the -input-latency command line option
+void setEnabled(bool on);
+bool isEnabled();
+// main thread, a key event was passed to the core as an input action
+void onInputAction(Input::Event e);
+// main thread, a frame with video output finished running
+void onFrameFinished();
+// main thread, before requesting a draw of the emulated video,
+// returns true if onPresent() should be called once that draw is presented
+bool prepareDraw();
+// any thread, after presenting a draw prepareDraw() returned true for
+void onPresent();
+// main thread, log the collected statistics, write them to path if not null, and clear them
+void report(const char *path);
+
+}
@@ -20,6 +20,7 @@
 #include <imagine/gui/TextEntry.hh>
 #include <algorithm>
 #include "private.hh"
+#include "CpuVideoFilter.hh"
 
 using namespace IG;
 
@@ -199,6 +200,13 @@ static void setImgEffect(uint val)
 }
 #endif
 
+static void setCpuFilter(uint val)
+{
+	optionCpuVideoFilter = val;
+	emuVideo.setCpuFilter(val);
+	emuWin->win.postDraw();
+}
+
 static void setOverlayEffect(uint val)
 {
 	optionOverlayEffect = val;
@@ -430,6 +438,7 @@ void VideoOptionView::loadStockItems()
 	#ifdef CONFIG_GFX_OPENGL_SHADER_PIPELINE
 	item.emplace_back(&imgEffect);
 	#endif
+	item.emplace_back(&cpuFilter);
 	item.emplace_back(&overlayEffect);
 	item.emplace_back(&overlayEffectLevel);
 	item.emplace_back(&screenShapeHeading);
@@ -810,6 +819,32 @@ VideoOptionView::VideoOptionView(ViewAttachParams attach, bool customMenu):
 		imgEffectItem
 	},
 	#endif
+	cpuFilterItem
+	{
+		{"Off", [this]() { setCpuFilter(CpuVideoFilter::OFF); }},
+		{"Scale2x", [this]() { setCpuFilter(CpuVideoFilter::SCALE2X); }},
+		{"Scale3x", [this]() { setCpuFilter(CpuVideoFilter::SCALE3X); }},
+		{"2xSaI", [this]() { setCpuFilter(CpuVideoFilter::SAI2X); }},
+		{"HQ2x (Slow)", [this]() { setCpuFilter(CpuVideoFilter::HQ2X); }},
+		{"HQ3x (Slow)", [this]() { setCpuFilter(CpuVideoFilter::HQ3X); }}
+	},
+	cpuFilter
+	{
+		"CPU Image Scaler",
+		[]()
+		{
+			switch(optionCpuVideoFilter)
+			{
+				default: return 0;
+				case CpuVideoFilter::SCALE2X: return 1;
+				case CpuVideoFilter::SCALE3X: return 2;
+				case CpuVideoFilter::SAI2X: return 3;
+				case CpuVideoFilter::HQ2X: return 4;
+				case CpuVideoFilter::HQ3X: return 5;
+			}
+		}(),
+		cpuFilterItem
+	},
 	overlayEffectItem
 	{
 		{"Off", [this]() { setOverlayEffect(0); }},
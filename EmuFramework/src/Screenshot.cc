@@ -197,11 +197,11 @@ bool writeScreenshot(const IG::Pixmap &vidPix, const char *fname)
 
 #endif
 
-int sprintScreenshotFilename(FS::PathString &str)
+int sprintScreenshotFilename(FS::PathString &str, uint startNum)
 {
 	const uint maxNum = 999;
 	int num = -1;
-	iterateTimes(maxNum, i)
+	for(uint i = startNum; i < maxNum; i++)
 	{
 		string_printf(str, "%s/%s.%.3d.png", EmuSystem::savePath(), EmuSystem::gameName().data(), i);
 		if(!FS::exists(str))
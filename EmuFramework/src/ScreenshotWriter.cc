@@ -0,0 +1,125 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "ScreenshotWriter"
+#include "ScreenshotWriter.hh"
+#include <emuframework/Screenshot.hh>
+#include <imagine/logger/logger.h>
+#include "private.hh"
+
+ScreenshotWriter::~ScreenshotWriter()
+{
+	if(!encoderThread)
+		return;
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		quitThread = true;
+		cond.notify_one();
+	}
+	// any queued screenshots are still written before the thread exits
+	encoderThread->join();
+}
+
+void ScreenshotWriter::start()
+{
+	completionPipe.emplace();
+	completionPipe->addToEventLoop({},
+		[this](Base::Pipe &pipe)
+		{
+			while(pipe.hasData())
+			{
+				auto msg = pipe.readNoErr<CompletionMessage>();
+				assumeExpr(pendingJobs);
+				pendingJobs--;
+				if(!msg.success)
+				{
+					popup.printf(2, 1, "Error writing screenshot #%d", msg.num);
+				}
+				else
+				{
+					popup.printf(2, 0, "Wrote screenshot #%d", msg.num);
+				}
+			}
+			return 1;
+		});
+	encoderThread.emplace([this](){ runEncoder(); });
+}
+
+ScreenshotWriter::Result ScreenshotWriter::write(const IG::Pixmap &pix)
+{
+	uint idx = BUFFERS;
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		iterateTimes(BUFFERS, i)
+		{
+			if(!bufferInUse[i])
+			{
+				idx = i;
+				break;
+			}
+		}
+	}
+	if(idx == BUFFERS)
+	{
+		logMsg("all buffers in use, skipping screenshot");
+		return Result::POOL_FULL;
+	}
+	Job job{};
+	// names of queued screenshots aren't on disk yet, so continue past
+	// the last one handed out until the queue drains
+	if(!pendingJobs)
+		nextNum = 0;
+	job.num = sprintScreenshotFilename(job.path, nextNum);
+	if(job.num == -1)
+	{
+		return Result::NO_FILENAMES_LEFT;
+	}
+	nextNum = job.num + 1;
+	job.buffer = idx;
+	// the encoder thread only touches a buffer after it's queued
+	if((IG::PixmapDesc)buffer[idx] != (IG::PixmapDesc)pix)
+	{
+		buffer[idx] = IG::MemPixmap{(IG::PixmapDesc)pix};
+	}
+	buffer[idx].write(pix);
+	if(!encoderThread)
+	{
+		start();
+	}
+	pendingJobs++;
+	std::lock_guard<std::mutex> lock{mutex};
+	bufferInUse[idx] = true;
+	jobs.emplace_back(job);
+	cond.notify_one();
+	return Result::QUEUED;
+}
+
+void ScreenshotWriter::runEncoder()
+{
+	std::unique_lock<std::mutex> lock{mutex};
+	while(true)
+	{
+		cond.wait(lock, [this](){ return quitThread || jobs.size(); });
+		if(jobs.empty())
+			return;
+		auto job = jobs.front();
+		jobs.pop_front();
+		lock.unlock();
+		bool success = writeScreenshot(buffer[job.buffer], job.path.data());
+		completionPipe->write(CompletionMessage{job.num, success});
+		lock.lock();
+		bufferInUse[job.buffer] = false;
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/pixmap/Pixmap.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/base/Pipe.hh>
+#include <imagine/thread/Thread.hh>
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+// Encodes screenshots on a worker thread so PNG compression and file I/O
+// don't stall the emulated frame. Frames are copied into a small pool of
+// buffers and the result of each write is posted back to the main thread.
+
+class ScreenshotWriter
+{
+public:
+	enum class Result
+	{
+		QUEUED,
+		POOL_FULL,
+		NO_FILENAMES_LEFT
+	};
+
+	ScreenshotWriter() {}
+	~ScreenshotWriter();
+	// copies pix and queues it to be written, call from the main thread
+	Result write(const IG::Pixmap &pix);
+
+private:
+	static constexpr uint BUFFERS = 3;
+
+	struct Job
+	{
+		FS::PathString path{};
+		int num = 0;
+		uint buffer = 0;
+	};
+
+	struct CompletionMessage
+	{
+		int num;
+		bool success;
+	};
+
+	std::array<IG::MemPixmap, BUFFERS> buffer{};
+	std::array<bool, BUFFERS> bufferInUse{};
+	std::deque<Job> jobs{};
+	std::optional<IG::thread> encoderThread{};
+	std::optional<Base::Pipe> completionPipe{};
+	std::mutex mutex{};
+	std::condition_variable cond{};
+	uint pendingJobs = 0; // only accessed on the main thread
+	uint nextNum = 0;
+	bool quitThread = false;
+
+	void start();
+	void runEncoder();
+};
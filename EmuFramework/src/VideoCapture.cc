@@ -0,0 +1,490 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "VideoCapture"
+#include "VideoCapture.hh"
+#include <emuframework/EmuSystem.hh>
+#include <emuframework/EmuVideo.hh>
+#include <imagine/logger/logger.h>
+#include <imagine/fs/FS.hh>
+#include <imagine/thread/Thread.hh>
+#include <imagine/util/ringbuffer/sys.hh>
+#include <zlib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "private.hh"
+
+namespace VideoCapture
+{
+
+static constexpr uint FRAME_SLOTS = 8;
+static constexpr uint KEY_FRAME_INTERVAL = 600;
+// the worker sleeps this long when both queues are empty, the emulation
+// thread never signals it so queueing a frame stays a plain copy
+static constexpr auto IDLE_POLL_TIME = std::chrono::milliseconds{4};
+// slots are never resized once capture starts, this headroom lets cores
+// switch to a larger mode (hi-res, interlaced) without dropping frames
+static constexpr size_t MIN_SLOT_BYTES = 1024 * 1024;
+
+enum RecordType : uint8
+{
+	RECORD_KEY,
+	RECORD_DELTA,
+	RECORD_REPEAT
+};
+
+struct FrameSlot
+{
+	IG::PixmapDesc desc{};
+	std::unique_ptr<char[]> data{};
+	size_t capacity = 0;
+	uint droppedBefore = 0;
+
+	void reserve(size_t bytes)
+	{
+		if(capacity >= bytes)
+			return;
+		data = std::make_unique<char[]>(bytes);
+		capacity = bytes;
+	}
+};
+
+class Encoder
+{
+public:
+	uint frames = 0;
+	uint repeats = 0;
+
+	Encoder(Format format, FILE *file, double fps):
+		format{format}, file{file}, fps{fps}
+	{
+		if(format == Format::DELTA)
+		{
+			fwrite("EMUVCAP1", 1, 8, file);
+			writeLE(std::lround(fps * 1000.), 4);
+		}
+	}
+
+	void writeFrame(const FrameSlot &slot)
+	{
+		auto bytes = slot.desc.pixelBytes();
+		if(prevDesc == slot.desc && !memcmp(prevFrame.data(), slot.data.get(), bytes))
+		{
+			repeatFrame();
+			return;
+		}
+		if(format == Format::Y4M)
+			writeY4MFrame(slot);
+		else
+			writeDeltaFrame(slot);
+	}
+
+	void repeatFrame()
+	{
+		if(!frames)
+			return;
+		if(format == Format::Y4M)
+		{
+			fwrite("FRAME\n", 1, 6, file);
+			fwrite(yuvFrame.data(), 1, yuvFrame.size(), file);
+		}
+		else
+		{
+			fputc(RECORD_REPEAT, file);
+		}
+		frames++;
+		repeats++;
+	}
+
+private:
+	Format format;
+	FILE *file;
+	double fps;
+	IG::PixmapDesc prevDesc{};
+	std::vector<char> prevFrame{};
+	std::vector<uint8> yuvFrame{};
+	std::vector<uint8> deltaFrame{};
+	std::vector<uint8> compressed{};
+	uint framesSinceKey = 0;
+	bool y4mSizeWarned = false;
+	bool y4mFailed = false;
+
+	void writeLE(uint32_t val, uint bytes)
+	{
+		iterateTimes(bytes, i)
+		{
+			fputc((val >> (i * 8)) & 0xFF, file);
+		}
+	}
+
+	void storePrevFrame(const FrameSlot &slot)
+	{
+		prevDesc = slot.desc;
+		prevFrame.assign(slot.data.get(), slot.data.get() + slot.desc.pixelBytes());
+	}
+
+	static bool canConvertToYUV(IG::PixelFormat fmt)
+	{
+		auto desc = fmt.desc();
+		return (fmt.bytesPerPixel() == 2 && !desc.isGrayscale() && desc.rBits)
+			|| ((fmt.bytesPerPixel() == 3 || fmt.bytesPerPixel() == 4) && desc.rBits == 8);
+	}
+
+	static uint scaleTo8Bits(uint val, uint bits)
+	{
+		return (val << (8 - bits)) | (val >> (2 * bits - 8));
+	}
+
+	void convertToYUV(const FrameSlot &slot)
+	{
+		auto fmt = slot.desc.format();
+		auto desc = fmt.desc();
+		uint bpp = fmt.bytesPerPixel();
+		// 8-bit components are read by byte order, alpha first if it's in the high bits
+		uint first = desc.aBits && desc.aShift > desc.rShift ? 1 : 0;
+		uint rOffset = first, gOffset = first + 1, bOffset = first + 2;
+		if(desc.isBGROrder())
+			std::swap(rOffset, bOffset);
+		uint pixels = slot.desc.w() * slot.desc.h();
+		auto yPlane = yuvFrame.data();
+		auto uPlane = yPlane + pixels;
+		auto vPlane = uPlane + pixels;
+		auto src = (const uint8*)slot.data.get();
+		iterateTimes(pixels, i)
+		{
+			int r, g, b;
+			if(bpp == 2)
+			{
+				uint pixel = *(const uint16*)src;
+				r = scaleTo8Bits(desc.r(pixel), desc.rBits);
+				g = scaleTo8Bits(desc.g(pixel), desc.gBits);
+				b = scaleTo8Bits(desc.b(pixel), desc.bBits);
+			}
+			else
+			{
+				r = src[rOffset];
+				g = src[gOffset];
+				b = src[bOffset];
+			}
+			src += bpp;
+			// BT.601 studio range
+			yPlane[i] = ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16;
+			uPlane[i] = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
+			vPlane[i] = ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
+		}
+	}
+
+	void writeY4MFrame(const FrameSlot &slot)
+	{
+		if(y4mFailed)
+			return;
+		if(!frames)
+		{
+			if(!canConvertToYUV(slot.desc.format()))
+			{
+				logErr("can't convert pixel format %s to Y4M", slot.desc.format().name());
+				y4mFailed = true;
+				return;
+			}
+			fprintf(file, "YUV4MPEG2 W%u H%u F%ld:1000 Ip A1:1 C444\n",
+				slot.desc.w(), slot.desc.h(), std::lround(fps * 1000.));
+			yuvFrame.resize(slot.desc.w() * slot.desc.h() * 3);
+		}
+		else if(slot.desc != prevDesc)
+		{
+			// Y4M has a fixed frame format, hold the last frame instead
+			if(!y4mSizeWarned)
+			{
+				logWarn("frame format changed to %ux%u %s, not supported in Y4M",
+					slot.desc.w(), slot.desc.h(), slot.desc.format().name());
+				y4mSizeWarned = true;
+			}
+			repeatFrame();
+			return;
+		}
+		convertToYUV(slot);
+		storePrevFrame(slot);
+		fwrite("FRAME\n", 1, 6, file);
+		fwrite(yuvFrame.data(), 1, yuvFrame.size(), file);
+		frames++;
+	}
+
+	bool compress(const void *data, size_t bytes)
+	{
+		uLongf compressedBytes = compressBound(bytes);
+		compressed.resize(compressedBytes);
+		if(compress2(compressed.data(), &compressedBytes, (const Bytef*)data, bytes, Z_BEST_SPEED) != Z_OK)
+		{
+			logErr("error compressing frame");
+			return false;
+		}
+		compressed.resize(compressedBytes);
+		return true;
+	}
+
+	void writeDeltaFrame(const FrameSlot &slot)
+	{
+		auto bytes = slot.desc.pixelBytes();
+		bool isKeyFrame = slot.desc != prevDesc || framesSinceKey == KEY_FRAME_INTERVAL;
+		if(isKeyFrame)
+		{
+			if(!compress(slot.data.get(), bytes))
+				return;
+			fputc(RECORD_KEY, file);
+			writeLE(slot.desc.w(), 2);
+			writeLE(slot.desc.h(), 2);
+			fputc(slot.desc.format().id(), file);
+			framesSinceKey = 0;
+		}
+		else
+		{
+			// unchanged pixels become runs of zeros
+			deltaFrame.resize(bytes);
+			auto src = (const uint8*)slot.data.get();
+			auto prev = (const uint8*)prevFrame.data();
+			iterateTimes(bytes, i)
+			{
+				deltaFrame[i] = src[i] ^ prev[i];
+			}
+			if(!compress(deltaFrame.data(), bytes))
+				return;
+			fputc(RECORD_DELTA, file);
+		}
+		writeLE(compressed.size(), 4);
+		fwrite(compressed.data(), 1, compressed.size(), file);
+		storePrevFrame(slot);
+		framesSinceKey++;
+		frames++;
+	}
+};
+
+bool isActive_ = false;
+static FrameSlot slot[FRAME_SLOTS]{};
+static std::atomic_uint slotsWritten{};
+static std::atomic_uint slotsRead{};
+static uint droppedFrames = 0;
+static uint totalDroppedFrames = 0;
+static uint droppedAudioBytes = 0;
+static IG::SysRingBuffer audioBuff{};
+static std::optional<Encoder> encoder{};
+static std::optional<IG::thread> workerThread{};
+static std::atomic_bool quitWorker{};
+static FILE *videoFile{};
+static FILE *audioFile{};
+static Audio::PcmFormat pcmFormat{};
+static uint audioDataBytes = 0;
+static FS::PathString pendingPath{};
+static Format pendingFormat{};
+
+static void writeLE(FILE *f, uint32_t val, uint bytes)
+{
+	iterateTimes(bytes, i)
+	{
+		fputc((val >> (i * 8)) & 0xFF, f);
+	}
+}
+
+static void writeWAVHeader()
+{
+	uint bytesPerFrame = pcmFormat.framesToBytes(1);
+	fseek(audioFile, 0, SEEK_SET);
+	fwrite("RIFF", 1, 4, audioFile);
+	writeLE(audioFile, 36 + audioDataBytes, 4);
+	fwrite("WAVEfmt ", 1, 8, audioFile);
+	writeLE(audioFile, 16, 4); // format chunk size
+	writeLE(audioFile, 1, 2); // integer PCM
+	writeLE(audioFile, pcmFormat.channels, 2);
+	writeLE(audioFile, pcmFormat.rate, 4);
+	writeLE(audioFile, pcmFormat.rate * bytesPerFrame, 4);
+	writeLE(audioFile, bytesPerFrame, 2);
+	writeLE(audioFile, pcmFormat.sample.toBits(), 2);
+	fwrite("data", 1, 4, audioFile);
+	writeLE(audioFile, audioDataBytes, 4);
+	fseek(audioFile, 0, SEEK_END);
+}
+
+static bool writeQueuedAudio()
+{
+	auto bytes = audioBuff.size();
+	if(!bytes)
+		return false;
+	fwrite(audioBuff.readAddr(), 1, bytes, audioFile);
+	audioBuff.commitRead(bytes);
+	audioDataBytes += bytes;
+	return true;
+}
+
+static void runWorker()
+{
+	while(true)
+	{
+		// check before draining so everything queued ahead of stop() is written
+		bool quit = quitWorker.load(std::memory_order_acquire);
+		bool didWork = false;
+		auto written = slotsWritten.load(std::memory_order_acquire);
+		for(auto read = slotsRead.load(std::memory_order_relaxed); read != written; read++)
+		{
+			auto &s = slot[read % FRAME_SLOTS];
+			iterateTimes(s.droppedBefore, i)
+			{
+				encoder->repeatFrame();
+			}
+			encoder->writeFrame(s);
+			slotsRead.store(read + 1, std::memory_order_release);
+			didWork = true;
+		}
+		didWork |= writeQueuedAudio();
+		if(quit)
+			return;
+		if(!didWork)
+			std::this_thread::sleep_for(IDLE_POLL_TIME);
+	}
+}
+
+static void closeFiles()
+{
+	if(videoFile)
+	{
+		fclose(videoFile);
+		videoFile = {};
+	}
+	if(audioFile)
+	{
+		fclose(audioFile);
+		audioFile = {};
+	}
+}
+
+bool start(const char *basePath, Format format)
+{
+	if(isActive_)
+		return true;
+	auto videoPath = FS::makePathStringPrintf("%s.%s", basePath, format == Format::Y4M ? "y4m" : "vcap");
+	auto audioPath = FS::makePathStringPrintf("%s.wav", basePath);
+	videoFile = fopen(videoPath.data(), "wb");
+	audioFile = fopen(audioPath.data(), "wb");
+	if(!videoFile || !audioFile)
+	{
+		logErr("error creating capture files for %s", basePath);
+		closeFiles();
+		return false;
+	}
+	pcmFormat = EmuSystem::pcmFormat;
+	audioDataBytes = 0;
+	writeWAVHeader();
+	// a second of audio covers any stall on the worker without dropping samples
+	audioBuff.init(pcmFormat.uSecsToBytes(1000000));
+	// size the slots up front so copying a frame never allocates
+	auto frameBytes = std::max((size_t)emuVideo.image().usedPixmapDesc().pixelBytes(), MIN_SLOT_BYTES);
+	for(auto &s : slot)
+	{
+		s.reserve(frameBytes);
+	}
+	slotsWritten = 0;
+	slotsRead = 0;
+	droppedFrames = totalDroppedFrames = droppedAudioBytes = 0;
+	encoder.emplace(format, videoFile, 1. / EmuSystem::frameTime());
+	quitWorker = false;
+	workerThread.emplace([](){ runWorker(); });
+	isActive_ = true;
+	logMsg("started capture to %s & %s", videoPath.data(), audioPath.data());
+	return true;
+}
+
+void stop()
+{
+	if(!isActive_)
+		return;
+	isActive_ = false;
+	quitWorker.store(true, std::memory_order_release);
+	workerThread->join();
+	workerThread.reset();
+	writeWAVHeader();
+	closeFiles();
+	logMsg("stopped capture after %u frames, %u repeated, %u dropped, %u audio bytes dropped",
+		encoder->frames, encoder->repeats, totalDroppedFrames, droppedAudioBytes);
+	encoder.reset();
+	audioBuff.deinit();
+	for(auto &s : slot)
+	{
+		s = {};
+	}
+}
+
+void startWithNextGame(const char *basePath, Format format)
+{
+	string_copy(pendingPath, basePath);
+	pendingFormat = format;
+}
+
+void startPending()
+{
+	if(!strlen(pendingPath.data()))
+		return;
+	start(pendingPath.data(), pendingFormat);
+	pendingPath = {};
+}
+
+void addVideoFrame(const IG::Pixmap &pix)
+{
+	auto written = slotsWritten.load(std::memory_order_relaxed);
+	if(unlikely(written - slotsRead.load(std::memory_order_acquire) == FRAME_SLOTS))
+	{
+		// the worker repeats the previous frame in its place to keep A/V sync
+		droppedFrames++;
+		totalDroppedFrames++;
+		return;
+	}
+	auto &s = slot[written % FRAME_SLOTS];
+	auto lineBytes = pix.format().pixelBytes(pix.w());
+	size_t bytes = lineBytes * pix.h();
+	if(unlikely(bytes > s.capacity))
+	{
+		// don't allocate on the emulation thread, treat it like a full queue
+		droppedFrames++;
+		totalDroppedFrames++;
+		return;
+	}
+	s.desc = pix;
+	s.droppedBefore = droppedFrames;
+	droppedFrames = 0;
+	if(pix.pitchBytes() == lineBytes)
+	{
+		memcpy(s.data.get(), pix.pixel({}), bytes);
+	}
+	else
+	{
+		iterateTimes(pix.h(), y)
+		{
+			memcpy(&s.data[y * lineBytes], pix.pixel({0, (int)y}), lineBytes);
+		}
+	}
+	slotsWritten.store(written + 1, std::memory_order_release);
+}
+
+void addAudio(const void *samples, uint bytes)
+{
+	droppedAudioBytes += bytes - audioBuff.write(samples, bytes);
+}
+
+}
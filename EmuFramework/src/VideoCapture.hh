@@ -0,0 +1,64 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/pixmap/Pixmap.hh>
+
+// Gameplay capture, the emulation thread copies each finished frame and
+// audio block into single-producer/single-consumer queues and a worker
+// thread encodes them, writing <base path>.wav along with either:
+//
+// Y4M: <base path>.y4m, 4:4:4 BT.601 YUV. Only 16-bit and 8-bit per
+// component RGB formats are converted and the size can't change mid-stream.
+//
+// DELTA: <base path>.vcap, little-endian lossless frame container:
+//   header: "EMUVCAP1", uint32 frame rate * 1000
+//   frame records start with a uint8 type:
+//   0 key: uint16 width, uint16 height, uint8 IG::PixelFormatID,
+//          uint32 size, zlib compressed frame
+//   1 delta: uint32 size, zlib compressed (frame XOR previous frame)
+//   2 repeat: previous frame shown again, nothing follows
+// Frames are stored without pitch padding, key frames are written at the
+// start, on format changes, and periodically for seeking.
+//
+// Identical consecutive frames are detected on the worker thread and cost
+// only a repeat record (DELTA) or a re-write of the converted frame (Y4M).
+// Frames too large for the buffers sized in start() are dropped and
+// replaced by the previous frame, same as when the worker falls behind.
+
+namespace VideoCapture
+{
+
+enum class Format
+{
+	Y4M,
+	DELTA
+};
+
+// call on the main thread with a game running
+bool start(const char *basePath, Format format);
+void stop();
+// starts capture once the next game finishes loading
+void startWithNextGame(const char *basePath, Format format);
+void startPending();
+
+extern bool isActive_;
+
+static bool isActive() { return isActive_; }
+void addVideoFrame(const IG::Pixmap &pix);
+void addAudio(const void *samples, uint bytes);
+
+}
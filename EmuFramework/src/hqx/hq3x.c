@@ -228,13 +228,17 @@ FIN:
 #define PIXEL22_5   Interp5(pOut+BpL+BpL+8, c[6], c[8]);
 #define PIXEL22_C   *((int*)(pOut+BpL+BpL+8)) = c[5];
 
+#ifdef _MSC_VER
 #pragma warning(disable: 4035)
+#endif
+#ifdef _MSC_VER
 #pragma warning(default: 4035)
+#endif
 
-void hq3x_32(void* pSrc, void* pDest, int Xres, int Yres, int BpL)
+void hq3x_32_rows(const void* pSrc, int srcBpL, void* pDest, int BpL, int Xres, int Yres, int startY, int endY)
 {
-    unsigned char* pIn  = (unsigned char*)pSrc;
-    unsigned char* pOut = (unsigned char*)pDest;
+    unsigned char* pIn;
+    unsigned char* pOut = (unsigned char*)pDest + startY*3*BpL;
     int  i, j, k;
     int  prevline, nextline;
     int  w[10];
@@ -251,12 +255,13 @@ void hq3x_32(void* pSrc, void* pDest, int Xres, int Yres, int BpL)
     //   | w7 | w8 | w9 |
     //   +----+----+----+
 
-    for (j=0; j<Yres; j++)
+    for (j=startY; j<endY; j++)
     {
-        char* pOutOrig = pOut;
+        unsigned char* pOutOrig = pOut;
 
-        if (j>0)      prevline = -Xres*2; else prevline = 0;
-        if (j<Yres-1) nextline =  Xres*2; else nextline = 0;
+        pIn = (unsigned char*)pSrc + j*srcBpL;
+        if (j>0)      prevline = -srcBpL; else prevline = 0;
+        if (j<Yres-1) nextline =  srcBpL; else nextline = 0;
 
         for (i=0; i<Xres; i++)
         {
@@ -3928,12 +3933,22 @@ void hq3x_32(void* pSrc, void* pDest, int Xres, int Yres, int BpL)
     }
 }
 
-void hq3x_init(void)
+void hq3x_32(void* pSrc, void* pDest, int Xres, int Yres, int BpL)
+{
+    hq3x_32_rows(pSrc, Xres*2, pDest, BpL, Xres, Yres, 0, Yres);
+}
+
+void hq3x_init(int redLow)
 {
     int i, j, k;
 
     for (i=0; i<65536; i++)
-        LUT16to32[i] = ((i & 0xF800) << 8) + ((i & 0x07E0) << 5) + ((i & 0x001F) << 3);
+    {
+        if (redLow)
+            LUT16to32[i] = ((i & 0xF800) >> 8) + ((i & 0x07E0) << 5) + ((i & 0x001F) << 19);
+        else
+            LUT16to32[i] = ((i & 0xF800) << 8) + ((i & 0x07E0) << 5) + ((i & 0x001F) << 3);
+    }
 
     for (i=0; i<32; i++)
         for (j=0; j<64; j++)
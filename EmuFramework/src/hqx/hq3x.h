@@ -0,0 +1,16 @@
+#ifndef HQ3X_H
+#define HQ3X_H
+
+// Builds the lookup tables. With redLow set, output pixels have red in the
+// low byte (RGBA8888 in memory), otherwise in bits 16-23 like blueMSX's surfaces.
+void hq3x_init(int redLow);
+
+// Scales source rows startY to endY - 1 of an RGB565 frame into 32-bit
+// pixels. Rows past the frame edges repeat the edge row.
+void hq3x_32_rows(const void* pSrc, int srcBpL, void* pDest, int BpL, int Xres, int Yres, int startY, int endY);
+
+// Scales a whole frame with a tightly packed source, as blueMSX's VideoRender calls it
+void hq3x_32(void* pSrc, void* pDest, int Xres, int Yres, int BpL);
+
+#endif
+
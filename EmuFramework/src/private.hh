@@ -72,6 +72,7 @@ extern StaticArrayList<RecentGameInfo, RecentGameInfo::MAX_RECENT> recentGameLis
 static constexpr const char *strftimeFormat = "%x  %r";
 
 void loadConfigFile();
+void setAudioSink(const char *sink);
 void saveConfigFile();
 void addRecentGame(const char *fullPath, const char *name);
 bool isMenuDismissKey(Input::Event e);
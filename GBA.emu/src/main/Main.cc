@@ -108,6 +108,39 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 		return makeFileReadError();
 }
 
+// uncompressed state data is around 750KB, compressed states are usually much
+// smaller but incompressible data can grow slightly so budget for all of it
+static constexpr size_t MAX_STATE_SIZE = 1024 * 1024;
+
+size_t EmuSystem::stateDataSize()
+{
+	return MAX_STATE_SIZE;
+}
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	if(!CPUWriteMemState(gGba, (char*)data, size))
+		return makeError("State buffer too small");
+	// the memory stream header's 2nd word holds the compressed size that follows it
+	int32_t compressedSize;
+	memcpy(&compressedSize, (char*)data + 4, sizeof(compressedSize));
+	dataSize = 8 + compressedSize;
+	return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	// the reader trusts the header's size, make sure it's within the buffer
+	int32_t compressedSize = -1;
+	if(size >= 8)
+		memcpy(&compressedSize, (const char*)data + 4, sizeof(compressedSize));
+	if(compressedSize < 0 || (size_t)compressedSize > size - 8)
+		return makeError("Invalid state data");
+	if(!CPUReadMemState(gGba, (char*)data, size))
+		return makeError("Invalid state data");
+	return {};
+}
+
 void EmuSystem::saveBackupMem()
 {
 	if(gameIsRunning())
@@ -212,6 +245,16 @@ void systemOnWriteDataToSoundBuffer(const u16 * finalWave, int length)
 	EmuSystem::writeSound(finalWave, EmuSystem::pcmFormat.bytesToFrames(length));
 }
 
+u16 *systemOnStartWriteToSoundBuffer(int length)
+{
+	return (u16*)EmuSystem::startSoundWrite(EmuSystem::pcmFormat.bytesToFrames(length));
+}
+
+void systemOnCommitWriteToSoundBuffer(int length)
+{
+	EmuSystem::commitSoundWrite(EmuSystem::pcmFormat.bytesToFrames(length));
+}
+
 void EmuSystem::runFrame(EmuVideo *video, bool renderAudio)
 {
 	CPULoop(gGba, video, renderAudio);
@@ -58,6 +58,8 @@ extern void systemMessage(int, const char *, ...);
 extern void systemSetTitle(const char *);
 extern SoundDriver * systemSoundInit();
 extern void systemOnWriteDataToSoundBuffer(const u16 * finalWave, int length);
+extern u16 *systemOnStartWriteToSoundBuffer(int length);
+extern void systemOnCommitWriteToSoundBuffer(int length);
 extern void systemOnSoundShutdown();
 extern void systemScreenMessage(const char *);
 extern void systemUpdateMotionSensor();
@@ -23,6 +23,7 @@
 #include "GBALink.h"
 #include <imagine/logger/logger.h>
 #include <imagine/io/FileIO.hh>
+#include <imagine/logger/Trace.hh>
 
 #ifdef PROFILING
 #include "prof/prof.h"
@@ -3464,6 +3465,7 @@ void CPULoop(GBASys &gba, EmuVideo *video, bool renderAudio)
             }
             if(ioMem.VCOUNT == 159 && likely(video))
             {
+            	TRACE_ZONE("systemDrawScreen");
             	systemDrawScreen(*video);
             }
             // entering H-Blank
@@ -3486,6 +3488,7 @@ void CPULoop(GBASys &gba, EmuVideo *video, bool renderAudio)
       // mute sound
       soundTicks -= clockTicks;
       if(soundTicks <= 0) {
+        TRACE_ZONE("psoundTickfn");
         psoundTickfn(renderAudio);
         soundTicks += SOUND_CLOCK_TICKS;
       }
@@ -5,6 +5,11 @@
 #include "Globals.h"
 
 #include "../common/Port.h"
+#if defined __SSE2__
+#include <emmintrin.h>
+#elif defined __ARM_NEON || defined __ARM_NEON__
+#include <arm_neon.h>
+#endif
 
 //#define SPRITE_DEBUG
 
@@ -115,6 +120,164 @@ static inline void gfxClearArray(u32 *array)
   }
 }
 
+// Initializes the per-pixel top color/layer arrays to the backdrop before
+// merging layers with gfxMergeLayer
+static inline void gfxInitPriority(u32 *color, u32 *top, u32 backdrop)
+{
+  for(int i = 0; i < 240; i++) {
+    color[i] = backdrop;
+    top[i] = 0x20;
+  }
+}
+
+// Replaces color[x] with line[x] where the layer's priority byte is lower,
+// equivalent to the per-pixel comparisons in the mode renderers
+static inline void gfxMergeLayer(u32 *color, u32 *top, const u32 *line, u32 layer)
+{
+#if defined __SSE2__
+  const __m128i layerV = _mm_set1_epi32(layer);
+  for(int i = 0; i < 240; i += 4) {
+    __m128i c = _mm_loadu_si128((const __m128i*)&color[i]);
+    __m128i l = _mm_loadu_si128((const __m128i*)&line[i]);
+    __m128i t = _mm_loadu_si128((const __m128i*)&top[i]);
+    __m128i m = _mm_cmplt_epi32(_mm_srli_epi32(l, 24), _mm_srli_epi32(c, 24));
+    _mm_storeu_si128((__m128i*)&color[i], _mm_or_si128(_mm_and_si128(m, l), _mm_andnot_si128(m, c)));
+    _mm_storeu_si128((__m128i*)&top[i], _mm_or_si128(_mm_and_si128(m, layerV), _mm_andnot_si128(m, t)));
+  }
+#elif defined __ARM_NEON || defined __ARM_NEON__
+  const uint32x4_t layerV = vdupq_n_u32(layer);
+  for(int i = 0; i < 240; i += 4) {
+    uint32x4_t c = vld1q_u32(&color[i]);
+    uint32x4_t l = vld1q_u32(&line[i]);
+    uint32x4_t m = vcltq_u32(vshrq_n_u32(l, 24), vshrq_n_u32(c, 24));
+    vst1q_u32(&color[i], vbslq_u32(m, l, c));
+    vst1q_u32(&top[i], vbslq_u32(m, layerV, vld1q_u32(&top[i])));
+  }
+#else
+  for(int i = 0; i < 240; i++) {
+    if((u8)(line[i]>>24) < (u8)(color[i]>>24)) {
+      color[i] = line[i];
+      top[i] = layer;
+    }
+  }
+#endif
+}
+
+// Like gfxMergeLayer, but only where the layer's bit is set in the window
+// mask and the layer isn't front[x]. Either array can be null to skip that
+// test, passing the top layers of a previous merge as front finds the
+// second target for blending.
+static inline void gfxMergeLayerMasked(u32 *color, u32 *top, const u32 *line, u32 layer,
+				       const u32 *mask, const u32 *front)
+{
+#if defined __SSE2__
+  const __m128i layerV = _mm_set1_epi32(layer);
+  for(int i = 0; i < 240; i += 4) {
+    __m128i c = _mm_loadu_si128((const __m128i*)&color[i]);
+    __m128i l = _mm_loadu_si128((const __m128i*)&line[i]);
+    __m128i t = _mm_loadu_si128((const __m128i*)&top[i]);
+    __m128i m = _mm_cmplt_epi32(_mm_srli_epi32(l, 24), _mm_srli_epi32(c, 24));
+    if(mask)
+      m = _mm_and_si128(m, _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i*)&mask[i]), layerV), layerV));
+    if(front)
+      m = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)&front[i]), layerV), m);
+    _mm_storeu_si128((__m128i*)&color[i], _mm_or_si128(_mm_and_si128(m, l), _mm_andnot_si128(m, c)));
+    _mm_storeu_si128((__m128i*)&top[i], _mm_or_si128(_mm_and_si128(m, layerV), _mm_andnot_si128(m, t)));
+  }
+#elif defined __ARM_NEON || defined __ARM_NEON__
+  const uint32x4_t layerV = vdupq_n_u32(layer);
+  for(int i = 0; i < 240; i += 4) {
+    uint32x4_t c = vld1q_u32(&color[i]);
+    uint32x4_t l = vld1q_u32(&line[i]);
+    uint32x4_t m = vcltq_u32(vshrq_n_u32(l, 24), vshrq_n_u32(c, 24));
+    if(mask)
+      m = vandq_u32(m, vtstq_u32(vld1q_u32(&mask[i]), layerV));
+    if(front)
+      m = vbicq_u32(m, vceqq_u32(vld1q_u32(&front[i]), layerV));
+    vst1q_u32(&color[i], vbslq_u32(m, l, c));
+    vst1q_u32(&top[i], vbslq_u32(m, layerV, vld1q_u32(&top[i])));
+  }
+#else
+  for(int i = 0; i < 240; i++) {
+    if(mask && !(mask[i] & layer))
+      continue;
+    if(front && front[i] == layer)
+      continue;
+    if((u8)(line[i]>>24) < (u8)(color[i]>>24)) {
+      color[i] = line[i];
+      top[i] = layer;
+    }
+  }
+#endif
+}
+
+// Merges the BG lines selected by layers (0x01-0x08) followed by the OBJ
+// line, in the same order as the per-pixel comparisons in the mode renderers
+static inline void gfxMergeLayers(u32 *color, u32 *top, const GBALCD &lcd, u32 layers,
+				  const u32 *mask = nullptr, const u32 *front = nullptr)
+{
+  const u32 *line[4] = { lcd.line0, lcd.line1, lcd.line2, lcd.line3 };
+  for(int i = 0; i < 4; i++) {
+    if(layers & (1 << i))
+      gfxMergeLayerMasked(color, top, line[i], 1 << i, mask, front);
+  }
+  gfxMergeLayerMasked(color, top, lcd.lineOBJ, 0x10, mask, front);
+}
+
+// Draws a non-mosaic text BG line a tile at a time, decoding each tile row
+// once into an 8 pixel span that's reused while the map entry repeats
+static inline void gfxDrawTextSpans(const u8 *charBase, const u16 *screenBase, u16 control,
+				    int xxx, int sizeX, int tileY, int yshift,
+				    u32 *line, const u16 *palette, u32 prio)
+{
+  u32 span[8];
+  int lastData = -1;
+  for(int x = 0; x < 240;) {
+    u16 data = READ16LE(screenBase + 0x400 * (xxx>>8) + ((xxx & 255)>>3) + yshift);
+    int start = xxx & 7;
+    int count = 8 - start;
+    if(count > 240 - x)
+      count = 240 - x;
+
+    if(data != lastData) {
+      lastData = data;
+      int tile = data & 0x3FF;
+      int row = (data & 0x0800) ? 7 - tileY : tileY;
+      int flipX = (data & 0x0400) ? 7 : 0;
+      if(control & 0x80) {
+        const u8 *src = &charBase[tile * 64 + row * 8];
+        if(!(src[0] | src[1] | src[2] | src[3] | src[4] | src[5] | src[6] | src[7])) {
+          for(int i = 0; i < 8; i++)
+            span[i] = 0x80000000;
+        } else {
+          for(int i = 0; i < 8; i++) {
+            u8 color = src[i ^ flipX];
+            span[i] = color ? (READ16LE(&palette[color]) | prio): 0x80000000;
+          }
+        }
+      } else {
+        const u8 *src = &charBase[(tile<<5) + (row<<2)];
+        if(!(src[0] | src[1] | src[2] | src[3])) {
+          for(int i = 0; i < 8; i++)
+            span[i] = 0x80000000;
+        } else {
+          const u16 *tilePalette = &palette[(data>>8) & 0xF0];
+          for(int i = 0; i < 8; i++) {
+            int tileX = i ^ flipX;
+            u8 color = (tileX & 1) ? (src[tileX>>1] >> 4) : (src[tileX>>1] & 0x0F);
+            span[i] = color ? (READ16LE(&tilePalette[color]) | prio): 0x80000000;
+          }
+        }
+      }
+    }
+
+    for(int i = 0; i < count; i++)
+      line[x + i] = span[start + i];
+    x += count;
+    xxx = (xxx + count) & (sizeX - 1);
+  }
+}
+
 static inline void gfxDrawTextScreen(u8 vram[0x20000], u16 control, u16 hofs, u16 vofs,
 				     u32 *line, const u16 VCOUNT, const u16 MOSAIC, const u16 *palette)
 {
@@ -153,6 +316,10 @@ static inline void gfxDrawTextScreen(u8 vram[0x20000], u16 control, u16 hofs, u1
   }
 
   int yshift = ((yyy>>3)<<5);
+  if(!mosaicOn) {
+    gfxDrawTextSpans(charBase, screenBase, control, xxx, sizeX, yyy & 7, yshift, line, palette, prio);
+    return;
+  }
   if((control) & 0x80) {
     const u16 *screenSource = screenBase + 0x400 * (xxx>>8) + ((xxx & 255)>>3) + yshift;
     for(int x = 0; x < 240; x++) {
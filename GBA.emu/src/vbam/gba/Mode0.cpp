@@ -48,34 +48,17 @@ void mode0RenderLine(MixColorType *lineMix, GBALCD &lcd, const GBAMem::IoMem &io
     backdrop = ((customBackdropColor & 0x7FFF) | 0x30000000);
   }
 
-  for(int x = 0; x < 240; x++) {
-    u32 color = backdrop;
-    u8 top = 0x20;
-
-    if(lcd.line0[x] < color) {
-      color = lcd.line0[x];
-      top = 0x01;
-    }
-
-    if((u8)(lcd.line1[x]>>24) < (u8)(color >> 24)) {
-      color = lcd.line1[x];
-      top = 0x02;
-    }
+  u32 topColor[240], topLayer[240];
+  gfxInitPriority(topColor, topLayer, backdrop);
+  gfxMergeLayer(topColor, topLayer, lcd.line0, 0x01);
+  gfxMergeLayer(topColor, topLayer, lcd.line1, 0x02);
+  gfxMergeLayer(topColor, topLayer, lcd.line2, 0x04);
+  gfxMergeLayer(topColor, topLayer, lcd.line3, 0x08);
+  gfxMergeLayer(topColor, topLayer, lcd.lineOBJ, 0x10);
 
-    if((u8)(lcd.line2[x]>>24) < (u8)(color >> 24)) {
-      color = lcd.line2[x];
-      top = 0x04;
-    }
-
-    if((u8)(lcd.line3[x]>>24) < (u8)(color >> 24)) {
-      color = lcd.line3[x];
-      top = 0x08;
-    }
-
-    if((u8)(lcd.lineOBJ[x]>>24) < (u8)(color >> 24)) {
-      color = lcd.lineOBJ[x];
-      top = 0x10;
-    }
+  for(int x = 0; x < 240; x++) {
+    u32 color = topColor[x];
+    u8 top = topLayer[x];
 
     if((top & 0x10) && (color & 0x00010000)) {
       // semi-transparent OBJ
@@ -170,88 +153,26 @@ void mode0RenderLineNoWindow(MixColorType *lineMix, GBALCD &lcd, const GBAMem::I
     backdrop = ((customBackdropColor & 0x7FFF) | 0x30000000);
   }
 
-  int effect = (BLDMOD >> 6) & 3;
+  u32 topColor[240], topLayer[240], backColor[240], backLayer[240];
+  gfxInitPriority(topColor, topLayer, backdrop);
+  gfxMergeLayers(topColor, topLayer, lcd, 0x0F);
+  // second blend targets, skipping each pixel's top layer
+  gfxInitPriority(backColor, backLayer, backdrop);
+  gfxMergeLayers(backColor, backLayer, lcd, 0x0F, nullptr, topLayer);
 
   for(int x = 0; x < 240; x++) {
-    u32 color = backdrop;
-    u8 top = 0x20;
-
-    if(lcd.line0[x] < color) {
-      color = lcd.line0[x];
-      top = 0x01;
-    }
-
-    if(lcd.line1[x] < (color & 0xFF000000)) {
-      color = lcd.line1[x];
-      top = 0x02;
-    }
-
-    if(lcd.line2[x] < (color & 0xFF000000)) {
-      color = lcd.line2[x];
-      top = 0x04;
-    }
-
-    if(lcd.line3[x] < (color & 0xFF000000)) {
-      color = lcd.line3[x];
-      top = 0x08;
-    }
-
-    if(lcd.lineOBJ[x] < (color & 0xFF000000)) {
-      color = lcd.lineOBJ[x];
-      top = 0x10;
-    }
+    u32 color = topColor[x];
+    u8 top = topLayer[x];
 
     if(!(color & 0x00010000)) {
-      switch(effect) {
+      switch((BLDMOD >> 6) & 3) {
       case 0:
         break;
       case 1:
-        {
-          if(top & BLDMOD) {
-            u32 back = backdrop;
-            u8 top2 = 0x20;
-            if(lcd.line0[x] < back) {
-              if(top != 0x01) {
-                back = lcd.line0[x];
-                top2 = 0x01;
-              }
-            }
-
-            if(lcd.line1[x] < (back & 0xFF000000)) {
-              if(top != 0x02) {
-                back = lcd.line1[x];
-                top2 = 0x02;
-              }
-            }
-
-            if(lcd.line2[x] < (back & 0xFF000000)) {
-              if(top != 0x04) {
-                back = lcd.line2[x];
-                top2 = 0x04;
-              }
-            }
-
-            if(lcd.line3[x] < (back & 0xFF000000)) {
-              if(top != 0x08) {
-                back = lcd.line3[x];
-                top2 = 0x08;
-              }
-            }
-
-            if(lcd.lineOBJ[x] < (back & 0xFF000000)) {
-              if(top != 0x10) {
-                back = lcd.lineOBJ[x];
-                top2 = 0x10;
-              }
-            }
-
-            if(top2 & (BLDMOD>>8))
-              color = gfxAlphaBlend(color, back,
-                                    coeff[COLEV & 0x1F],
-                                    coeff[(COLEV >> 8) & 0x1F]);
-
-          }
-        }
+        if((top & BLDMOD) && (backLayer[x] & (BLDMOD>>8)))
+          color = gfxAlphaBlend(color, backColor[x],
+                                coeff[COLEV & 0x1F],
+                                coeff[(COLEV >> 8) & 0x1F]);
         break;
       case 2:
         if(BLDMOD & top)
@@ -264,31 +185,8 @@ void mode0RenderLineNoWindow(MixColorType *lineMix, GBALCD &lcd, const GBAMem::I
       }
     } else {
       // semi-transparent OBJ
-      u32 back = backdrop;
-      u8 top2 = 0x20;
-
-      if(lcd.line0[x] < back) {
-        back = lcd.line0[x];
-        top2 = 0x01;
-      }
-
-      if(lcd.line1[x] < (back & 0xFF000000)) {
-        back = lcd.line1[x];
-        top2 = 0x02;
-      }
-
-      if(lcd.line2[x] < (back & 0xFF000000)) {
-        back = lcd.line2[x];
-        top2 = 0x04;
-      }
-
-      if(lcd.line3[x] < (back & 0xFF000000)) {
-        back = lcd.line3[x];
-        top2 = 0x08;
-      }
-
-      if(top2 & (BLDMOD>>8))
-        color = gfxAlphaBlend(color, back,
+      if(backLayer[x] & (BLDMOD>>8))
+        color = gfxAlphaBlend(color, backColor[x],
                               coeff[COLEV & 0x1F],
                               coeff[(COLEV >> 8) & 0x1F]);
       else {
@@ -386,9 +284,8 @@ void mode0RenderLineAll(MixColorType *lineMix, GBALCD &lcd, const GBAMem::IoMem
   u8 inWin1Mask = WININ >> 8;
   u8 outMask = WINOUT & 0xFF;
 
+  u32 winMask[240];
   for(int x = 0; x < 240; x++) {
-    u32 color = backdrop;
-    u8 top = 0x20;
     u8 mask = outMask;
 
     if(!(lcd.lineOBJWin[x] & 0x80000000)) {
@@ -406,58 +303,24 @@ void mode0RenderLineAll(MixColorType *lineMix, GBALCD &lcd, const GBAMem::IoMem
       }
     }
 
-    if((mask & 1) && (lcd.line0[x] < color)) {
-      color = lcd.line0[x];
-      top = 0x01;
-    }
-
-    if((mask & 2) && ((u8)(lcd.line1[x]>>24) < (u8)(color >> 24))) {
-      color = lcd.line1[x];
-      top = 0x02;
-    }
-
-    if((mask & 4) && ((u8)(lcd.line2[x]>>24) < (u8)(color >> 24))) {
-      color = lcd.line2[x];
-      top = 0x04;
-    }
+    winMask[x] = mask;
+  }
 
-    if((mask & 8) && ((u8)(lcd.line3[x]>>24) < (u8)(color >> 24))) {
-      color = lcd.line3[x];
-      top = 0x08;
-    }
+  u32 topColor[240], topLayer[240], backColor[240], backLayer[240];
+  gfxInitPriority(topColor, topLayer, backdrop);
+  gfxMergeLayers(topColor, topLayer, lcd, 0x0F, winMask);
+  // second blend targets, skipping each pixel's top layer
+  gfxInitPriority(backColor, backLayer, backdrop);
+  gfxMergeLayers(backColor, backLayer, lcd, 0x0F, winMask, topLayer);
 
-    if((mask & 16) && ((u8)(lcd.lineOBJ[x]>>24) < (u8)(color >> 24))) {
-      color = lcd.lineOBJ[x];
-      top = 0x10;
-    }
+  for(int x = 0; x < 240; x++) {
+    u32 color = topColor[x];
+    u8 top = topLayer[x];
 
     if(color & 0x00010000) {
       // semi-transparent OBJ
-      u32 back = backdrop;
-      u8 top2 = 0x20;
-
-      if((mask & 1) && ((u8)(lcd.line0[x]>>24) < (u8)(back >> 24))) {
-        back = lcd.line0[x];
-        top2 = 0x01;
-      }
-
-      if((mask & 2) && ((u8)(lcd.line1[x]>>24) < (u8)(back >> 24))) {
-        back = lcd.line1[x];
-        top2 = 0x02;
-      }
-
-      if((mask & 4) && ((u8)(lcd.line2[x]>>24) < (u8)(back >> 24))) {
-        back = lcd.line2[x];
-        top2 = 0x04;
-      }
-
-      if((mask & 8) && ((u8)(lcd.line3[x]>>24) < (u8)(back >> 24))) {
-        back = lcd.line3[x];
-        top2 = 0x08;
-      }
-
-      if(top2 & (BLDMOD>>8))
-        color = gfxAlphaBlend(color, back,
+      if(backLayer[x] & (BLDMOD>>8))
+        color = gfxAlphaBlend(color, backColor[x],
                               coeff[COLEV & 0x1F],
                               coeff[(COLEV >> 8) & 0x1F]);
       else {
@@ -472,57 +335,16 @@ void mode0RenderLineAll(MixColorType *lineMix, GBALCD &lcd, const GBAMem::IoMem
           break;
         }
       }
-    } else if(mask & 32) {
+    } else if(winMask[x] & 32) {
       // special FX on in the window
       switch((BLDMOD >> 6) & 3) {
       case 0:
         break;
       case 1:
-        {
-          if(top & BLDMOD) {
-            u32 back = backdrop;
-            u8 top2 = 0x20;
-            if((mask & 1) && (u8)(lcd.line0[x]>>24) < (u8)(back >> 24)) {
-              if(top != 0x01) {
-                back = lcd.line0[x];
-                top2 = 0x01;
-              }
-            }
-
-            if((mask & 2) && (u8)(lcd.line1[x]>>24) < (u8)(back >> 24)) {
-              if(top != 0x02) {
-                back = lcd.line1[x];
-                top2 = 0x02;
-              }
-            }
-
-            if((mask & 4) && (u8)(lcd.line2[x]>>24) < (u8)(back >> 24)) {
-              if(top != 0x04) {
-                back = lcd.line2[x];
-                top2 = 0x04;
-              }
-            }
-
-            if((mask & 8) && (u8)(lcd.line3[x]>>24) < (u8)(back >> 24)) {
-              if(top != 0x08) {
-                back = lcd.line3[x];
-                top2 = 0x08;
-              }
-            }
-
-            if((mask & 16) && (u8)(lcd.lineOBJ[x]>>24) < (u8)(back >> 24)) {
-              if(top != 0x10) {
-                back = lcd.lineOBJ[x];
-                top2 = 0x10;
-              }
-            }
-
-            if(top2 & (BLDMOD>>8))
-              color = gfxAlphaBlend(color, back,
-                                    coeff[COLEV & 0x1F],
-                                    coeff[(COLEV >> 8) & 0x1F]);
-          }
-        }
+        if((top & BLDMOD) && (backLayer[x] & (BLDMOD>>8)))
+          color = gfxAlphaBlend(color, backColor[x],
+                                coeff[COLEV & 0x1F],
+                                coeff[(COLEV >> 8) & 0x1F]);
         break;
       case 2:
         if(BLDMOD & top)
@@ -38,19 +38,13 @@ void mode4RenderLine(MixColorType *lineMix, GBALCD &lcd, const GBAMem::IoMem &io
     backdrop = ((customBackdropColor & 0x7FFF) | 0x30000000);
   }
 
-  for(int x = 0; x < 240; x++) {
-    u32 color = backdrop;
-    u8 top = 0x20;
-
-    if(lcd.line2[x] < color) {
-      color = lcd.line2[x];
-      top = 0x04;
-    }
+  u32 topColor[240], topLayer[240];
+  gfxInitPriority(topColor, topLayer, backdrop);
+  gfxMergeLayers(topColor, topLayer, lcd, 0x04);
 
-    if((u8)(lcd.lineOBJ[x]>>24) < (u8)(color >> 24)) {
-      color = lcd.lineOBJ[x];
-      top = 0x10;
-    }
+  for(int x = 0; x < 240; x++) {
+    u32 color = topColor[x];
+    u8 top = topLayer[x];
 
     if((top & 0x10) && (color & 0x00010000)) {
       // semi-transparent OBJ
@@ -122,51 +116,26 @@ void mode4RenderLineNoWindow(MixColorType *lineMix, GBALCD &lcd, const GBAMem::I
     backdrop = ((customBackdropColor & 0x7FFF) | 0x30000000);
   }
 
-  for(int x = 0; x < 240; x++) {
-    u32 color = backdrop;
-    u8 top = 0x20;
-
-    if(lcd.line2[x] < color) {
-      color = lcd.line2[x];
-      top = 0x04;
-    }
+  u32 topColor[240], topLayer[240], backColor[240], backLayer[240];
+  gfxInitPriority(topColor, topLayer, backdrop);
+  gfxMergeLayers(topColor, topLayer, lcd, 0x04);
+  // second blend targets, skipping each pixel's top layer
+  gfxInitPriority(backColor, backLayer, backdrop);
+  gfxMergeLayers(backColor, backLayer, lcd, 0x04, nullptr, topLayer);
 
-    if((u8)(lcd.lineOBJ[x]>>24) < (u8)(color >> 24)) {
-      color = lcd.lineOBJ[x];
-      top = 0x10;
-    }
+  for(int x = 0; x < 240; x++) {
+    u32 color = topColor[x];
+    u8 top = topLayer[x];
 
     if(!(color & 0x00010000)) {
       switch((BLDMOD >> 6) & 3) {
       case 0:
         break;
       case 1:
-        {
-          if(top & BLDMOD) {
-            u32 back = backdrop;
-            u8 top2 = 0x20;
-
-            if(lcd.line2[x] < back) {
-              if(top != 0x04) {
-                back = lcd.line2[x];
-                top2 = 0x04;
-              }
-            }
-
-            if((u8)(lcd.lineOBJ[x]>>24) < (u8)(back >> 24)) {
-              if(top != 0x10) {
-                back = lcd.lineOBJ[x];
-                top2 = 0x10;
-              }
-            }
-
-            if(top2 & (BLDMOD>>8))
-              color = gfxAlphaBlend(color, back,
-                                    coeff[COLEV & 0x1F],
-                                    coeff[(COLEV >> 8) & 0x1F]);
-
-          }
-        }
+        if((top & BLDMOD) && (backLayer[x] & (BLDMOD>>8)))
+          color = gfxAlphaBlend(color, backColor[x],
+                                coeff[COLEV & 0x1F],
+                                coeff[(COLEV >> 8) & 0x1F]);
         break;
       case 2:
         if(BLDMOD & top)
@@ -179,16 +148,8 @@ void mode4RenderLineNoWindow(MixColorType *lineMix, GBALCD &lcd, const GBAMem::I
       }
     } else {
       // semi-transparent OBJ
-      u32 back = backdrop;
-      u8 top2 = 0x20;
-
-      if(lcd.line2[x] < back) {
-        back = lcd.line2[x];
-        top2 = 0x04;
-      }
-
-      if(top2 & (BLDMOD>>8))
-        color = gfxAlphaBlend(color, back,
+      if(backLayer[x] & (BLDMOD>>8))
+        color = gfxAlphaBlend(color, backColor[x],
                               coeff[COLEV & 0x1F],
                               coeff[(COLEV >> 8) & 0x1F]);
       else {
@@ -278,9 +239,8 @@ void mode4RenderLineAll(MixColorType *lineMix, GBALCD &lcd, const GBAMem::IoMem
   u8 inWin1Mask = WININ >> 8;
   u8 outMask = WINOUT & 0xFF;
 
+  u32 winMask[240];
   for(int x = 0; x < 240; x++) {
-    u32 color = backdrop;
-    u8 top = 0x20;
     u8 mask = outMask;
 
     if(!(lcd.lineOBJWin[x] & 0x80000000)) {
@@ -298,28 +258,24 @@ void mode4RenderLineAll(MixColorType *lineMix, GBALCD &lcd, const GBAMem::IoMem
       }
     }
 
-    if((mask & 4) && (lcd.line2[x] < color)) {
-      color = lcd.line2[x];
-      top = 0x04;
-    }
+    winMask[x] = mask;
+  }
 
-    if((mask & 16) && ((u8)(lcd.lineOBJ[x]>>24) < (u8)(color >>24))) {
-      color = lcd.lineOBJ[x];
-      top = 0x10;
-    }
+  u32 topColor[240], topLayer[240], backColor[240], backLayer[240];
+  gfxInitPriority(topColor, topLayer, backdrop);
+  gfxMergeLayers(topColor, topLayer, lcd, 0x04, winMask);
+  // second blend targets, skipping each pixel's top layer
+  gfxInitPriority(backColor, backLayer, backdrop);
+  gfxMergeLayers(backColor, backLayer, lcd, 0x04, winMask, topLayer);
+
+  for(int x = 0; x < 240; x++) {
+    u32 color = topColor[x];
+    u8 top = topLayer[x];
 
     if(color & 0x00010000) {
       // semi-transparent OBJ
-      u32 back = backdrop;
-      u8 top2 = 0x20;
-
-      if((mask & 4) && lcd.line2[x] < back) {
-        back = lcd.line2[x];
-        top2 = 0x04;
-      }
-
-      if(top2 & (BLDMOD>>8))
-        color = gfxAlphaBlend(color, back,
+      if(backLayer[x] & (BLDMOD>>8))
+        color = gfxAlphaBlend(color, backColor[x],
                               coeff[COLEV & 0x1F],
                               coeff[(COLEV >> 8) & 0x1F]);
       else {
@@ -334,37 +290,16 @@ void mode4RenderLineAll(MixColorType *lineMix, GBALCD &lcd, const GBAMem::IoMem
           break;
         }
       }
-    } else if(mask & 32) {
+    } else if(winMask[x] & 32) {
+      // special FX on in the window
       switch((BLDMOD >> 6) & 3) {
       case 0:
         break;
       case 1:
-        {
-          if(top & BLDMOD) {
-            u32 back = backdrop;
-            u8 top2 = 0x20;
-
-            if((mask & 4) && lcd.line2[x] < back) {
-              if(top != 0x04) {
-                back = lcd.line2[x];
-                top2 = 0x04;
-              }
-            }
-
-            if((mask & 16) && (u8)(lcd.lineOBJ[x]>>24) < (u8)(back >> 24)) {
-              if(top != 0x10) {
-                back = lcd.lineOBJ[x];
-                top2 = 0x10;
-              }
-            }
-
-            if(top2 & (BLDMOD>>8))
-              color = gfxAlphaBlend(color, back,
-                                    coeff[COLEV & 0x1F],
-                                    coeff[(COLEV >> 8) & 0x1F]);
-
-          }
-        }
+        if((top & BLDMOD) && (backLayer[x] & (BLDMOD>>8)))
+          color = gfxAlphaBlend(color, backColor[x],
+                                coeff[COLEV & 0x1F],
+                                coeff[(COLEV >> 8) & 0x1F]);
         break;
       case 2:
         if(BLDMOD & top)
@@ -373,6 +373,16 @@ void flush_samples(Multi_Buffer * buffer, bool renderAudio)
 {
 	// Write one video frame worth of audio
 	uint samples = buffer->samples_avail();
+	if(likely(renderAudio))
+	{
+		// mix straight into the frontend's audio buffer when there's room
+		if(auto out = systemOnStartWriteToSoundBuffer(samples*2))
+		{
+			samples = buffer->read_samples( (blip_sample_t*) out, samples );
+			systemOnCommitWriteToSoundBuffer(samples*2);
+			return;
+		}
+	}
 	u16 soundFinalWave[1800];
 	samples = std::min(samples, uint(sizeof soundFinalWave / 2));
 	buffer->read_samples( (blip_sample_t*) soundFinalWave, samples );
@@ -46,6 +46,7 @@ main/EmuControls.cc \
 main/EmuMenuViews.cc \
 main/Cheats.cc \
 main/Palette.cc \
+main/BatchRunner.cc \
 $(addprefix $(libgambattePath)/,$(libgambatteSrc))
 
 gambatteCommonSrc := resample/src/resamplerinfo.cpp \
@@ -24,6 +24,8 @@
 #include "loadres.h"
 #include "file/file.h"
 #include <cstddef>
+#include <ctime>
+#include <iosfwd>
 #include <string>
 #include <imagine/util/DelegateFunc.hh>
 
@@ -40,8 +42,10 @@ public:
 		FORCE_DMG        = 1, /**< Treat the ROM as not having CGB support regardless of
 		                           what its header advertises. */
 		GBA_CGB          = 2, /**< Use GBA intial CPU register values when in CGB mode. */
-		MULTICART_COMPAT = 4  /**< Use heuristics to detect and support some multicart
+		MULTICART_COMPAT = 4, /**< Use heuristics to detect and support some multicart
 		                           MBCs disguised as MBC1. */
+		NO_SAVEDATA      = 8  /**< Don't read or write battery RAM and RTC files in the
+		                           save directory on load and reset. */
 	};
 
 	 /*
@@ -110,6 +114,12 @@ public:
 	  */
 	void setSaveDir(std::string const &sdir);
 
+	/**
+	  * Sets the clock in seconds the cartridge RTC follows instead of the system time.
+	  * Set before load() so the RTC also starts from it.
+	  */
+	void setRtcTimeFunc(DelegateFunc<std::time_t()> timeFunc);
+
 	/** Returns true if the currently loaded ROM image is treated as having CGB support. */
 	bool isCgb() const;
 
@@ -155,6 +165,25 @@ public:
 	  */
 	bool loadState(std::string const &filepath);
 
+	/**
+	  * Saves emulator state to the output stream 'file'.
+	  *
+	  * @param  videoBuf 160x144 RGB32 (native endian) video frame buffer or 0. Used for
+	  *                  saving a thumbnail.
+	  * @param  pitch distance in number of pixels (not bytes) from the start of one line
+	  *               to the next in videoBuf.
+	  * @return success
+	  */
+	bool saveState(gambatte::PixelType const *videoBuf, std::ptrdiff_t pitch,
+	               std::ostream &file);
+
+	/**
+	  * Loads emulator state from the input stream 'file'.
+	  * Unlike loadState(filepath), persistent cartridge data isn't written to disk first.
+	  * @return success
+	  */
+	bool loadState(std::istream &file);
+
 	/**
 	  * Selects which state slot to save state to or load state from.
 	  * There are 10 such slots, numbered from 0 to 9 (periodically extended for all n).
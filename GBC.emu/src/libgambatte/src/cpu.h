@@ -45,6 +45,10 @@ public:
 		mem_.setSaveDir(sdir);
 	}
 
+	void setRtcTimeFunc(DelegateFunc<std::time_t()> timeFunc) {
+		mem_.setRtcTimeFunc(timeFunc);
+	}
+
 	std::string const saveBasePath() const {
 		return mem_.saveBasePath();
 	}
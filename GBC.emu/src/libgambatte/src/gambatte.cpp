@@ -43,6 +43,7 @@ struct GB::Priv {
 	CPU cpu;
 	int stateNo;
 	unsigned loadflags;
+	DelegateFunc<std::time_t()> rtcTimeFunc;
 
 	Priv() : stateNo(1), loadflags(0) {}
 };
@@ -77,13 +78,17 @@ std::ptrdiff_t GB::runFor(gambatte::PixelType *const videoBuf, std::ptrdiff_t co
 
 void GB::reset() {
 	if (p_->cpu.loaded()) {
-		p_->cpu.saveSavedata();
+		if (!(p_->loadflags & NO_SAVEDATA))
+			p_->cpu.saveSavedata();
 
 		SaveState state;
 		p_->cpu.setStatePtrs(state);
 		setInitState(state, p_->cpu.isCgb(), p_->loadflags & GBA_CGB);
+		if (p_->rtcTimeFunc)
+			state.rtc.baseTime = p_->rtcTimeFunc();
 		p_->cpu.loadState(state);
-		p_->cpu.loadSavedata();
+		if (!(p_->loadflags & NO_SAVEDATA))
+			p_->cpu.loadSavedata();
 	}
 }
 
@@ -95,8 +100,13 @@ void GB::setSaveDir(std::string const &sdir) {
 	p_->cpu.setSaveDir(sdir);
 }
 
+void GB::setRtcTimeFunc(DelegateFunc<std::time_t()> timeFunc) {
+	p_->rtcTimeFunc = timeFunc;
+	p_->cpu.setRtcTimeFunc(timeFunc);
+}
+
 LoadRes GB::load(const void *romdata, std::size_t size, std::string const &romfilename, unsigned const flags) {
-	if (p_->cpu.loaded())
+	if (p_->cpu.loaded() && !(p_->loadflags & NO_SAVEDATA))
 		p_->cpu.saveSavedata();
 
 	LoadRes const loadres = p_->cpu.load(romdata, size,
@@ -108,8 +118,11 @@ LoadRes GB::load(const void *romdata, std::size_t size, std::string const &romfi
 		p_->cpu.setStatePtrs(state);
 		p_->loadflags = flags;
 		setInitState(state, p_->cpu.isCgb(), flags & GBA_CGB);
+		if (p_->rtcTimeFunc)
+			state.rtc.baseTime = p_->rtcTimeFunc();
 		p_->cpu.loadState(state);
-		p_->cpu.loadSavedata();
+		if (!(flags & NO_SAVEDATA))
+			p_->cpu.loadSavedata();
 
 		p_->stateNo = 1;
 #ifndef GAMBATTE_NO_OSD
@@ -157,6 +170,20 @@ bool GB::loadState(std::string const &filepath) {
 	return false;
 }
 
+bool GB::loadState(std::istream &file) {
+	if (p_->cpu.loaded()) {
+		SaveState state;
+		p_->cpu.setStatePtrs(state);
+		setInitState(state, p_->cpu.isCgb(), p_->loadflags & GBA_CGB);
+		if (StateSaver::loadState(state, file)) {
+			p_->cpu.loadState(state);
+			return true;
+		}
+	}
+
+	return false;
+}
+
 bool GB::saveState(gambatte::PixelType const *videoBuf, std::ptrdiff_t pitch) {
 	if (saveState(videoBuf, pitch, statePath(p_->cpu.saveBasePath(), p_->stateNo))) {
 #ifndef GAMBATTE_NO_OSD
@@ -191,6 +218,18 @@ bool GB::saveState(gambatte::PixelType const *videoBuf, std::ptrdiff_t pitch,
 	return false;
 }
 
+bool GB::saveState(gambatte::PixelType const *videoBuf, std::ptrdiff_t pitch,
+                   std::ostream &file) {
+	if (p_->cpu.loaded()) {
+		SaveState state;
+		p_->cpu.setStatePtrs(state);
+		p_->cpu.saveState(state);
+		return StateSaver::saveState(state, videoBuf, pitch, file);
+	}
+
+	return false;
+}
+
 void GB::selectState(int n) {
 	n -= (n / 10) * 10;
 	p_->stateNo = n < 0 ? n + 10 : n;
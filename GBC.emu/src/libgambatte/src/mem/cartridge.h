@@ -62,6 +62,7 @@ public:
 	bool isCgb() const { return gambatte::isCgb(memptrs_); }
 	void rtcWrite(unsigned data) { rtc_.write(data); }
 	unsigned char rtcRead() const { return *rtc_.activeData(); }
+	void setRtcTimeFunc(DelegateFunc<std::time_t()> timeFunc) { rtc_.setTimeFunc(timeFunc); }
 	void loadSavedata();
 	void saveSavedata();
 	std::string const saveBasePath() const;
@@ -43,13 +43,14 @@ MemPtrs::~MemPtrs() {
 
 void MemPtrs::reset(unsigned const rombanks, unsigned const rambanks, unsigned const wrambanks) {
 	delete []memchunk_;
+	// zero-filled so cartridge RAM without save data starts the same every load
 	memchunk_ = new unsigned char[
 		  0x4000
 		+ rombanks * 0x4000ul
 		+ 0x4000
 		+ rambanks * 0x2000ul
 		+ wrambanks * 0x1000ul
-		+ 0x4000];
+		+ 0x4000]();
 
 	romdata_[0] = romdata();
 	rambankdata_ = romdata_[0] + rombanks * 0x4000ul + 0x4000;
@@ -20,6 +20,7 @@
 #define RTC_H
 
 #include <ctime>
+#include <imagine/util/DelegateFunc.hh>
 
 namespace gambatte {
 
@@ -31,6 +32,7 @@ public:
 	unsigned char const * activeData() const { return activeData_; }
 	std::time_t baseTime() const { return baseTime_; }
 	void setBaseTime(std::time_t baseTime) { baseTime_ = baseTime; }
+	void setTimeFunc(DelegateFunc<std::time_t()> timeFunc) { timeFunc_ = timeFunc; }
 
 	void latch(unsigned data) {
 		if (!lastLatchData_ && data == 1)
@@ -69,7 +71,9 @@ private:
 	unsigned char dataS_;
 	bool enabled_;
 	bool lastLatchData_;
+	DelegateFunc<std::time_t()> timeFunc_;
 
+	std::time_t now() const { return timeFunc_ ? timeFunc_() : std::time(0); }
 	void doLatch();
 	void doSwapActive();
 	void setDh(unsigned newDh);
@@ -95,6 +95,7 @@ public:
 	unsigned long resetCounters(unsigned long cycleCounter);
 	LoadRes loadROM(const void *romdata, std::size_t size, std::string const &romfilename, bool forceDmg, bool multicartCompat);
 	void setSaveDir(std::string const &dir) { cart_.setSaveDir(dir); }
+	void setRtcTimeFunc(DelegateFunc<std::time_t()> timeFunc) { cart_.setRtcTimeFunc(timeFunc); }
 	void setInputGetter(InputGetter *getInput) { getInput_ = getInput; }
 	void setEndtime(unsigned long cc, unsigned long inc);
 	void setSoundBuffer(uint_least32_t *buf) { psg_.setBuffer(buf); }
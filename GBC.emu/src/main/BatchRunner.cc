@@ -0,0 +1,402 @@
+/*  This file is part of GBC.emu.
+
+	GBC.emu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	GBC.emu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with GBC.emu.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "BatchRunner"
+#include "BatchRunner.hh"
+#include <gambatte.h>
+#include <imagine/io/FileIO.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/thread/Thread.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/logger/logger.h>
+#include <imagine/util/algorithm.h>
+#include <imagine/util/string.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+namespace BatchRunner
+{
+
+static constexpr uint GB_RES_X = 160, GB_RES_Y = 144;
+static constexpr size_t FRAME_SAMPLES = 35112;
+static constexpr uint64_t FRAME_CYCLES = FRAME_SAMPLES * 2, CPU_HZ = 4194304;
+static constexpr size_t RUN_FOR_EXTRA_SAMPLES = 2064; // runFor() may overshoot by this much
+// frames an instance runs before going back to the queue, small enough for
+// idle threads to even out the load, large enough to keep queue traffic low
+static constexpr uint SLICE_FRAMES = 60;
+
+struct Config
+{
+	const char *inputScriptPath{};
+	uint frames = 600;
+	uint repeat = 1;
+	uint threads = 0;
+	std::vector<const char*> romPaths{};
+};
+
+struct InputEvent
+{
+	uint frame;
+	uint buttons;
+};
+
+struct Rom
+{
+	FS::FileString name{};
+	std::vector<char> data{};
+};
+
+class ScriptInputGetter : public gambatte::InputGetter
+{
+public:
+	uint buttons = 0;
+
+	unsigned operator()() final
+	{
+		return buttons;
+	}
+};
+
+class Instance
+{
+public:
+	const Rom &rom;
+	uint frame = 0;
+	gambatte::LoadRes loadRes = gambatte::LOADRES_OK;
+
+	Instance(const Rom &rom, const std::vector<InputEvent> &script):
+		rom{rom}, script{script} {}
+
+	// returns true if frames are left to run after this slice
+	bool runSlice(uint frames)
+	{
+		if(!frame && !loaded)
+		{
+			if(!load())
+				return false;
+		}
+		auto sliceEnd = std::min(frame + SLICE_FRAMES, frames);
+		for(; frame < sliceEnd; frame++)
+		{
+			for(; nextEvent < script.size() && script[nextEvent].frame <= frame; nextEvent++)
+			{
+				input.buttons = script[nextEvent].buttons;
+			}
+			size_t samples = FRAME_SAMPLES;
+			gb.runFor(videoBuff.get(), GB_RES_X, audioBuff.get(), samples, {});
+		}
+		return frame < frames;
+	}
+
+	bool failed() const
+	{
+		return loadRes != gambatte::LOADRES_OK;
+	}
+
+	// 64-bit FNV-1a of the last video frame
+	uint64_t videoHash() const
+	{
+		uint64_t hash = 0xcbf29ce484222325;
+		auto byte = (const uint8*)videoBuff.get();
+		iterateTimes(GB_RES_X * GB_RES_Y * sizeof(gambatte::PixelType), i)
+		{
+			hash = (hash ^ byte[i]) * 0x100000001b3;
+		}
+		return hash;
+	}
+
+private:
+	const std::vector<InputEvent> &script;
+	gambatte::GB gb{};
+	ScriptInputGetter input{};
+	// each instance has its own buffers, runFor() without a video buffer
+	// would draw into a line buffer shared by all instances
+	std::unique_ptr<gambatte::PixelType[]> videoBuff{new gambatte::PixelType[GB_RES_X * GB_RES_Y]{}};
+	std::unique_ptr<gambatte::uint_least32_t[]> audioBuff{new gambatte::uint_least32_t[FRAME_SAMPLES + RUN_FOR_EXTRA_SAMPLES]};
+	uint nextEvent = 0;
+	bool loaded = false;
+
+	bool load()
+	{
+		gb.setInputGetter(&input);
+		// keep runs reproducible: ignore battery & RTC files left in the working
+		// directory and run the cartridge clock from emulated time
+		gb.setRtcTimeFunc([this](){ return (std::time_t)((uint64_t)frame * FRAME_CYCLES / CPU_HZ); });
+		loadRes = gb.load(rom.data.data(), rom.data.size(), rom.name.data(), gambatte::GB::NO_SAVEDATA);
+		loaded = loadRes == gambatte::LOADRES_OK;
+		return loaded;
+	}
+};
+
+// Per-thread queues of instance indices. A thread keeps running the instance
+// it last ran from the front of its own queue while idle threads steal the
+// oldest entries from the back of the others, or sleep until one is queued.
+class JobQueues
+{
+public:
+	JobQueues(uint queues): queue{new Queue[queues]}, queues{queues} {}
+
+	void push(uint q, uint job)
+	{
+		{
+			std::lock_guard<std::mutex> lock{queue[q].mutex};
+			queue[q].jobs.push_front(job);
+		}
+		queued.fetch_add(1);
+		// taking the lock orders the count change with a sleeper's wait() check
+		{
+			std::lock_guard<std::mutex> lock{idleMutex};
+		}
+		idleCond.notify_one();
+	}
+
+	bool pop(uint q, uint &job)
+	{
+		std::lock_guard<std::mutex> lock{queue[q].mutex};
+		auto &jobs = queue[q].jobs;
+		if(jobs.empty())
+			return false;
+		job = jobs.front();
+		jobs.pop_front();
+		queued.fetch_sub(1);
+		return true;
+	}
+
+	bool steal(uint q, uint &job)
+	{
+		for(uint i = 1; i < queues; i++)
+		{
+			auto &victim = queue[(q + i) % queues];
+			std::lock_guard<std::mutex> lock{victim.mutex};
+			if(victim.jobs.empty())
+				continue;
+			job = victim.jobs.back();
+			victim.jobs.pop_back();
+			queued.fetch_sub(1);
+			return true;
+		}
+		return false;
+	}
+
+	// blocks until a job may be available, returns false once finish() is called
+	bool wait()
+	{
+		std::unique_lock<std::mutex> lock{idleMutex};
+		idleCond.wait(lock, [this](){ return queued.load() || finished; });
+		return !finished;
+	}
+
+	// wakes all threads in wait() after the last job completes
+	void finish()
+	{
+		{
+			std::lock_guard<std::mutex> lock{idleMutex};
+			finished = true;
+		}
+		idleCond.notify_all();
+	}
+
+private:
+	struct Queue
+	{
+		std::mutex mutex{};
+		std::deque<uint> jobs{};
+	};
+	std::unique_ptr<Queue[]> queue;
+	uint queues;
+	std::atomic_uint queued{};
+	std::mutex idleMutex{};
+	std::condition_variable idleCond{};
+	bool finished = false;
+};
+
+static bool parseArgs(int argc, char** argv, Config &conf)
+{
+	for(int i = 0; i < argc; i++)
+	{
+		auto opt = argv[i];
+		if(opt[0] != '-')
+		{
+			conf.romPaths.push_back(opt);
+			continue;
+		}
+		if(i + 1 == argc)
+		{
+			logErr("missing value for option: %s", opt);
+			return false;
+		}
+		auto val = argv[++i];
+		if(string_equal(opt, "-frames"))
+			conf.frames = atoi(val);
+		else if(string_equal(opt, "-repeat"))
+			conf.repeat = atoi(val);
+		else if(string_equal(opt, "-threads"))
+			conf.threads = atoi(val);
+		else if(string_equal(opt, "-batch-input"))
+			conf.inputScriptPath = val;
+		else
+		{
+			logErr("unknown option: %s", opt);
+			return false;
+		}
+	}
+	if(conf.romPaths.empty())
+	{
+		logErr("no ROMs given");
+		return false;
+	}
+	if(!conf.frames || !conf.repeat)
+	{
+		logErr("frame and repeat counts must be non-zero");
+		return false;
+	}
+	return true;
+}
+
+static bool readInputScript(const char *path, std::vector<InputEvent> &events)
+{
+	auto f = fopen(path, "rb");
+	if(!f)
+	{
+		logErr("error opening input script %s", path);
+		return false;
+	}
+	char line[128];
+	while(fgets(line, sizeof(line), f))
+	{
+		InputEvent e;
+		if(line[0] == '#' || sscanf(line, "%u %x", &e.frame, &e.buttons) != 2)
+			continue;
+		events.push_back(e);
+	}
+	fclose(f);
+	std::stable_sort(events.begin(), events.end(),
+		[](const InputEvent &lhs, const InputEvent &rhs){ return lhs.frame < rhs.frame; });
+	logMsg("read %zu input events from %s", events.size(), path);
+	return true;
+}
+
+static bool readRom(const char *path, Rom &rom)
+{
+	FileIO io;
+	if(auto ec = io.open(path, IO::AccessHint::ALL);
+		ec)
+	{
+		logErr("error opening ROM %s", path);
+		return false;
+	}
+	rom.name = FS::basename(path);
+	rom.data.resize(io.size());
+	if(io.read(rom.data.data(), rom.data.size()) != (ssize_t)rom.data.size())
+	{
+		logErr("error reading ROM %s", path);
+		return false;
+	}
+	return true;
+}
+
+bool run(int argc, char** argv)
+{
+	Config conf;
+	if(!parseArgs(argc, argv, conf))
+		return false;
+	std::vector<InputEvent> script;
+	if(conf.inputScriptPath && !readInputScript(conf.inputScriptPath, script))
+		return false;
+	std::vector<Rom> roms(conf.romPaths.size());
+	iterateTimes(roms.size(), i)
+	{
+		if(!readRom(conf.romPaths[i], roms[i]))
+			return false;
+	}
+	std::vector<std::unique_ptr<Instance>> instances;
+	for(auto &rom : roms)
+	{
+		iterateTimes(conf.repeat, i)
+		{
+			instances.emplace_back(std::make_unique<Instance>(rom, script));
+		}
+	}
+	uint threads = conf.threads ? conf.threads : std::max(std::thread::hardware_concurrency(), 1u);
+	threads = std::min(threads, (uint)instances.size());
+	JobQueues queues{threads};
+	iterateTimes(instances.size(), i)
+	{
+		queues.push(i % threads, i);
+	}
+
+	std::atomic_uint unfinished{(uint)instances.size()};
+	auto worker =
+		[&](uint q)
+		{
+			while(true)
+			{
+				uint job;
+				if(!queues.pop(q, job) && !queues.steal(q, job))
+				{
+					// the remaining instances are running on other threads
+					if(!queues.wait())
+						return;
+					continue;
+				}
+				if(instances[job]->runSlice(conf.frames))
+					queues.push(q, job);
+				else if(unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					queues.finish();
+			}
+		};
+	logMsg("running %zu instances for %u frames on %u threads", instances.size(), conf.frames, threads);
+	auto startTime = IG::Time::now();
+	std::vector<IG::thread> pool;
+	pool.reserve(threads - 1);
+	iterateTimes(threads - 1, i)
+	{
+		pool.emplace_back([&worker, i](){ worker(i + 1); });
+	}
+	worker(0);
+	for(auto &t : pool)
+	{
+		t.join();
+	}
+	auto time = IG::Time::now() - startTime;
+
+	bool success = true;
+	uint64_t totalFrames = 0;
+	iterateTimes(instances.size(), i)
+	{
+		auto &inst = *instances[i];
+		if(inst.failed())
+		{
+			logErr("instance %u (%s) failed to load: %s", i, inst.rom.name.data(), gambatte::to_string(inst.loadRes).c_str());
+			success = false;
+			continue;
+		}
+		totalFrames += inst.frame;
+		logMsg("instance %u (%s): last frame hash %016llx", i, inst.rom.name.data(), (unsigned long long)inst.videoHash());
+	}
+	logMsg("ran %llu frames in %f secs (%.2f fps total, %.2f fps per thread)",
+		(unsigned long long)totalFrames, double(time), totalFrames / double(time), totalFrames / double(time) / threads);
+	return success;
+}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+/*  This file is part of GBC.emu.
+
+	GBC.emu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	GBC.emu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with GBC.emu.  If not, see <http://www.gnu.org/licenses/> */
+
+// Headless batch runner, runs independent gambatte::GB instances on a
+// work-stealing thread pool without the app's global emulator state.
+// Arguments after -batch-run:
+//   [-frames <count>] [-repeat <instances per ROM>] [-threads <count>] [-batch-input <script>] <ROM>...
+// Input script lines are "<frame> <button mask>", the mask uses
+// gambatte::InputGetter's bits in hex and is held until the next line,
+// '#' starts a comment line. This differs from the frame hash check's -input
+// log, which records EmuSystem input actions rather than a button mask.
+
+namespace BatchRunner
+{
+
+// returns true if all instances loaded and ran
+bool run(int argc, char** argv);
+
+}
@@ -16,12 +16,16 @@
 #define LOGTAG "main"
 #include <emuframework/EmuApp.hh>
 #include <emuframework/EmuAppInlines.hh>
+#include <imagine/io/MemoryStreamBuf.hh>
 #include <gambatte.h>
 #include <resample/resampler.h>
 #include <resample/resamplerinfo.h>
 #include <main/Cheats.hh>
 #include <main/Palette.hh>
+#include <main/BatchRunner.hh>
 #include "internal.hh"
+#include <istream>
+#include <ostream>
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2018\nRobert Broglia\nwww.explusalpha.com\n\n(c) 2011\nthe Gambatte Team\ngambatte.sourceforge.net";
 gambatte::GB gbEmu;
@@ -116,6 +120,46 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 		return {};
 }
 
+// the state size is fixed once a game is loaded, so it's measured with a dry run
+// on the first query and afterwards taken from the last save
+static size_t stateSizeHint{};
+
+size_t EmuSystem::stateDataSize()
+{
+	if(!stateSizeHint)
+	{
+		MemoryStreamBuf buf;
+		std::ostream stream{&buf};
+		if(!gbEmu.saveState(0, 160, stream))
+			return 0;
+		stateSizeHint = buf.bytesWritten();
+	}
+	return stateSizeHint;
+}
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	MemoryStreamBuf buf{data, size};
+	std::ostream stream{&buf};
+	if(!gbEmu.saveState(0, 160, stream))
+	{
+		stateSizeHint = 0;
+		return makeError("State buffer too small");
+	}
+	dataSize = buf.bytesWritten();
+	stateSizeHint = dataSize;
+	return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	MemoryStreamBuf buf{data, size};
+	std::istream stream{&buf};
+	if(!gbEmu.loadState(stream))
+		return makeError("Invalid state data");
+	return {};
+}
+
 void EmuSystem::saveBackupMem()
 {
 	logMsg("saving battery");
@@ -136,6 +180,15 @@ void EmuSystem::closeSystem()
 	cheatList.clear();
 	cheatsModified = 0;
 	gameBuiltinPalette = nullptr;
+	stateSizeHint = 0;
+}
+
+std::optional<int> EmuSystem::runCommandLineTool(int argc, char** argv)
+{
+	// -batch-run [options] <ROM>..., see BatchRunner.hh
+	if(argc < 2 || !string_equal(argv[1], "-batch-run"))
+		return {};
+	return BatchRunner::run(argc - 2, argv + 2) ? 0 : 1;
 }
 
 EmuSystem::Error EmuSystem::loadGame(IO &io, OnLoadProgressDelegate)
@@ -22,12 +22,29 @@ Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA */
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <stdint.h>
+
+#if defined __SSE2__
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 
 /* sound buffer */
 static sample_t *buffer = NULL;
 static int buffer_size = 0;
 
 static sample_t impulses[MAX_RES][WIDTH];
+#if defined __SSE2__
+/* impulses with each pair of taps repeated for the left & right channel, */
+/* laid out for _mm_madd_epi16 on de-interleaved input pairs             */
+static sample_t impulses_sse[MAX_RES][WIDTH * 2] __attribute__((aligned(16)));
+#define IMPULSES      impulses_sse
+#define IMP_STRIDE    (WIDTH * 2)
+#else
+#define IMPULSES      impulses
+#define IMP_STRIDE    WIDTH
+#endif
 static sample_t* write_pos = NULL;
 static int res = 1;
 static int imp_phase = 0;
@@ -205,6 +222,18 @@ double Fir_Resampler_time_ratio( double new_factor, double rolloff )
     }
   }
 
+#if defined __SSE2__
+  for ( i = 0; i < MAX_RES; i++ )
+  {
+    for ( r = 0; r < WIDTH; r += 2 )
+    {
+      sample_t *out = &impulses_sse[i][r * 2];
+      out[0] = out[2] = impulses[i][r];
+      out[1] = out[3] = impulses[i][r + 1];
+    }
+  }
+#endif
+
   Fir_Resampler_clear();
 
   return ratio;
@@ -251,12 +280,9 @@ int Fir_Resampler_read( sample_t* out, long count )
   sample_t* in = buffer;
   sample_t* end_pos = write_pos;
   unsigned long skip = skip_bits >> imp_phase;
-  sample_t const* imp = impulses [imp_phase];
+  sample_t const* imp = IMPULSES [imp_phase];
   int remain = res - imp_phase;
-  int n;
-  int pt0,pt1;
-  sample_t* i;
-  long l,r;
+  int64_t l,r;
 
   if ( end_pos - in >= WIDTH * STEREO )
   {
@@ -268,23 +294,73 @@ int Fir_Resampler_read( sample_t* out, long count )
       if ( count < 0 )
         break;
 
+#if defined __SSE2__
+      {
+        /* 2 frames per 64-bit half, re-ordered to L0 L1 R0 R1 so each */
+        /* madd yields partial left & right sums in alternating lanes  */
+        /* A madd lane holds 2 products and the impulses are bounded   */
+        /* by 0x7FFF * GAIN, so it can't overflow. The lanes are then  */
+        /* sign extended and summed in 64 bits like the scalar path.   */
+        __m128i acc0 = _mm_setzero_si128();
+        __m128i acc1 = _mm_setzero_si128();
+        for ( int n = 0; n < WIDTH / 4; n++ )
+        {
+          __m128i v = _mm_loadu_si128( (const __m128i*)&in [n * 8] );
+          v = _mm_shufflelo_epi16( v, _MM_SHUFFLE(3, 1, 2, 0) );
+          v = _mm_shufflehi_epi16( v, _MM_SHUFFLE(3, 1, 2, 0) );
+          __m128i m = _mm_madd_epi16( v, _mm_load_si128( (const __m128i*)&imp [n * 8] ) );
+          __m128i sign = _mm_srai_epi32( m, 31 );
+          acc0 = _mm_add_epi64( acc0, _mm_unpacklo_epi32( m, sign ) );
+          acc1 = _mm_add_epi64( acc1, _mm_unpackhi_epi32( m, sign ) );
+        }
+        int64_t sum [2];
+        _mm_storeu_si128( (__m128i*)sum, _mm_add_epi64( acc0, acc1 ) );
+        l = sum [0];
+        r = sum [1];
+        imp += IMP_STRIDE;
+      }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+      {
+        /* de-interleave 16 frames into left & right vectors */
+        int16x8x2_t in0 = vld2q_s16( &in [0] );
+        int16x8x2_t in1 = vld2q_s16( &in [16] );
+        int16x8_t imp0 = vld1q_s16( &imp [0] );
+        int16x8_t imp1 = vld1q_s16( &imp [8] );
+        /* single products fit in 32 bits, pairs are summed into 64-bit */
+        /* lanes so loud input can't overflow like the scalar path      */
+        int64x2_t accL = vdupq_n_s64( 0 );
+        int64x2_t accR = vdupq_n_s64( 0 );
+        accL = vpadalq_s32( accL, vmull_s16( vget_low_s16( in0.val[0] ), vget_low_s16( imp0 ) ) );
+        accR = vpadalq_s32( accR, vmull_s16( vget_low_s16( in0.val[1] ), vget_low_s16( imp0 ) ) );
+        accL = vpadalq_s32( accL, vmull_s16( vget_high_s16( in0.val[0] ), vget_high_s16( imp0 ) ) );
+        accR = vpadalq_s32( accR, vmull_s16( vget_high_s16( in0.val[1] ), vget_high_s16( imp0 ) ) );
+        accL = vpadalq_s32( accL, vmull_s16( vget_low_s16( in1.val[0] ), vget_low_s16( imp1 ) ) );
+        accR = vpadalq_s32( accR, vmull_s16( vget_low_s16( in1.val[1] ), vget_low_s16( imp1 ) ) );
+        accL = vpadalq_s32( accL, vmull_s16( vget_high_s16( in1.val[0] ), vget_high_s16( imp1 ) ) );
+        accR = vpadalq_s32( accR, vmull_s16( vget_high_s16( in1.val[1] ), vget_high_s16( imp1 ) ) );
+        l = vgetq_lane_s64( accL, 0 ) + vgetq_lane_s64( accL, 1 );
+        r = vgetq_lane_s64( accR, 0 ) + vgetq_lane_s64( accR, 1 );
+        imp += IMP_STRIDE;
+      }
+#else
       /* accumulate in extended precision */
       l = 0;
       r = 0;
 
-      i = in;
+      sample_t* i = in;
 
-      for ( n = WIDTH / 2; n; --n )
+      for ( int n = WIDTH / 2; n; --n )
       {
-        pt0 = imp [0];
+        int pt0 = imp [0];
         l += pt0 * i [0];
         r += pt0 * i [1];
-        pt1 = imp [1];
+        int pt1 = imp [1];
         imp += 2;
         l += pt1 * i [2];
         r += pt1 * i [3];
         i += 4;
       }
+#endif
 
       remain--;
 
@@ -297,7 +373,7 @@ int Fir_Resampler_read( sample_t* out, long count )
 
       if ( !remain )
       {
-        imp = impulses [0];
+        imp = IMPULSES [0];
         skip = skip_bits;
         remain = res;
       }
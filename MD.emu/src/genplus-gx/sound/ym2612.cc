@@ -133,6 +133,12 @@
 
 #include "shared.h"
 
+#if defined __SSE2__
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 /* compiler dependence */
 #ifndef INLINE
 #define INLINE static __inline__
@@ -632,7 +638,7 @@ static YM2612 ym2612;
 /* current chip state */
 static INT32  m2,c1,c2;   /* Phase Modulation input for operators 2,3,4 */
 static INT32  mem;        /* one sample delay memory */
-static INT32  out_fm[8];  /* outputs of working channels */
+static INT32  out_fm[8] __attribute__((aligned(16)));  /* outputs of working channels */
 
 /* limiter */
 #define Limit(val, max,min) { \
@@ -2109,6 +2115,59 @@ void YM2612Update(FMSampleType *buffer, int length)
       advance_eg_channel(&ym2612.CH[5].SLOT[SLOT1]);
     }
 
+#if defined __SSE2__
+    {
+      /* channels 0-3 & 4-5 */
+      __m128i ch0 = _mm_load_si128((const __m128i*)&out_fm[0]);
+      __m128i ch1 = _mm_load_si128((const __m128i*)&out_fm[4]);
+
+      /* 14-bit DAC inputs (range is -8192;+8192) */
+      if(config_ym2612_clip)
+      {
+        const __m128i max = _mm_set1_epi32(8192);
+        const __m128i min = _mm_set1_epi32(-8192);
+        __m128i over = _mm_cmpgt_epi32(ch0, max);
+        ch0 = _mm_or_si128(_mm_andnot_si128(over, ch0), _mm_and_si128(over, max));
+        __m128i under = _mm_cmplt_epi32(ch0, min);
+        ch0 = _mm_or_si128(_mm_andnot_si128(under, ch0), _mm_and_si128(under, min));
+        over = _mm_cmpgt_epi32(ch1, max);
+        ch1 = _mm_or_si128(_mm_andnot_si128(over, ch1), _mm_and_si128(over, max));
+        under = _mm_cmplt_epi32(ch1, min);
+        ch1 = _mm_or_si128(_mm_andnot_si128(under, ch1), _mm_and_si128(under, min));
+      }
+
+      /* 6-channels mixing, each channel duplicated into a L/R pair and masked by its pan bits */
+      __m128i mix = _mm_and_si128(_mm_unpacklo_epi32(ch0, ch0), _mm_loadu_si128((const __m128i*)&ym2612.OPN.pan[0]));
+      mix = _mm_add_epi32(mix, _mm_and_si128(_mm_unpackhi_epi32(ch0, ch0), _mm_loadu_si128((const __m128i*)&ym2612.OPN.pan[4])));
+      mix = _mm_add_epi32(mix, _mm_and_si128(_mm_unpacklo_epi32(ch1, ch1), _mm_loadu_si128((const __m128i*)&ym2612.OPN.pan[8])));
+      mix = _mm_add_epi32(mix, _mm_srli_si128(mix, 8));
+      lt = _mm_cvtsi128_si32(mix);
+      rt = _mm_cvtsi128_si32(_mm_srli_si128(mix, 4));
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    {
+      /* channels 0-3 & 4-5 */
+      int32x4_t ch0 = vld1q_s32(&out_fm[0]);
+      int32x4_t ch1 = vld1q_s32(&out_fm[4]);
+
+      /* 14-bit DAC inputs (range is -8192;+8192) */
+      if(config_ym2612_clip)
+      {
+        ch0 = vmaxq_s32(vminq_s32(ch0, vdupq_n_s32(8192)), vdupq_n_s32(-8192));
+        ch1 = vmaxq_s32(vminq_s32(ch1, vdupq_n_s32(8192)), vdupq_n_s32(-8192));
+      }
+
+      /* 6-channels mixing, each channel duplicated into a L/R pair and masked by its pan bits */
+      int32x4x2_t dup0 = vzipq_s32(ch0, ch0);
+      int32x4x2_t dup1 = vzipq_s32(ch1, ch1);
+      int32x4_t mix = vandq_s32(dup0.val[0], vreinterpretq_s32_u32(vld1q_u32(&ym2612.OPN.pan[0])));
+      mix = vaddq_s32(mix, vandq_s32(dup0.val[1], vreinterpretq_s32_u32(vld1q_u32(&ym2612.OPN.pan[4]))));
+      mix = vaddq_s32(mix, vandq_s32(dup1.val[0], vreinterpretq_s32_u32(vld1q_u32(&ym2612.OPN.pan[8]))));
+      int32x2_t sum = vadd_s32(vget_low_s32(mix), vget_high_s32(mix));
+      lt = vget_lane_s32(sum, 0);
+      rt = vget_lane_s32(sum, 1);
+    }
+#else
     /* 14-bit DAC inputs (range is -8192;+8192) */
     if(config_ym2612_clip)
     {
@@ -2139,6 +2198,7 @@ void YM2612Update(FMSampleType *buffer, int length)
     rt += ((out_fm[4]) & ym2612.OPN.pan[9]);
     lt += ((out_fm[5]) & ym2612.OPN.pan[10]);
     rt += ((out_fm[5]) & ym2612.OPN.pan[11]);
+#endif
 
     /* buffering */
     *buffer++ = lt;
@@ -100,9 +100,6 @@ EmuSystem::Error state_load(const unsigned char *buffer)
 {
 	auto state = std::make_unique<unsigned char[]>(STATE_SIZE);
 
-  /* buffer size */
-  uint bufferptr = 0;
-
   /* uncompress savestate */
   uint32 inbytes32;
   memcpy(&inbytes32, buffer, 4);
@@ -118,6 +115,22 @@ EmuSystem::Error state_load(const unsigned char *buffer)
 		}
   }
 
+  return state_load_data(state.get(), outbytes);
+}
+
+EmuSystem::Error state_load_data(const unsigned char *stateData, unsigned long stateSize)
+{
+  /* context load functions only read from the state */
+  auto state = (unsigned char *)stateData;
+
+  /* buffer size */
+  uint bufferptr = 0;
+
+  if (stateSize < 16)
+  {
+    return EmuSystem::makeError("Missing header");
+  }
+
   /* signature check (GENPLUS-GX x.x.x) */
   char version[17];
   load_param(version,16);
@@ -201,7 +214,7 @@ EmuSystem::Error state_load(const unsigned char *buffer)
   	// was saved on a 32 or 64-bit machine and how much data to skip over.
   	int bytesLeft32 = oldStateSizeAfterVDP(exVersion, false);
   	int bytesLeft64 = oldStateSizeAfterVDP(exVersion, true);
-  	int bytesLeft = (int)outbytes - bufferptr;
+  	int bytesLeft = (int)stateSize - bufferptr;
   	if(bytesLeft == bytesLeft32)
   	{
   		logMsg("state was made on 32-bit system");
@@ -286,10 +299,10 @@ EmuSystem::Error state_load(const unsigned char *buffer)
 	}
 	#endif
 
-	if(bufferptr != outbytes)
+	if(bufferptr != stateSize)
 	{
 		system_reset();
-		return EmuSystem::makeError("Expected %d size state but got %d", bufferptr, (int)outbytes);
+		return EmuSystem::makeError("Expected %d size state but got %d", bufferptr, (int)stateSize);
 	}
 
   return {};
@@ -299,6 +312,24 @@ int state_save(unsigned char *buffer)
 {
 	auto state = std::make_unique<unsigned char[]>(STATE_SIZE);
 
+  /* buffer size */
+  int bufferptr = state_save_data(state.get());
+
+  /* compress state file */
+  unsigned long inbytes   = bufferptr;
+  unsigned long outbytes  = STATE_SIZE;
+  logMsg("compressing %d bytes to buffer of %d size", (int)inbytes, (int)outbytes);
+  int ret = compress2 ((Bytef *)(buffer + 4), &outbytes, (Bytef *)state.get(), inbytes, 9);
+  logMsg("compress2 returned %d, reduced to %d bytes", ret, (int)outbytes);
+  uint32 outbytes32 = outbytes; // assumes no save states will ever be over 4GB
+  memcpy(buffer, &outbytes32, 4);
+
+  /* return total size */
+  return (outbytes32 + 4);
+}
+
+int state_save_data(unsigned char *state)
+{
   /* buffer size */
   int bufferptr = 0;
 
@@ -393,15 +424,5 @@ int state_save(unsigned char *buffer)
 	}
 	#endif
 
-  /* compress state file */
-  unsigned long inbytes   = bufferptr;
-  unsigned long outbytes  = STATE_SIZE;
-  logMsg("compressing %d bytes to buffer of %d size", (int)inbytes, (int)outbytes);
-  int ret = compress2 ((Bytef *)(buffer + 4), &outbytes, (Bytef *)state.get(), inbytes, 9);
-  logMsg("compress2 returned %d, reduced to %d bytes", ret, (int)outbytes);
-  uint32 outbytes32 = outbytes; // assumes no save states will ever be over 4GB
-  memcpy(buffer, &outbytes32, 4);
-
-  /* return total size */
-  return (outbytes32 + 4);
+  return bufferptr;
 }
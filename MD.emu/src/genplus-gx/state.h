@@ -45,5 +45,8 @@
 /* Function prototypes */
 EmuSystem::Error state_load(const unsigned char *buffer);
 int state_save(unsigned char *buffer);
+/* uncompressed state data, state_save_data() writes up to STATE_SIZE bytes */
+EmuSystem::Error state_load_data(const unsigned char *stateData, unsigned long stateSize);
+int state_save_data(unsigned char *state);
 
 #endif
@@ -171,6 +171,25 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 	return loadMDState(path);
 }
 
+size_t EmuSystem::stateDataSize()
+{
+	return STATE_SIZE;
+}
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	// state_save_data() doesn't bounds check, only pass it a buffer that fits any state
+	if(size < STATE_SIZE)
+		return makeError("State buffer too small");
+	dataSize = state_save_data((unsigned char*)data);
+	return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	return state_load_data((const unsigned char*)data, size);
+}
+
 void EmuSystem::saveBackupMem() // for manually saving when not closing game
 {
 	if(!gameIsRunning())
@@ -31,6 +31,7 @@ CPPFLAGS += -I$(projectPath)/src \
 -I$(projectPath)/src/$(BMSX)/Common \
 -I$(projectPath)/src/$(BMSX)/TinyXML \
 -I$(projectPath)/src/$(BMSX)/VideoRender \
+-I$(EMUFRAMEWORK_PATH)/src/hqx \
 -I$(projectPath)/src/$(BMSX)/Board \
 -I$(projectPath)/src/$(BMSX)/Arch \
 -I$(projectPath)/src/$(BMSX)/Memory \
@@ -30,6 +30,7 @@
 #include "ArchTimer.h"
 #include "ArchMidi.h"
 #include <stdlib.h>
+#include <string.h>
 #include <stdio.h>
 #include <math.h>
 #include <assert.h>
@@ -118,6 +119,8 @@ struct Mixer
     UInt32 index;
     UInt32 volIndex;
     Int16   buffer[AUDIO_STEREO_BUFFER_SIZE];
+    Int32   mixLeft[AUDIO_MONO_BUFFER_SIZE];
+    Int32   mixRight[AUDIO_MONO_BUFFER_SIZE];
     AudioTypeInfo audioTypeInfo[MIXER_CHANNEL_TYPE_COUNT];
     MixerChannel channels[MAX_CHANNELS];
     MixerChannel midi; // This channel is only used for meter output
@@ -455,6 +458,75 @@ void mixerReset(Mixer* mixer)
     mixer->index = 0;
 }
 
+// Accumulates one channel's samples into the mix buffers. Channels are mixed
+// one at a time so idle chips cost nothing and the inner loops vectorize.
+static void mixChannelStereo(MixerChannel* channel, const Int32* chBuff,
+                             Int32* mixLeft, Int32* mixRight, UInt32 count)
+{
+    Int32 volumeLeft  = channel->volumeLeft;
+    Int32 volumeRight = channel->volumeRight;
+    Int32 volCntLeft  = 0;
+    Int32 volCntRight = 0;
+    UInt32 j;
+
+    if (channel->stereo) {
+        for (j = 0; j < count; j++) {
+            Int32 chanLeft  = volumeLeft  * chBuff[2 * j];
+            Int32 chanRight = volumeRight * chBuff[2 * j + 1];
+
+            volCntLeft  += (chanLeft  > 0 ? chanLeft  : -chanLeft)  / 2048;
+            volCntRight += (chanRight > 0 ? chanRight : -chanRight) / 2048;
+
+            mixLeft[j]  += chanLeft;
+            mixRight[j] += chanRight;
+        }
+    }
+    else {
+        for (j = 0; j < count; j++) {
+            Int32 tmp = chBuff[j];
+            Int32 chanLeft  = volumeLeft  * tmp;
+            Int32 chanRight = volumeRight * tmp;
+
+            volCntLeft  += (chanLeft  > 0 ? chanLeft  : -chanLeft)  / 2048;
+            volCntRight += (chanRight > 0 ? chanRight : -chanRight) / 2048;
+
+            mixLeft[j]  += chanLeft;
+            mixRight[j] += chanRight;
+        }
+    }
+
+    channel->volCntLeft  += volCntLeft;
+    channel->volCntRight += volCntRight;
+}
+
+static void mixChannelMono(MixerChannel* channel, const Int32* chBuff,
+                           Int32* mixLeft, UInt32 count)
+{
+    Int32 volumeLeft = channel->volumeLeft;
+    Int32 volCnt = 0;
+    UInt32 j;
+
+    if (channel->stereo) {
+        for (j = 0; j < count; j++) {
+            Int32 chanLeft = volumeLeft * (chBuff[2 * j] + chBuff[2 * j + 1]) / 2;
+
+            volCnt += (chanLeft > 0 ? chanLeft : -chanLeft) / 2048;
+            mixLeft[j] += chanLeft;
+        }
+    }
+    else {
+        for (j = 0; j < count; j++) {
+            Int32 chanLeft = volumeLeft * chBuff[j];
+
+            volCnt += (chanLeft > 0 ? chanLeft : -chanLeft) / 2048;
+            mixLeft[j] += chanLeft;
+        }
+    }
+
+    channel->volCntLeft  += volCnt;
+    channel->volCntRight += volCnt;
+}
+
 void mixerSync(Mixer* mixer)
 {
     UInt32 systemTime = boardSystemTime();
@@ -462,6 +534,7 @@ void mixerSync(Mixer* mixer)
     Int32* chBuff[MAX_CHANNELS];
     UInt32 count;
     UInt64 elapsed;
+    UInt32 j;
     int i;
 
     elapsed        = mixer->rate * (UInt64)(systemTime - mixer->refTime) + mixer->refFrag;
@@ -507,37 +580,18 @@ void mixerSync(Mixer* mixer)
     }
 
     if (mixer->stereo) {
-        while (count--) {
-            Int32 left = 0;
-            Int32 right = 0;
-
-            for (i = 0; i < mixer->channelCount; i++) {
-                Int32 chanLeft;
-                Int32 chanRight;
-
-                if (chBuff[i] == NULL) {
-                    continue;
-                }
+        memset(mixer->mixLeft,  0, count * sizeof(Int32));
+        memset(mixer->mixRight, 0, count * sizeof(Int32));
 
-                if (mixer->channels[i].stereo) {
-                    chanLeft = mixer->channels[i].volumeLeft * *chBuff[i]++;
-                    chanRight = mixer->channels[i].volumeRight * *chBuff[i]++;
-                }
-                else {
-                    Int32 tmp = *chBuff[i]++;
-                    chanLeft = mixer->channels[i].volumeLeft * tmp;
-                    chanRight = mixer->channels[i].volumeRight * tmp;
-                }
-
-                mixer->channels[i].volCntLeft  += (chanLeft  > 0 ? chanLeft  : -chanLeft)  / 2048;
-                mixer->channels[i].volCntRight += (chanRight > 0 ? chanRight : -chanRight) / 2048;
-
-                left  += chanLeft;
-                right += chanRight;
+        for (i = 0; i < mixer->channelCount; i++) {
+            if (chBuff[i] != NULL) {
+                mixChannelStereo(&mixer->channels[i], chBuff[i], mixer->mixLeft, mixer->mixRight, count);
             }
+        }
 
-            left  /= 4096;
-            right /= 4096;
+        for (j = 0; j < count; j++) {
+            Int32 left  = mixer->mixLeft[j]  / 4096;
+            Int32 right = mixer->mixRight[j] / 4096;
 
             mixer->volCntLeft  += left  > 0 ? left  : -left;
             mixer->volCntRight += right > 0 ? right : -right;
@@ -564,30 +618,16 @@ void mixerSync(Mixer* mixer)
         }
     }
     else {
-        while (count--) {
-            Int32 left = 0;
-
-            for (i = 0; i < mixer->channelCount; i++) {
-                Int32 chanLeft;
-
-                if (chBuff[i] == NULL) {
-                    continue;
-                }
+        memset(mixer->mixLeft, 0, count * sizeof(Int32));
 
-                if (mixer->channels[i].stereo) {
-                    Int32 tmp = *chBuff[i]++;
-                    chanLeft = mixer->channels[i].volumeLeft * (tmp + *chBuff[i]++) / 2;
-                }
-                else {
-                    chanLeft = mixer->channels[i].volumeLeft * *chBuff[i]++;
-                }
-            
-                mixer->channels[i].volCntLeft  += (chanLeft > 0 ? chanLeft : -chanLeft) / 2048;
-                mixer->channels[i].volCntRight += (chanLeft > 0 ? chanLeft : -chanLeft) / 2048;
-                left  += chanLeft;
+        for (i = 0; i < mixer->channelCount; i++) {
+            if (chBuff[i] != NULL) {
+                mixChannelMono(&mixer->channels[i], chBuff[i], mixer->mixLeft, count);
             }
+        }
 
-            left  /= 4096;
+        for (j = 0; j < count; j++) {
+            Int32 left = mixer->mixLeft[j] / 4096;
 
             mixer->volCntLeft  += left > 0 ? left : -left;
             mixer->volCntRight += left > 0 ? left : -left;
@@ -40,9 +40,7 @@ extern "C" {
 struct Moonsound {
     Moonsound() :
         timerValue1(0), timerValue2(0), timerRef1(0xff), timerRef2(0xff),
-        opl3latch(0), opl4latch(0) {
-        memset(defaultBuffer, 0, sizeof(defaultBuffer));
-    }
+        opl3latch(0), opl4latch(0) {}
 
     Mixer* mixer;
     Int32 handle;
@@ -50,7 +48,6 @@ struct Moonsound {
     YMF278* ymf278;
     YMF262* ymf262;
     Int32  buffer[AUDIO_STEREO_BUFFER_SIZE];
-    Int32  defaultBuffer[AUDIO_STEREO_BUFFER_SIZE];
     BoardTimer* timer1;
     BoardTimer* timer2;
     UInt32 timeout1;
@@ -297,13 +294,14 @@ static Int32* moonsoundSync(void* ref, UInt32 count)
     UInt32 i;
 
     genBuf1 = moonsound->ymf262->updateBuffer(count);
+    genBuf2 = moonsound->ymf278->updateBuffer(count);
+
+    // Idle chips return NULL, only sum when both are generating
     if (genBuf1 == NULL) {
-        genBuf1 = (int*)moonsound->defaultBuffer;
+        return genBuf2;
     }
-
-    genBuf2 = moonsound->ymf278->updateBuffer(count);
     if (genBuf2 == NULL) {
-        genBuf2 = (int*)moonsound->defaultBuffer;
+        return genBuf1;
     }
 
     for (i = 0; i < 2 * count; i++) {
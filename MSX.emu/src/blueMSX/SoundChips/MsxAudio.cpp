@@ -45,9 +45,7 @@ extern "C" Int32* msxaudioSync(void* ref, UInt32 count);
 
 struct MsxAudio {
     MsxAudio() :
-        timer1(0), timer2(0), timerRef1(-1), timerRef2(-1) {
-        memset(defaultBuffer, 0, sizeof(defaultBuffer));
-    }
+        timer1(0), timer2(0), timerRef1(-1), timerRef2(-1) {}
 
     Mixer* mixer;
     Int32  handle;
@@ -55,7 +53,6 @@ struct MsxAudio {
     Int32  deviceHandle;
     Y8950* y8950;
     Int32  buffer[AUDIO_MONO_BUFFER_SIZE];
-    Int32  defaultBuffer[AUDIO_MONO_BUFFER_SIZE];
     UInt32 timer1;
     UInt32 counter1;
     UInt8  timerRef1;
@@ -73,10 +70,8 @@ extern "C" Int32* msxaudioSync(void* ref, UInt32 count)
     MsxAudio* msxaudio = (MsxAudio*)ref;
     Int32* genBuf = NULL;
 
+    // NULL while the chip is idle, so the mixer skips it
     genBuf = (Int32*)msxaudio->y8950->updateBuffer(count);
-    if (genBuf == NULL) {
-        genBuf = msxaudio->defaultBuffer;
-    }
     return genBuf;
 }
 
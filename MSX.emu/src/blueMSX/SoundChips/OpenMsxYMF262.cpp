@@ -1867,11 +1867,13 @@ void YMF262::checkMute()
 bool YMF262::checkMuteHelper()
 {
 	// TODO this doesn't always mute when possible
+	// Slots in sustain or release only ever get quieter until the next
+	// register write, which re-checks the mute state
 	for (int i = 0; i < 18; i++) {
 		for (int j = 0; j < 2; j++) {
 			YMF262Slot &sl = channels[i].slots[j];
 			if (!((sl.state == EG_OFF) ||
-			      ((sl.state == EG_REL) &&
+			      (((sl.state == EG_REL) || (sl.state == EG_SUS)) &&
 			       ((sl.TLL + sl.volume) >= ENV_QUIET)))) {
 				return false;
 			}
@@ -2309,8 +2309,8 @@ Video* videoCreate()
 
     initRGBTable(pVideo);
 
-    hq2x_init();
-    hq3x_init();
+    hq2x_init(0);
+    hq3x_init(0);
 
     pVideo->palMode = VIDEO_PAL_FAST;
     pVideo->pRgbTable16 = pRgbTableColor16;
@@ -452,22 +452,15 @@ FS::PathString EmuSystem::sprintStateFilename(int slot, const char *statePath, c
 static const char saveStateVersion[] = "blueMSX - state  v 8";
 extern int pendingInt;
 
-static EmuSystem::Error saveBlueMSXState(const char *filename)
+// writes the state into the zip opened by zipStartWrite() or zipStartWriteMem()
+static bool writeBlueMSXState(const char *filename)
 {
-	CallResult res = zipStartWrite(filename);
-	if(res != OK)
-	{
-		logErr("error creating zip:%s", filename);
-		return EmuSystem::makeFileWriteError();
-	}
 	saveStateCreateForWrite(filename);
 	int rv = zipSaveFile(filename, "version", 0, saveStateVersion, sizeof(saveStateVersion));
 	if (!rv)
 	{
 		saveStateDestroy();
-		zipEndWrite();
-		logErr("error writing to zip:%s", filename);
-		return EmuSystem::makeFileWriteError();
+		return false;
 	}
 
 	SaveState* state = saveStateOpenForWrite("board");
@@ -496,6 +489,23 @@ static EmuSystem::Error saveBlueMSXState(const char *filename)
 	machineSaveState(machine);
 	boardInfo.saveState();
 	saveStateDestroy();
+	return true;
+}
+
+static EmuSystem::Error saveBlueMSXState(const char *filename)
+{
+	CallResult res = zipStartWrite(filename);
+	if(res != OK)
+	{
+		logErr("error creating zip:%s", filename);
+		return EmuSystem::makeFileWriteError();
+	}
+	if(!writeBlueMSXState(filename))
+	{
+		zipEndWrite();
+		logErr("error writing to zip:%s", filename);
+		return EmuSystem::makeFileWriteError();
+	}
 	zipEndWrite();
 	return {};
 }
@@ -505,6 +515,38 @@ EmuSystem::Error EmuSystem::saveState(const char *path)
 	return saveBlueMSXState(path);
 }
 
+// memory states hold the same zip archive as state files, stored uncompressed,
+// its size is measured with a dry run on the first query and afterwards estimated
+// from the last save since it varies with the machine state
+static size_t stateSizeHint{};
+
+size_t EmuSystem::stateDataSize()
+{
+	if(!stateSizeHint)
+	{
+		if(zipStartWriteMem(nullptr, 0) != OK)
+			return 0;
+		writeBlueMSXState("");
+		stateSizeHint = zipEndWriteMem();
+	}
+	return stateSizeHint;
+}
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	if(zipStartWriteMem(data, size) != OK)
+		return makeError("Error creating state archive");
+	bool success = writeBlueMSXState("");
+	dataSize = zipEndWriteMem();
+	if(!success || !dataSize)
+	{
+		stateSizeHint = 0;
+		return makeError("State buffer too small");
+	}
+	stateSizeHint = dataSize + dataSize / 4;
+	return {};
+}
+
 template <typename T>
 static void saveStateGetFileString(SaveState* state, const char* tagName, T &dest)
 {
@@ -585,6 +627,14 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 	return loadBlueMSXState(path);
 }
 
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	zipStartReadMem(data, size);
+	auto err = loadBlueMSXState("");
+	zipEndReadMem();
+	return err;
+}
+
 void EmuSystem::saveBackupMem()
 {
 	if(gameIsRunning())
@@ -596,6 +646,7 @@ void EmuSystem::saveBackupMem()
 void EmuSystem::closeSystem()
 {
 	destroyMSX();
+	stateSizeHint = 0;
 }
 
 EmuSystem::Error EmuSystem::loadGame(IO &, OnLoadProgressDelegate)
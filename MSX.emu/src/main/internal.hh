@@ -42,5 +42,12 @@ bool insertROM(const char *name, uint slot = 0);
 bool insertDisk(const char *name, uint slot = 0);
 CallResult zipStartWrite(const char *fileName);
 CallResult zipEndWrite();
+// like zipStartWrite() but into buff, or just counts bytes if buff is null,
+// zipEndWriteMem() returns the archive size or 0 on error
+CallResult zipStartWriteMem(void *buff, size_t size);
+size_t zipEndWriteMem();
+// zipLoadFile() reads from buff instead of the given archive until zipEndReadMem()
+void zipStartReadMem(const void *buff, size_t size);
+void zipEndReadMem();
 const char *machineBasePathStr();
 void setupVKeyboardMap(uint boardType);
@@ -17,14 +17,26 @@
 #include <archive.h>
 #include <archive_entry.h>
 #include <imagine/fs/ArchiveFS.hh>
+#include <imagine/io/BufferMapIO.hh>
 #include <imagine/logger/logger.h>
 #include <imagine/util/string.h>
 #include <imagine/util/ScopeGuard.hh>
 #include "ziphelper.h"
 #include <cstdlib>
+#include <cstring>
 
 static struct archive *writeArch{};
 
+// memory archive mode used for memory-backed states
+static struct
+{
+	char *buff{};
+	size_t size{};
+	size_t used{};
+} writeMem{};
+static const void *readMemData{};
+static size_t readMemSize{};
+
 void zipCacheReadOnlyZip(const char* zipName)
 {
 	// TODO
@@ -34,7 +46,18 @@ void* zipLoadFile(const char* zipName, const char* fileName, int* size)
 {
 	ArchiveIO io{};
 	std::error_code ec{};
-	for(auto &entry : FS::ArchiveIterator{zipName, ec})
+	FS::ArchiveIterator archIt{};
+	if(readMemData)
+	{
+		BufferMapIO buffIO{};
+		buffIO.open(readMemData, readMemSize);
+		archIt = FS::ArchiveIterator{buffIO.makeGeneric(), ec};
+	}
+	else
+	{
+		archIt = FS::ArchiveIterator{zipName, ec};
+	}
+	for(auto &entry : archIt)
 	{
 		if(entry.type() == FS::file_type::directory)
 		{
@@ -78,6 +101,62 @@ CallResult zipStartWrite(const char *fileName)
 	return OK;
 }
 
+static ssize_t writeMemCallback(struct archive *arch, void *, const void *buff, size_t bytes)
+{
+	if(writeMem.buff)
+	{
+		if(bytes > writeMem.size - writeMem.used)
+		{
+			archive_set_error(arch, ENOSPC, "out of space in state buffer");
+			return -1;
+		}
+		memcpy(writeMem.buff + writeMem.used, buff, bytes);
+	}
+	writeMem.used += bytes;
+	return bytes;
+}
+
+CallResult zipStartWriteMem(void *buff, size_t size)
+{
+	assert(!writeArch);
+	writeArch = archive_write_new();
+	archive_write_set_format_zip(writeArch);
+	// uncompressed and unpadded so the size only depends on the state data
+	archive_write_zip_set_compression_store(writeArch);
+	archive_write_set_bytes_in_last_block(writeArch, 1);
+	writeMem = {(char*)buff, size, 0};
+	if(archive_write_open(writeArch, nullptr, nullptr, writeMemCallback, nullptr) != ARCHIVE_OK)
+	{
+		archive_write_free(writeArch);
+		writeArch = {};
+		return IO_ERROR;
+	}
+	return OK;
+}
+
+size_t zipEndWriteMem()
+{
+	assert(writeArch);
+	bool success = archive_write_close(writeArch) == ARCHIVE_OK;
+	archive_write_free(writeArch);
+	writeArch = {};
+	auto used = writeMem.used;
+	writeMem = {};
+	return success ? used : 0;
+}
+
+void zipStartReadMem(const void *buff, size_t size)
+{
+	readMemData = buff;
+	readMemSize = size;
+}
+
+void zipEndReadMem()
+{
+	readMemData = {};
+	readMemSize = 0;
+}
+
 int zipSaveFile(const char* zipName, const char* fileName, int append, const void* buffer, int size)
 {
 	assert(writeArch);
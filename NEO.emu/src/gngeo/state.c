@@ -455,6 +455,36 @@ static void make_stateName(const char *game,int slot,char *st_name_out)
 	sprintf(st_name_out,"%s%s.%03d",getGngeoDir(),game,slot);
 }
 
+static const char *stateSig = "GNGST3";
+
+/* memory state buffer, used by mkstate_data() when there's no gzFile,
+ * a NULL mem_state only counts the bytes */
+static Uint8 *mem_state;
+static Uint32 mem_state_size, mem_state_pos;
+static bool mem_state_overflow;
+
+static void open_mem_state(const void *buf, Uint32 size) {
+	mem_state = (Uint8*)buf;
+	mem_state_size = size;
+	mem_state_pos = 0;
+	mem_state_overflow = false;
+}
+
+static int mkstate_mem_data(void *data,int size,int mode) {
+	if (mem_state_overflow || (Uint32)size > mem_state_size - mem_state_pos) {
+		mem_state_overflow = true;
+		return 0;
+	}
+	if (mem_state) {
+		if (mode==STREAD)
+			memcpy(data, mem_state + mem_state_pos, size);
+		else
+			memcpy(mem_state + mem_state_pos, data, size);
+	}
+	mem_state_pos += size;
+	return size;
+}
+
 static gzFile open_state(/*char *game,int slot,*/const char *st_name,int mode) {
 	/*char *st_name;
 //    char *st_name_len;
@@ -477,8 +507,6 @@ static gzFile open_state(/*char *game,int slot,*/const char *st_name,int mode) {
 		return NULL;
     }
 
-	static const char *stateSig = "GNGST3";
-
 	if(mode==STREAD) {
 
 		memset(string, 0, 20);
@@ -513,6 +541,8 @@ static gzFile open_state(/*char *game,int slot,*/const char *st_name,int mode) {
 }*/
 
 int mkstate_data(gzFile gzf,void *data,int size,int mode) {
+	if (!gzf)
+		return mkstate_mem_data(data,size,mode);
 	if (mode==STREAD)
 		return gzread(gzf,data,size);
 	return gzwrite(gzf,data,size);
@@ -580,8 +610,7 @@ int save_state(const char *game,int slot) {
 	return save_stateWithName(st_name);
 }
 
-int load_stateWithName(const char *name) {
-	gzFile gzf;
+static void load_state_data(gzFile gzf) {
 	/* Save pointers */
 	Uint8 *ng_lo = memory.ng_lo;
 	Uint8 *fix_game_usage=memory.fix_game_usage;
@@ -589,11 +618,6 @@ int load_stateWithName(const char *name) {
 	int *bksw_offset=memory.bksw_offset;
 //	GAME_ROMS r;
 //	memcpy(&r,&memory.rom,sizeof(GAME_ROMS));
-	
-	if ((gzf = open_state(name, STREAD))==NULL)
-		return false;
-
-	//gzread(gzf,state_img_tmp->pixels,304*224*2);
 
 	neogeo_mkstate(gzf,STREAD);
 
@@ -626,6 +650,17 @@ int load_stateWithName(const char *name) {
 		current_fix = memory.rom.bios_sfix.p;
 		fix_usage = memory.fix_board_usage;
 	}
+}
+
+int load_stateWithName(const char *name) {
+	gzFile gzf;
+	
+	if ((gzf = open_state(name, STREAD))==NULL)
+		return false;
+
+	//gzread(gzf,state_img_tmp->pixels,304*224*2);
+
+	load_state_data(gzf);
 
 	gzclose(gzf);
 	return true;
@@ -636,6 +671,50 @@ int load_state(const char *game,int slot) {
 	make_stateName(game,slot,st_name);
 	return load_stateWithName(st_name);
 }
+
+static void write_mem_state_header(void) {
+	int flags=m68k_flag | z80_flag | endian_flag;
+	mkstate_mem_data((void*)stateSig, 6, STWRITE);
+	mkstate_mem_data(&flags, sizeof(int), STWRITE);
+}
+
+Uint32 state_mem_size(void) {
+	open_mem_state(NULL, ~(Uint32)0);
+	write_mem_state_header();
+	neogeo_mkstate(NULL,STWRITE);
+	return mem_state_pos;
+}
+
+int save_stateToMem(void *buf, Uint32 size, Uint32 *written) {
+	open_mem_state(buf, size);
+	write_mem_state_header();
+	neogeo_mkstate(NULL,STWRITE);
+	if (mem_state_overflow)
+		return false;
+	*written = mem_state_pos;
+	return true;
+}
+
+int load_stateFromMem(const void *buf, Uint32 size) {
+	char string[7];
+	int flags;
+
+	/* check everything fits before changing any state */
+	if (size < state_mem_size())
+		return false;
+
+	open_mem_state(buf, size);
+	memset(string, 0, sizeof(string));
+	mkstate_mem_data(string, 6, STREAD);
+	mkstate_mem_data(&flags, sizeof(int), STREAD);
+	if (strcmp(string, stateSig) || flags != (m68k_flag | z80_flag | endian_flag)) {
+		logMsg("not a valid gngeo state");
+		return false;
+	}
+
+	load_state_data(NULL);
+	return true;
+}
 #endif
 
 #if 0
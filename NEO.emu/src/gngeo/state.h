@@ -94,6 +94,10 @@ int load_state(const char *game,int slot);
 int save_state(const char *game,int slot);
 int save_stateWithName(const char *name);
 int load_stateWithName(const char *name);
+/* states stored in a caller's buffer, state_mem_size() returns the bytes save_stateToMem() needs */
+Uint32 state_mem_size(void);
+int save_stateToMem(void *buf, Uint32 size, Uint32 *written);
+int load_stateFromMem(const void *buf, Uint32 size);
 Uint32 how_many_slot(char *game);
 int mkstate_data(gzFile gzf,void *data,int size,int mode);
 
@@ -111,6 +111,7 @@
 #include <string.h>
 #include <stdarg.h>
 #include <math.h>
+#include <assert.h>
 
 #include "mvs.h"
 #include "../state.h"
@@ -681,6 +682,7 @@ typedef struct
 	s8		vol_mul;		/* volume in "0.75dB" steps	*/
 	u8		vol_shift;		/* volume in "-6dB" steps	*/
 	s32		*pan;			/* &out_adpcma[OPN_xxxx] 	*/
+	const struct ADPCMA_CACHE_ENTRY *cache;	/* decoded sample or NULL */
 } ADPCMA;
 
 
@@ -2298,8 +2300,86 @@ static void OPNB_ADPCMA_init_table(void)
 
 }
 
+/* Decoded sample cache.
+   A channel always starts decoding at its start address with a cleared
+   accumulator and step, so the decoded sequence of a sample only depends on
+   the ROM data and can be reused by every later key on of the same sample. */
+#define ADPCMA_CACHE_SIZE		(1 << 20)	/* decoded nibbles */
+#define ADPCMA_CACHE_ENTRIES	256
+#define ADPCMA_CACHE_MAX_LEN	(1 << 16)	/* longer samples are decoded live */
+
+typedef struct ADPCMA_CACHE_ENTRY
+{
+	u32		start;			/* nibble address of the first decoded nibble */
+	u32		len;			/* decoded nibbles */
+	u32		offset;			/* index in adpcma_cache_acc/step */
+} ADPCMA_CACHE_ENTRY;
+
+static s16 adpcma_cache_acc[ADPCMA_CACHE_SIZE];
+static u8 adpcma_cache_step[ADPCMA_CACHE_SIZE];	/* adpcma_step / 16 */
+static ADPCMA_CACHE_ENTRY adpcma_cache_entry[ADPCMA_CACHE_ENTRIES];
+static u32 adpcma_cache_entries;
+static u32 adpcma_cache_used;
+
+static void OPNB_ADPCMA_cache_clear(void)
+{
+	int c;
+
+	adpcma_cache_entries = 0;
+	adpcma_cache_used = 0;
+	for (c = 0; c < 6; c++)
+		YM2610.adpcma[c].cache = NULL;
+}
+
+/* find or decode the sample a channel just keyed on, NULL if it can't be cached */
+static const ADPCMA_CACHE_ENTRY *OPNB_ADPCMA_cache_lookup(ADPCMA *ch)
+{
+	ADPCMA_CACHE_ENTRY *e;
+	u32 start = ch->now_addr;
+	u32 len = ((ch->end << 1) - start) & ((1 << 21) - 1);
+	s32 acc = 0, step = 0;
+	u32 i;
+
+	if (len > ADPCMA_CACHE_MAX_LEN || ((start + len) >> 1) > pcmsizeA)
+		return NULL;
+
+	for (i = 0; i < adpcma_cache_entries; i++)
+	{
+		if (adpcma_cache_entry[i].start == start && adpcma_cache_entry[i].len >= len)
+			return &adpcma_cache_entry[i];
+	}
+
+	if (adpcma_cache_entries == ADPCMA_CACHE_ENTRIES || adpcma_cache_used + len > ADPCMA_CACHE_SIZE)
+		OPNB_ADPCMA_cache_clear();
+
+	e = &adpcma_cache_entry[adpcma_cache_entries++];
+	e->start  = start;
+	e->len    = len;
+	e->offset = adpcma_cache_used;
+	adpcma_cache_used += len;
+
+	for (i = 0; i < len; i++)
+	{
+		u32 addr = start + i;
+		u8 data = pcmbufA[addr >> 1];
+
+		data = (addr & 1) ? (data & 0x0f) : ((data >> 4) & 0x0f);
+		acc += jedi_table[step + data];
+		if (acc & 0x800)
+			acc |= ~0xfff;
+		else
+			acc &= 0xfff;
+		step += step_inc[data & 7];
+		Limit(step, 48*16, 0*16);
+
+		adpcma_cache_acc[e->offset + i]  = acc;
+		adpcma_cache_step[e->offset + i] = step >> 4;
+	}
+	return e;
+}
+
 /* ADPCM A (Non control type) : calculate one channel output */
-INLINE void OPNB_ADPCMA_calc_chan(ADPCMA *ch)
+INLINE s32 OPNB_ADPCMA_calc_chan(ADPCMA *ch)
 {
 	u32 step;
 	u8  data;
@@ -2322,7 +2402,7 @@ INLINE void OPNB_ADPCMA_calc_chan(ADPCMA *ch)
 			{
 				ch->flag = 0;
 				YM2610.adpcm_arrivedEndAddress |= ch->flagMask;
-				return;
+				return 0;
 			}
 
 			if (ch->now_addr & 1)
@@ -2353,7 +2433,80 @@ INLINE void OPNB_ADPCMA_calc_chan(ADPCMA *ch)
 	}
 
 	/* output for work of output channels (out_adpcma[OPNxxxx]) */
-	*ch->pan += ch->adpcma_out;
+	return ch->adpcma_out;
+}
+
+/* ADPCM A : add one channel's output for a whole block */
+static void OPNB_ADPCMA_calc_block(ADPCMA *ch, s32 *bufL, s32 *bufR, int length)
+{
+	int pan = ch->pan - out_adpcma;
+	s32 maskL = (pan & OUTD_LEFT)  ? ~0 : 0;
+	s32 maskR = (pan & OUTD_RIGHT) ? ~0 : 0;
+	const ADPCMA_CACHE_ENTRY *e = ch->cache;
+	int i;
+
+	if (e)
+	{
+		u32 idx = ch->now_addr - e->start;
+		/* nibbles left until the end address check fires */
+		u32 rem = ((ch->end << 1) - ch->now_addr) & ((1 << 21) - 1);
+
+		if (idx + rem > e->len)
+		{
+			/* end address moved past the decoded part */
+			ch->cache = e = NULL;
+		}
+		else
+		{
+			const s16 *acc = &adpcma_cache_acc[e->offset];
+			u32 now_step = ch->now_step;
+			s32 out = ch->adpcma_out;
+
+			for (i = 0; i < length; i++)
+			{
+				now_step += ch->step;
+				if (now_step >= (1 << ADPCM_SHIFT))
+				{
+					u32 step = now_step >> ADPCM_SHIFT;
+					now_step &= (1 << ADPCM_SHIFT) - 1;
+
+					if (step > rem)
+					{
+						idx += rem;
+						ch->flag = 0;
+						YM2610.adpcm_arrivedEndAddress |= ch->flagMask;
+						break;
+					}
+					idx += step;
+					rem -= step;
+
+					/* calc pcm * volume data */
+					out = ((acc[idx - 1] * ch->vol_mul) >> ch->vol_shift) & ~3;
+				}
+				bufL[i] += out & maskL;
+				bufR[i] += out & maskR;
+			}
+
+			/* write back the state the live decoder would have */
+			ch->now_step = now_step;
+			ch->now_addr = e->start + idx;
+			ch->adpcma_out = out;
+			if (idx)
+			{
+				ch->adpcma_acc  = acc[idx - 1];
+				ch->adpcma_step = adpcma_cache_step[e->offset + idx - 1] << 4;
+				ch->now_data    = pcmbufA[(ch->now_addr - 1) >> 1];
+			}
+			return;
+		}
+	}
+
+	for (i = 0; i < length && ch->flag; i++)
+	{
+		s32 out = OPNB_ADPCMA_calc_chan(ch);
+		bufL[i] += out & maskL;
+		bufR[i] += out & maskR;
+	}
 }
 
 /* ADPCM type A Write */
@@ -2403,6 +2556,7 @@ static void OPNB_ADPCMA_write(int r, int v)
 							adpcma[c].flag = 0;
 						}
 					}
+					adpcma[c].cache = adpcma[c].flag ? OPNB_ADPCMA_cache_lookup(&adpcma[c]) : NULL;
 				}
 			}
 		}
@@ -2825,6 +2979,7 @@ void YM2610Init(int clock, int rate,
 	/* ADPCM-A */
 	pcmbufA = (u8 *)pcmroma;
 	pcmsizeA = pcmsizea;
+	OPNB_ADPCMA_cache_clear();
 	/* ADPCM-B */
 	pcmbufB = (u8 *)pcmromb;
 	pcmsizeB = pcmsizeb;
@@ -2895,6 +3050,7 @@ void YM2610Reset(void)
 		YM2610.adpcma[i].adpcma_acc  = 0;
 		YM2610.adpcma[i].adpcma_step = 0;
 		YM2610.adpcma[i].adpcma_out  = 0;
+		YM2610.adpcma[i].cache       = NULL;
 	}
 	YM2610.adpcmaTL = 0x3f;
 
@@ -3092,6 +3248,8 @@ int YM2610TimerOver(int ch)
 
 s16 mixing_buffer[2][16384];
 extern Uint16 play_buffer[16384];
+#define ADPCMA_OUT_SAMPLES 8192
+static s32 adpcma_outL[ADPCMA_OUT_SAMPLES], adpcma_outR[ADPCMA_OUT_SAMPLES];
 //static Uint32 buf_pos;
 
 /* Generate samples for one of the YM2610s */
@@ -3103,6 +3261,11 @@ void YM2610Update_stream(int length)
 	FM_CH *cch[6];
 	Uint16 *pl = play_buffer;
 
+	/* the ADPCM-A block buffers hold one video frame of samples with room to spare */
+	assert(length <= ADPCMA_OUT_SAMPLES);
+	if (length > ADPCMA_OUT_SAMPLES)
+		length = ADPCMA_OUT_SAMPLES;
+
     //printf("AAA %d\n",length);
 	cch[0] = &YM2610.CH[1];
 	cch[1] = &YM2610.CH[2];
@@ -3131,6 +3294,15 @@ void YM2610Update_stream(int length)
 	/* calc SSG count */
 	outn = SSG_calc_count(length);
 
+	/* ADPCM-A only depends on its own registers, so render each channel for the whole block */
+	memset(adpcma_outL, 0, length * sizeof(s32));
+	memset(adpcma_outR, 0, length * sizeof(s32));
+	for (j = 0; j < 6; j++)
+	{
+		if (YM2610.adpcma[j].flag)
+			OPNB_ADPCMA_calc_block(&YM2610.adpcma[j], adpcma_outL, adpcma_outR, length);
+	}
+
 	/* buffering */
 	for (i = 0; i < length; i++)
 	{
@@ -3138,7 +3310,6 @@ void YM2610Update_stream(int length)
 		advance_lfo(OPN);
 
 		/* clear output acc. */
-		out_adpcma[OUTD_LEFT] = out_adpcma[OUTD_RIGHT]= out_adpcma[OUTD_CENTER] = 0;
 		out_delta[OUTD_LEFT] = out_delta[OUTD_RIGHT]= out_delta[OUTD_CENTER] = 0;
 
 		/* clear outputs */
@@ -3175,15 +3346,9 @@ void YM2610Update_stream(int length)
 		if (YM2610.adpcmb.portstate & 0x80)
 			OPNB_ADPCMB_CALC(&YM2610.adpcmb);
 
-		for (j = 0; j < 6; j++)
-		{
-			/* ADPCM */
-			if (YM2610.adpcma[j].flag)
-				OPNB_ADPCMA_calc_chan(&YM2610.adpcma[j]);
-		}
 		/* buffering */
-		lt =  out_adpcma[OUTD_LEFT]  + out_adpcma[OUTD_CENTER];
-		rt =  out_adpcma[OUTD_RIGHT] + out_adpcma[OUTD_CENTER];
+		lt =  adpcma_outL[i];
+		rt =  adpcma_outR[i];
 
 		lt += (out_delta[OUTD_LEFT]  + out_delta[OUTD_CENTER])>>9;
 		rt += (out_delta[OUTD_RIGHT] + out_delta[OUTD_CENTER])>>9;
@@ -3400,6 +3565,8 @@ void ym2610_mkstate(gzFile gzf,int mode) {
 		OPNB_ADPCMA_write(0x101, YM2610.regs[0x101]);
 		for(int r = 0; r < 6; r++)
 		{
+			/* restored channels continue with the live decoder */
+			YM2610.adpcma[r].cache = NULL;
 			OPNB_ADPCMA_write(r + 0x108, YM2610.regs[r + 0x108]);
 			OPNB_ADPCMA_write(r + 0x110, YM2610.regs[r + 0x110]);
 			OPNB_ADPCMA_write(r + 0x118, YM2610.regs[r + 0x118]);
@@ -20,6 +20,7 @@
 #include <imagine/thread/Thread.hh>
 #include <imagine/fs/ArchiveFS.hh>
 #include <imagine/util/ScopeGuard.hh>
+#include <imagine/logger/Trace.hh>
 #include "internal.hh"
 
 extern "C"
@@ -147,6 +148,27 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 		return {};
 }
 
+size_t EmuSystem::stateDataSize()
+{
+	return state_mem_size();
+}
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	Uint32 written;
+	if(!save_stateToMem(data, size, &written))
+		return EmuSystem::makeError("State buffer too small");
+	dataSize = written;
+	return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	if(!load_stateFromMem(data, size))
+		return EmuSystem::makeError("Invalid state data");
+	return {};
+}
+
 void EmuSystem::saveBackupMem()
 {
 	if(gameIsRunning())
@@ -363,8 +385,14 @@ void EmuSystem::runFrame(EmuVideo *video, bool renderAudio)
 	skip_this_frame = !video;
 	if(video)
 		IG::fillData(screenBuff, (uint16)current_pc_pal[4095]);
-	main_frame();
-	YM2610Update_stream(audioFramesPerVideoFrame);
+	{
+		TRACE_ZONE("main_frame");
+		main_frame();
+	}
+	{
+		TRACE_ZONE("YM2610Update_stream");
+		YM2610Update_stream(audioFramesPerVideoFrame);
+	}
 	if(renderAudio)
 	{
 		writeSound(play_buffer, audioFramesPerVideoFrame);
@@ -356,6 +356,10 @@ protected:
 public:
 
 	EMUFILE_IO(IO &io);
+	// reads directly from buff without copying it
+	EMUFILE_IO(const void *buff, size_t size);
+	// writes into buff, setting failbit once it's full
+	EMUFILE_IO(void *buff, size_t size);
 
 	~EMUFILE_IO() {
 	}
@@ -376,18 +380,14 @@ public:
 
 	int fgetc();
 
-	int fputc(int c) {
-		return 0;
-	}
+	int fputc(int c);
 
 	size_t _fread(const void *ptr, size_t bytes);
 
 	//removing these return values for now so we can find any code that might be using them and make sure
 	//they handle the return values correctly
 
-	void fwrite(const void *ptr, size_t bytes){
-		failbit = true;
-	}
+	void fwrite(const void *ptr, size_t bytes);
 
 	int fseek(int offset, int origin);
 
@@ -12,6 +12,22 @@
 
 #include <cmath>
 #include <cstdio>
+#ifndef NDEBUG
+#include <chrono>
+#endif
+
+/* The SSE2 kernel is built for any x86 target and picked at runtime if the
+   CPU has SSE2, NEON is used when the target is built for it. */
+#if (defined(__i386__) || defined(__x86_64__)) && defined(__GNUC__)
+#include <emmintrin.h>
+#define FILTER_SIMD
+#define FILTER_SSE2
+#define FILTER_SIMD_TARGET __attribute__((target("sse2")))
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FILTER_SIMD
+#define FILTER_SIMD_TARGET
+#endif
 
 static int32 sq2coeffs[SQ2NCOEFFS];
 static int32 coeffs[NCOEFFS];
@@ -19,6 +35,147 @@ static int32 coeffs[NCOEFFS];
 static uint32 mrindex;
 static uint32 mrratio;
 
+/* FIR convolution over the oversampled wave buffer. Each product is shifted
+   before accumulation to keep the sum in 32 bits, so the vector versions
+   shift per lane and add with wrap-around, matching the scalar loop exactly.
+   The coefficient tables are symmetric (see MakeFilters), which lets the
+   kernels walk samples and coefficients in the same direction. */
+typedef void (*FIRConvolveFunc)(const int32 *S, const int32 *D, uint32 n, int32 *acc, int32 *acc2);
+
+static void FIRConvolve(const int32 *S, const int32 *D, uint32 n, int32 *accOut, int32 *acc2Out)
+{
+ int32 acc=0,acc2=0;
+ for(uint32 c=0;c<n;c++)
+ {
+  acc+=(S[c]*D[c])>>6;
+  acc2+=(S[c+1]*D[c])>>6;
+ }
+ *accOut=acc;
+ *acc2Out=acc2;
+}
+
+#ifdef FILTER_SIMD
+#ifdef FILTER_SSE2
+FILTER_SIMD_TARGET static inline __m128i mullo32(__m128i a, __m128i b)
+{
+ __m128i even=_mm_mul_epu32(a,b);
+ __m128i odd=_mm_mul_epu32(_mm_srli_si128(a,4),_mm_srli_si128(b,4));
+ return _mm_unpacklo_epi32(_mm_shuffle_epi32(even,_MM_SHUFFLE(0,0,2,0)),
+  _mm_shuffle_epi32(odd,_MM_SHUFFLE(0,0,2,0)));
+}
+
+FILTER_SIMD_TARGET static inline int32 hsum32(__m128i v)
+{
+ v=_mm_add_epi32(v,_mm_shuffle_epi32(v,_MM_SHUFFLE(1,0,3,2)));
+ v=_mm_add_epi32(v,_mm_shuffle_epi32(v,_MM_SHUFFLE(2,3,0,1)));
+ return _mm_cvtsi128_si32(v);
+}
+#endif
+
+FILTER_SIMD_TARGET static void FIRConvolveSIMD(const int32 *S, const int32 *D, uint32 n, int32 *accOut, int32 *acc2Out)
+{
+ uint32 c=0;
+ int32 acc,acc2;
+ #ifdef FILTER_SSE2
+ __m128i vacc=_mm_setzero_si128(),vacc2=_mm_setzero_si128();
+ for(;c+4<=n;c+=4)
+ {
+  __m128i d=_mm_loadu_si128((const __m128i*)(D+c));
+  __m128i s=_mm_loadu_si128((const __m128i*)(S+c));
+  __m128i s2=_mm_loadu_si128((const __m128i*)(S+c+1));
+  vacc=_mm_add_epi32(vacc,_mm_srai_epi32(mullo32(s,d),6));
+  vacc2=_mm_add_epi32(vacc2,_mm_srai_epi32(mullo32(s2,d),6));
+ }
+ acc=hsum32(vacc);
+ acc2=hsum32(vacc2);
+ #else
+ int32x4_t vacc=vdupq_n_s32(0),vacc2=vdupq_n_s32(0);
+ for(;c+4<=n;c+=4)
+ {
+  int32x4_t d=vld1q_s32(D+c);
+  vacc=vaddq_s32(vacc,vshrq_n_s32(vmulq_s32(vld1q_s32(S+c),d),6));
+  vacc2=vaddq_s32(vacc2,vshrq_n_s32(vmulq_s32(vld1q_s32(S+c+1),d),6));
+ }
+ int32x2_t sum=vadd_s32(vget_low_s32(vacc),vget_high_s32(vacc));
+ int32x2_t sum2=vadd_s32(vget_low_s32(vacc2),vget_high_s32(vacc2));
+ acc=vget_lane_s32(vpadd_s32(sum,sum),0);
+ acc2=vget_lane_s32(vpadd_s32(sum2,sum2),0);
+ #endif
+ if(c<n)
+ {
+  int32 tail,tail2;
+  FIRConvolve(S+c,D+c,n-c,&tail,&tail2);
+  acc+=tail;
+  acc2+=tail2;
+ }
+ *accOut=acc;
+ *acc2Out=acc2;
+}
+#endif
+
+static FIRConvolveFunc firConvolve=FIRConvolve;
+
+#ifdef FILTER_SIMD
+static bool FilterCPUHasSIMD()
+{
+ #if defined(FILTER_SSE2) && !defined(__SSE2__)
+ return __builtin_cpu_supports("sse2");
+ #else
+ return true;
+ #endif
+}
+
+/* Runs both kernels over the same pseudo-random wave data with the active
+   coefficient table and returns false unless every output matches bit for
+   bit. Debug builds repeat the run and log the time taken by each kernel. */
+static bool FIRCompareKernels(const int32 *D, uint32 nco)
+{
+ enum { WINDOWS=64 };
+ static int32 S[SQ2NCOEFFS+1+WINDOWS];
+ uint32 seed=0x4e455321;
+ for(uint32 x=0;x<nco+1+WINDOWS;x++)
+ {
+  seed=seed*1103515245+12345;
+  S[x]=(int16)(seed>>16);
+ }
+ for(uint32 w=0;w<WINDOWS;w++)
+ {
+  int32 acc,acc2,vacc,vacc2;
+  FIRConvolve(S+w,D,nco,&acc,&acc2);
+  FIRConvolveSIMD(S+w,D,nco,&vacc,&vacc2);
+  if(acc!=vacc || acc2!=vacc2)
+  {
+   FCEU_printf("SIMD FIR convolution mismatch at window %u, using scalar code\n",w);
+   return false;
+  }
+ }
+ #ifndef NDEBUG
+ {
+  enum { ROUNDS=64 };
+  FIRConvolveFunc kernel[2]={FIRConvolve,FIRConvolveSIMD};
+  int64 nsecs[2];
+  volatile int32 sink=0;
+  for(int k=0;k<2;k++)
+  {
+   auto start=std::chrono::steady_clock::now();
+   for(uint32 r=0;r<ROUNDS;r++)
+    for(uint32 w=0;w<WINDOWS;w++)
+    {
+     int32 acc,acc2;
+     kernel[k](S+w,D,nco,&acc,&acc2);
+     sink=acc^acc2;
+    }
+   nsecs[k]=std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start).count();
+  }
+  (void)sink;
+  FCEU_printf("FIR convolution, %u taps x %u: scalar %lld us, SIMD %lld us\n",
+   nco,ROUNDS*WINDOWS,(long long)nsecs[0]/1000,(long long)nsecs[1]/1000);
+ }
+ #endif
+ return true;
+}
+#endif
+
 void SexyFilter2(int32 *in, int32 count)
 {
  #ifdef moo
@@ -106,42 +263,25 @@ int32 NeoFilterSound(int32 *in, int32 *out, uint32 inlen, int32 *leftover)
 //	}
         max=(inlen-1)<<16;
 
+	const int32 *D=coeffs;
+	uint32 nco=NCOEFFS;
 	if(FSettings.soundq==2)
-        for(x=mrindex;x<max;x+=mrratio)
-        {
-			int32 acc=0,acc2=0;
-			unsigned int c;
-			int32 *S,*D;
-
-			for(c=SQ2NCOEFFS,S=&in[(x>>16)-SQ2NCOEFFS],D=sq2coeffs;c;c--,D++)
-			{
-				acc+=(S[c]**D)>>6;
-				acc2+=(S[1+c]**D)>>6;
-			}
-
-			acc=((int64)acc*(65536-(x&65535))+(int64)acc2*(x&65535))>>(16+11);
-			*out=acc;
-			out++;
-			count++;
-        }
-	else
-		for(x=mrindex;x<max;x+=mrratio)
-		{
-			int32 acc=0,acc2=0;
-			unsigned int c;
-			const int32 *S,*D;
-
-			for(c=NCOEFFS,S=&in[(x>>16)-NCOEFFS],D=coeffs;c;c--,D++)
-			{
-				acc+=(S[c]**D)>>6;
-				acc2+=(S[1+c]**D)>>6;
-			}
-
-			acc=((int64)acc*(65536-(x&65535))+(int64)acc2*(x&65535))>>(16+11);
-			*out=acc;
-			out++;
-			count++;
-		}
+	{
+		D=sq2coeffs;
+		nco=SQ2NCOEFFS;
+	}
+
+	for(x=mrindex;x<max;x+=mrratio)
+	{
+		int32 acc,acc2;
+
+		firConvolve(&in[(x>>16)-nco+1],D,nco,&acc,&acc2);
+
+		acc=((int64)acc*(65536-(x&65535))+(int64)acc2*(x&65535))>>(16+11);
+		*out=acc;
+		out++;
+		count++;
+	}
 
 	mrindex=x-max;
 
@@ -196,6 +336,12 @@ void MakeFilters(int32 rate)
   for(x=0;x<NCOEFFS>>1;x++)
    coeffs[x]=coeffs[NCOEFFS-1-x]=tmp[x];
 
+ firConvolve=FIRConvolve;
+ #ifdef FILTER_SIMD
+ if(FilterCPUHasSIMD() && FIRCompareKernels(FSettings.soundq==2?sq2coeffs:coeffs,nco))
+  firConvolve=FIRConvolveSIMD;
+ #endif
+
  #ifdef MOO
  /* Some tests involving precision and error. */
  {
@@ -274,6 +274,16 @@ EMUFILE_IO::EMUFILE_IO(IO &srcIO)
 	}
 }
 
+EMUFILE_IO::EMUFILE_IO(const void *buff, size_t size)
+{
+	io.open(buff, size);
+}
+
+EMUFILE_IO::EMUFILE_IO(void *buff, size_t size)
+{
+	io.openForWrite(buff, size);
+}
+
 void EMUFILE_IO::truncate(s32 length)
 {
 	io.truncate(length);
@@ -284,6 +294,23 @@ int EMUFILE_IO::fgetc()
 	return ::fgetc(io);
 }
 
+int EMUFILE_IO::fputc(int c)
+{
+	uint8 byte = c;
+	if(io.write(&byte, 1) != 1)
+	{
+		failbit = true;
+		return EOF;
+	}
+	return c;
+}
+
+void EMUFILE_IO::fwrite(const void *ptr, size_t bytes)
+{
+	if(io.write(ptr, bytes) != (ssize_t)bytes)
+		failbit = true;
+}
+
 size_t EMUFILE_IO::_fread(const void *ptr, size_t bytes)
 {
 	ssize_t ret = io.read((void*)ptr, bytes);
@@ -26,6 +26,7 @@
 #include <fceu/cheat.h>
 #include <fceu/video.h>
 #include <fceu/sound.h>
+#include <zlib.h>
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2018\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nFCEUX Team\nfceux.com";
 bool EmuSystem::hasCheats = true;
@@ -138,6 +139,43 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 		return {};
 }
 
+// the state size is fixed once a game is loaded, so it's measured with a dry run
+// on the first query and afterwards taken from the last save
+static size_t stateSizeHint{};
+
+size_t EmuSystem::stateDataSize()
+{
+	if(!stateSizeHint)
+	{
+		EMUFILE_MEMORY sizeStream;
+		if(!FCEUSS_SaveMS(&sizeStream, Z_NO_COMPRESSION))
+			return 0;
+		stateSizeHint = sizeStream.size();
+	}
+	return stateSizeHint;
+}
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	EMUFILE_IO stream{data, size};
+	if(!FCEUSS_SaveMS(&stream, Z_NO_COMPRESSION) || stream.fail())
+	{
+		stateSizeHint = 0;
+		return makeError("State buffer too small");
+	}
+	dataSize = stream.ftell();
+	stateSizeHint = dataSize;
+	return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	EMUFILE_IO stream{data, size};
+	if(!FCEUSS_LoadFP(&stream, SSLOADPARAM_NOBACKUP))
+		return makeError("Invalid state data");
+	return {};
+}
+
 void EmuSystem::saveBackupMem() // for manually saving when not closing game
 {
 	if(gameIsRunning())
@@ -156,6 +194,7 @@ void EmuSystem::closeSystem()
 {
 	FCEUI_CloseGame();
 	fceuCheats = 0;
+	stateSizeHint = 0;
 }
 
 void FCEUD_SetPalette(uint8 index, uint8 r, uint8 g, uint8 b)
@@ -38,6 +38,7 @@ static bool write_REGS(FILE *);
 static bool write_ROM(FILE *);
 static bool write_ROMH(FILE *);
 static bool write_TIME(FILE *);
+static uint32 size_SNAP(int, int);
 
 
 bool read_chunk(FILE *fp, uint32 *tagp, uint32 *sizep)
@@ -206,15 +207,7 @@ bool write_SNAP(FILE *fp, int options)
 	if (options & OPT_FLSH)
 		flash = flash_prepare(&flash_size);
 	
-	size = SIZE_RAM + SIZE_REGS + SIZE_CHUNK*2;
-	if (options & OPT_TIME)
-		size += SIZE_TIME + SIZE_CHUNK;
-	if (options & OPT_ROM)
-		size += SIZE_ROM + SIZE_CHUNK;
-	if (options & OPT_ROMH)
-		size += SIZE_ROMH + SIZE_CHUNK;
-	if (options & OPT_FLSH)
-		size += flash_size + SIZE_CHUNK;
+	size = size_SNAP(options, flash_size);
 
 	ret = write_chunk(fp, TAG_SNAP, NULL, size);
 
@@ -236,6 +229,32 @@ bool write_SNAP(FILE *fp, int options)
 }
 
 
+uint32 size_snapshot(int options)
+{
+	if (options & OPT_FLSH)
+		return 0;
+
+	return HEADER_SIZE + SIZE_CHUNK + size_SNAP(options, 0) + SIZE_CHUNK + SIZE_EOD;
+}
+
+
+static uint32 size_SNAP(int options, int flash_size)
+{
+	uint32 size;
+
+	size = SIZE_RAM + SIZE_REGS + SIZE_CHUNK*2;
+	if (options & OPT_TIME)
+		size += SIZE_TIME + SIZE_CHUNK;
+	if (options & OPT_ROM)
+		size += SIZE_ROM + SIZE_CHUNK;
+	if (options & OPT_ROMH)
+		size += SIZE_ROMH + SIZE_CHUNK;
+	if (options & OPT_FLSH)
+		size += flash_size + SIZE_CHUNK;
+
+	return size;
+}
+
 static uint8 read1(const uint8 *d)
 {
 	return d[0];
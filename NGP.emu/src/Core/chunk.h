@@ -29,3 +29,6 @@ bool read_SNAP(FILE *, uint32);
 bool write_header(FILE *);
 bool write_EOD(FILE *);
 bool write_SNAP(FILE *, int);
+/* bytes written by write_header, write_SNAP and write_EOD, 0 if
+   options include flash since its size isn't known in advance */
+uint32 size_snapshot(int);
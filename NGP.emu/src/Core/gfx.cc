@@ -61,35 +61,88 @@ uint8 bgc = 0, oowc = 0;
 
 uint8 negative;	//Negative / Positive switched?
 
+static GfxLineState latched =
+{
+	0, 0,
+	0, SCREEN_WIDTH,
+	0, SCREEN_HEIGHT
+};
+
+static GfxLineState lineQueue[SCREEN_HEIGHT];
+uint8 gfx_queued_lines = 0;
+static bool linesInCfb = FALSE;
+
 //=============================================================================
 
 void gfx_delayed_settings(void)
 {
 	//Window dimensions
-	winx = ram[0x8002];
-	winy = ram[0x8003];
-	winw = ram[0x8004];
-	winh = ram[0x8005];
+	latched.winx = ram[0x8002];
+	latched.winy = ram[0x8003];
+	latched.winw = ram[0x8004];
+	latched.winh = ram[0x8005];
 
 	//Scroll Planes (Confirmed delayed)
-	scroll1x = ram[0x8032];
-	scroll1y = ram[0x8033];
-	scroll2x = ram[0x8034];
-	scroll2y = ram[0x8035];
+	latched.scroll1x = ram[0x8032];
+	latched.scroll1y = ram[0x8033];
+	latched.scroll2x = ram[0x8034];
+	latched.scroll2y = ram[0x8035];
 
 	//Sprite offset (Confirmed delayed)
-	scrollsprx = ram[0x8020];
-	scrollspry = ram[0x8021];
+	latched.scrollsprx = ram[0x8020];
+	latched.scrollspry = ram[0x8021];
 
 	//Plane Priority (Confirmed delayed)
-	planeSwap = ram[0x8030] & 0x80;
+	latched.planeSwap = ram[0x8030] & 0x80;
 
 	//Background colour register (Confirmed delayed)
-	bgc = ram[0x8118];
+	latched.bgc = ram[0x8118];
 
 	//2D Control register (Confirmed delayed)
-	oowc = ram[0x8012] & 7;
-	negative = ram[0x8012] & 0x80;
+	latched.oowc = ram[0x8012] & 7;
+	latched.negative = ram[0x8012] & 0x80;
+}
+
+void gfx_queue_scanline(void)
+{
+	GfxLineState &line = lineQueue[gfx_queued_lines++];
+	line = latched;
+	line.scanline = ram[0x8009];
+	line.colour = ram[0x6F95] == 0x10;
+}
+
+void gfx_flush_scanlines(uint16* dest, uint32 pitchPixels)
+{
+	for (int i = 0; i < gfx_queued_lines; i++)
+	{
+		const GfxLineState &line = lineQueue[i];
+		scanline = line.scanline;
+		cfb_scanline = dest + (scanline * pitchPixels);
+		winx = line.winx;
+		winw = line.winw;
+		winy = line.winy;
+		winh = line.winh;
+		scroll1x = line.scroll1x;
+		scroll1y = line.scroll1y;
+		scroll2x = line.scroll2x;
+		scroll2y = line.scroll2y;
+		scrollsprx = line.scrollsprx;
+		scrollspry = line.scrollspry;
+		planeSwap = line.planeSwap;
+		bgc = line.bgc;
+		oowc = line.oowc;
+		negative = line.negative;
+		if (line.colour)	gfx_draw_scanline_colour();
+		else				gfx_draw_scanline_mono();
+	}
+	gfx_queued_lines = 0;
+	// remember if part of this frame went to cfb so the rest follows it there
+	linesInCfb = dest == cfb && ram[0x8009] < SCREEN_HEIGHT;
+}
+
+bool gfx_scanlines_in_cfb(void)
+{
+	return linesInCfb;
 }
 
 //=============================================================================
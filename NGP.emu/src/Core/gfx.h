@@ -74,6 +74,37 @@ void gfx_delayed_settings(void);
 
 //=============================================================================
 
+// Register state a scanline is drawn with, latched at H_Int
+struct GfxLineState
+{
+	uint8 scanline;
+	uint8 colour;
+	uint8 winx, winw;
+	uint8 winy, winh;
+	uint8 scroll1x, scroll1y;
+	uint8 scroll2x, scroll2y;
+	uint8 scrollsprx, scrollspry;
+	uint8 planeSwap;
+	uint8 bgc, oowc, negative;
+};
+
+// Scanlines are queued from the CPU loop and drawn in batches. Any write to
+// VRAM (0x8000-0xBFFF) flushes the queue into cfb first, so batched lines
+// always see the same VRAM contents they would have when drawn inline.
+void gfx_queue_scanline(void);
+void gfx_flush_scanlines(uint16* dest, uint32 pitchPixels);
+bool gfx_scanlines_in_cfb(void);
+
+extern uint8 gfx_queued_lines;
+
+static inline void gfx_vram_write(uint32 address)
+{
+	if (gfx_queued_lines && (address & 0xFFC000) == 0x8000)
+		gfx_flush_scanlines(cfb, SCREEN_WIDTH);
+}
+
+//=============================================================================
+
 void gfx_draw_scanline_colour(void);
 void gfx_draw_scanline_mono(void);
 
@@ -206,9 +206,7 @@ void gfx_draw_scanline_mono(void)
 	int spr, x;
 	uint16 data16;
 
-	//Get the current scanline
-	scanline = ram[0x8009];
-	cfb_scanline = cfb + (scanline * SCREEN_WIDTH);	//Calculate fast offset
+	//scanline & cfb_scanline are set by gfx_flush_scanlines()
 
 	memset(cfb_scanline, 0, SCREEN_WIDTH * sizeof(uint16));
 	memset(zbuffer, 0, SCREEN_WIDTH);
@@ -144,11 +144,10 @@ static __inline void gfx_draw(void)
 {
 	if (!frameskip_active)
 	{
-		//Draw the scanline
+		//Queue the scanline, it's drawn in gfx_flush_scanlines()
 		if (ram[0x8009] < SCREEN_HEIGHT)
 		{
-			if (ram[0x6F95] == 0x10)	gfx_draw_scanline_colour();
-			else						gfx_draw_scanline_mono();
+			gfx_queue_scanline();
 		}
 	}
 }
@@ -405,6 +405,7 @@ uint32 loadL(uint32 address)
 
 void storeB(uint32 address, uint8 data)
 {
+	gfx_vram_write(address);
 	uint8* ptr = (uint8*)translate_address_write(address);
 
 	//Write
@@ -417,6 +418,7 @@ void storeB(uint32 address, uint8 data)
 
 void storeW(uint32 address, uint16 data)
 {
+	gfx_vram_write(address);
 	uint16* ptr = (uint16*)translate_address_write(address);
 	if((ptrsize)ptr % 2 != 0)
 	{
@@ -438,6 +440,7 @@ void storeW(uint32 address, uint16 data)
 
 void storeL(uint32 address, uint32 data)
 {
+	gfx_vram_write(address);
 	uint32* ptr = (uint32*)translate_address_write(address);
 	if((ptrsize)ptr % 4 != 0)
 	{
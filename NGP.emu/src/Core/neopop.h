@@ -346,6 +346,13 @@ RomHeader;
 	bool state_restore(const char* filename);
 	bool state_store(const char* filename);
 
+/*! Same as above but using an already open stream, state_store_size()
+	returns the number of bytes state_store_fp() writes */
+
+	bool state_restore_fp(FILE *fp);
+	bool state_store_fp(FILE *fp);
+	uint32 state_store_size(void);
+
 		//=========================================
 
 /*! Reads a byte from the other system. If no data is available or no
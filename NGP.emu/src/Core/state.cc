@@ -52,6 +52,9 @@
 
 //=============================================================================
 
+/* XXX: user settable */
+#define STATE_OPTIONS OPT_ROMH
+
 static bool read_state_0050(const char* filename);
 static bool read_state_0060(const char* filename);
 
@@ -97,17 +100,12 @@ bool state_restore(const char* filename)
 bool state_store(const char* filename)
 {
 	FILE *fp;
-	int ret, options;
-
-	/* XXX: user settable */
-	options = OPT_ROMH;
+	int ret;
 	
 	if ((fp=fopen(filename, "wb")) == NULL)
 		return FALSE;
 	
-	ret = write_header(fp);
-	ret = write_SNAP(fp, options);
-	ret = write_EOD(fp);
+	ret = state_store_fp(fp);
 
 	if (fclose(fp) < 0)
 		ret = FALSE;
@@ -115,6 +113,47 @@ bool state_store(const char* filename)
 	return ret;
 }
 
+//-----------------------------------------------------------------------------
+// state_store_fp()
+//-----------------------------------------------------------------------------
+bool state_store_fp(FILE *fp)
+{
+	int ret;
+
+	ret = write_header(fp);
+	ret &= write_SNAP(fp, STATE_OPTIONS);
+	ret &= write_EOD(fp);
+
+	return ret;
+}
+
+//-----------------------------------------------------------------------------
+// state_store_size()
+//-----------------------------------------------------------------------------
+uint32 state_store_size(void)
+{
+	return size_snapshot(STATE_OPTIONS);
+}
+
+//-----------------------------------------------------------------------------
+// state_restore_fp()
+//-----------------------------------------------------------------------------
+bool state_restore_fp(FILE *fp)
+{
+	uint32 tag, size;
+
+	if (read_header(fp) != TRUE)
+		return FALSE;
+
+	if (read_chunk(fp, &tag, &size) != TRUE)
+		return FALSE;
+
+	if (tag != TAG_SNAP)
+		return FALSE;
+
+	return read_SNAP(fp, size);
+}
+
 //=============================================================================
 
 static bool read_state_0050(const char* filename)
@@ -189,27 +228,14 @@ static bool read_state_0050(const char* filename)
 static bool read_state_0060(const char* filename)
 {
 	FILE *fp;
-	uint32 tag, size;
+	bool ret;
 	
 	if ((fp=fopen(filename, "rb")) == NULL)
 		return FALSE;
 
-	if (read_header(fp) != TRUE) {
-		fclose(fp);
-		return FALSE;
-	}
-
-	if (read_chunk(fp, &tag, &size) != TRUE) {
-	    fclose(fp);
-	    return FALSE;
-	}
-
-	if (tag != TAG_SNAP) {
-	    fclose(fp);
-	    return FALSE;
-	}
-
-	return read_SNAP(fp, size);
+	ret = state_restore_fp(fp);
+	fclose(fp);
+	return ret;
 }
 
 //=============================================================================
@@ -20,8 +20,11 @@
 #include "TLCS900h_registers.h"
 #include "Z80_interface.h"
 #include "interrupt.h"
+#include "gfx.h"
 #include <emuframework/EmuApp.hh>
 #include <emuframework/EmuAppInlines.hh>
+#include <imagine/io/BufferMapIO.hh>
+#include <imagine/io/IOStream.hh>
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2018\nRobert Broglia\nwww.explusalpha.com\n\n(c) 2004\nthe NeoPop Team\nwww.nih.at";
 uint32 frameskip_active = 0;
@@ -76,6 +79,33 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 		return {};
 }
 
+size_t EmuSystem::stateDataSize()
+{
+	return state_store_size();
+}
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	BufferMapIO io;
+	io.openForWrite(data, size);
+	IOStream<BufferMapIO> stream{std::move(io), "wb"};
+	// writes are buffered, an overflow shows up when flushing
+	if(!state_store_fp(stream) || fflush(stream) != 0)
+		return makeError("State buffer too small");
+	dataSize = ftell(stream);
+	return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	BufferMapIO io;
+	io.open(data, size);
+	IOStream<BufferMapIO> stream{std::move(io), "rb"};
+	if(!state_restore_fp(stream))
+		return makeError("Invalid state data");
+	return {};
+}
+
 bool system_io_state_read(const char* filename, uchar* buffer, uint32 bufferLength)
 {
 	return readFromFile(filename, buffer, bufferLength) > 0;
@@ -163,7 +193,19 @@ void system_VBL(void)
 {
 	if(likely(emuVideo))
 	{
-		emuVideo->startFrame(srcPix);
+		if(gfx_scanlines_in_cfb())
+		{
+			// VRAM was written mid-frame, finish the frame in cfb and copy it
+			gfx_flush_scanlines(cfb, SCREEN_WIDTH);
+			emuVideo->startFrame(srcPix);
+		}
+		else
+		{
+			auto img = emuVideo->startFrame();
+			auto pix = img.pixmap();
+			gfx_flush_scanlines((uint16*)pix.pixel({}), pix.pitchPixels());
+			img.endFrame();
+		}
 		emuVideo = {};
 	}
 }
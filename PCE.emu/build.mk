@@ -39,6 +39,7 @@ mednafen/general.cpp \
 mednafen/error.cpp \
 mednafen/FileStream.cpp \
 mednafen/MemoryStream.cpp \
+mednafen/ExtMemStream.cpp \
 mednafen/Stream.cpp \
 mednafen/memory.cpp \
 mednafen/git.cpp \
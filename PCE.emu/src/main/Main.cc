@@ -25,6 +25,8 @@
 #include <mednafen/pce_fast/vdc.h>
 #include <mednafen/pce_fast/pcecd_drive.h>
 #include <mednafen/MemoryStream.h>
+#include <mednafen/ExtMemStream.h>
+#include <mednafen/state.h>
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2018\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.sourceforge.net";
 FS::PathString sysCardPath{};
@@ -116,6 +118,10 @@ FS::PathString EmuSystem::sprintStateFilename(int slot, const char *statePath, c
 	return FS::makePathStringPrintf("%s/%s.%s.nc%c", statePath, gameName, md5_context::asciistr(MDFNGameInfo->MD5, 0).c_str(), saveSlotCharPCE(slot));
 }
 
+// the state size is fixed once a game is loaded, so it's measured with a dry run
+// on the first query and afterwards taken from the last save
+static size_t stateSizeHint{};
+
 void EmuSystem::closeSystem()
 {
 	emuSys->CloseGame();
@@ -125,6 +131,7 @@ void EmuSystem::closeSystem()
 		delete CDInterfaces[0];
 		CDInterfaces.clear();
 	}
+	stateSizeHint = 0;
 }
 
 static void writeCDMD5()
@@ -420,6 +427,55 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 		return {};
 }
 
+size_t EmuSystem::stateDataSize()
+{
+	if(stateSizeHint)
+		return stateSizeHint;
+	try
+	{
+		MemoryStream sizeStream{};
+		MDFNSS_SaveSM(&sizeStream);
+		stateSizeHint = sizeStream.tell();
+		return stateSizeHint;
+	}
+	catch(std::exception &e)
+	{
+		logErr("error getting state size: %s", e.what());
+		return 0;
+	}
+}
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	try
+	{
+		ExtMemStream stream{data, size};
+		MDFNSS_SaveSM(&stream);
+		dataSize = stream.tell();
+		stateSizeHint = dataSize;
+		return {};
+	}
+	catch(std::exception &e)
+	{
+		stateSizeHint = 0;
+		return makeError("%s", e.what());
+	}
+}
+
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	try
+	{
+		ExtMemStream stream{data, size};
+		MDFNSS_LoadSM(&stream);
+		return {};
+	}
+	catch(std::exception &e)
+	{
+		return makeError("%s", e.what());
+	}
+}
+
 void EmuApp::onCustomizeNavView(EmuApp::NavView &view)
 {
 	const Gfx::LGradientStopDesc navViewGrad[] =
@@ -0,0 +1,156 @@
+/******************************************************************************/
+/* Mednafen - Multi-system Emulator                                           */
+/******************************************************************************/
+/* ExtMemStream.cpp:
+**  Copyright (C) 2012-2018 Mednafen Team
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "ExtMemStream.h"
+
+ExtMemStream::ExtMemStream(void* p, uint64 s) : data_buffer((uint8*)p), data_buffer_size(s), ro(false), position(0)
+{
+
+}
+
+ExtMemStream::ExtMemStream(const void* p, uint64 s) : data_buffer((uint8*)p), data_buffer_size(s), ro(true), position(0)
+{
+
+}
+
+ExtMemStream::~ExtMemStream()
+{
+ close();
+}
+
+uint64 ExtMemStream::attributes(void)
+{
+ return (ATTRIBUTE_READABLE | (ro ? 0 : ATTRIBUTE_WRITEABLE) | ATTRIBUTE_SEEKABLE);
+}
+
+
+uint8 *ExtMemStream::map(void) noexcept
+{
+ return data_buffer;
+}
+
+uint64 ExtMemStream::map_size(void) noexcept
+{
+ return data_buffer_size;
+}
+
+void ExtMemStream::unmap(void) noexcept
+{
+
+}
+
+uint64 ExtMemStream::read(void *data, uint64 count, bool error_on_eos)
+{
+ if(count > data_buffer_size)
+ {
+  if(error_on_eos)
+   throw MDFN_Error(0, _("Unexpected EOF"));
+
+  count = data_buffer_size;
+ }
+
+ if(position > (data_buffer_size - count))
+ {
+  if(error_on_eos)
+   throw MDFN_Error(0, _("Unexpected EOF"));
+
+  if(data_buffer_size > position)
+   count = data_buffer_size - position;
+  else
+   count = 0;
+ }
+
+ memmove(data, &data_buffer[position], count);
+ position += count;
+
+ return count;
+}
+
+void ExtMemStream::write(const void *data, uint64 count)
+{
+ if(ro)
+  throw MDFN_Error(ErrnoHolder(EINVAL));
+
+ if(count > data_buffer_size || position > (data_buffer_size - count))
+  throw MDFN_Error(ErrnoHolder(ENOSPC));
+
+ memmove(&data_buffer[position], data, count);
+ position += count;
+}
+
+void ExtMemStream::truncate(uint64 length)
+{
+ if(ro || length > data_buffer_size)
+  throw MDFN_Error(ErrnoHolder(EINVAL));
+
+ data_buffer_size = length;
+}
+
+void ExtMemStream::seek(int64 offset, int whence)
+{
+ uint64 new_position;
+
+ switch(whence)
+ {
+  default:
+	throw MDFN_Error(ErrnoHolder(EINVAL));
+	break;
+
+  case SEEK_SET:
+	new_position = offset;
+	break;
+
+  case SEEK_CUR:
+	new_position = position + offset;
+	break;
+
+  case SEEK_END:
+	new_position = data_buffer_size + offset;
+	break;
+ }
+
+ if(new_position > data_buffer_size)
+  throw MDFN_Error(ErrnoHolder(EINVAL));
+
+ position = new_position;
+}
+
+uint64 ExtMemStream::tell(void)
+{
+ return position;
+}
+
+uint64 ExtMemStream::size(void)
+{
+ return data_buffer_size;
+}
+
+void ExtMemStream::flush(void)
+{
+
+}
+
+void ExtMemStream::close(void)
+{
+ data_buffer = NULL;
+ data_buffer_size = 0;
+ position = 0;
+}
@@ -432,29 +432,61 @@ static INLINE uint8 RdOp(unsigned int A)
    redundant) on the variable "x".
 */
 
-#define RMW_A(op) {uint8 x=HU_A; op; HU_A=x; break; } /* Meh... */
-#define RMW_AB(op) {unsigned int EA; uint8 x; GetAB(EA); x=RdMem(EA); op; WrMem(EA,x); break; }
-#define RMW_ABI(reg,op) {unsigned int EA; uint8 x; GetABI(EA,reg); x=RdMem(EA); op; WrMem(EA,x); break; }
+#ifdef HUC6280_EXTRA_CRAZY
+ #define HU_OP_FIXPC()
+#else
+ #define HU_OP_FIXPC()	FixPC_PC()
+#endif
+
+#ifdef HUC6280_THREADED_DISPATCH
+ // Opcode handlers are labels reached through opTable, and each one fetches and
+ // jumps to the next handler itself, falling back to the loop in HuC6280_Run()
+ // only when an IRQ is pending or the next event is due.
+ #define HU_OP(n)		op_##n:
+ #define HU_OP_DEFAULT		op_default:
+ #define HU_OP_END_DEFAULT	{ HU_OP_FIXPC();							\
+				  if(MDFN_LIKELY(HuCPU.timestamp < next_event && !HU_IRQlow))		\
+				  {									\
+				   HU_PI = HU_P;							\
+				   HuCPU.IRQMaskDelay = HuCPU.IRQMask;					\
+				   b1 = RdAtPC();							\
+				   ADDCYC(CycTable[b1]);						\
+				   IncPC();								\
+				   goto *opTable[b1];							\
+				  }									\
+				  goto OpDone; }
+#else
+ #define HU_OP(n)		case n:
+ #define HU_OP_DEFAULT		default:
+ #define HU_OP_END_DEFAULT	break
+#endif
+
+// End of an opcode handler, redefined by huc6280_ops.inc around SET's nested switch
+#define HU_OP_END		HU_OP_END_DEFAULT
+
+#define RMW_A(op) {uint8 x=HU_A; op; HU_A=x; HU_OP_END; } /* Meh... */
+#define RMW_AB(op) {unsigned int EA; uint8 x; GetAB(EA); x=RdMem(EA); op; WrMem(EA,x); HU_OP_END; }
+#define RMW_ABI(reg,op) {unsigned int EA; uint8 x; GetABI(EA,reg); x=RdMem(EA); op; WrMem(EA,x); HU_OP_END; }
 #define RMW_ABX(op)	RMW_ABI(HU_X,op)
 #define RMW_ABY(op)	RMW_ABI(HU_Y,op)
-#define RMW_IND(op) { unsigned int EA; uint8 x; GetIND(EA); x = RdMem(EA); op; WrMem(EA, x); break; }
-#define RMW_IX(op)  { unsigned int EA; uint8 x; GetIX(EA); x=RdMem(EA); op; WrMem(EA,x); break; }
-#define RMW_IY(op)  { unsigned int EA; uint8 x; GetIY(EA); x=RdMem(EA); op; WrMem(EA,x); break; }
-#define RMW_ZP(op)  { uint8 EA; uint8 x; GetZP(EA); x=HU_Page1[EA]; op; HU_Page1[EA] = x; break; }
-#define RMW_ZPX(op) { uint8 EA; uint8 x; GetZPI(EA,HU_X); x=HU_Page1[EA]; op; HU_Page1[EA] = x; break;}
-
-#define LD_IM(op)	{ uint8 x; x=RdAtPC(); IncPC(); op; break; }
-#define LD_ZP(op)	{ uint8 EA; uint8 x; GetZP(EA); x=HU_Page1[EA]; op; break; }
-#define LD_ZPX(op) 	{ uint8 EA; uint8 x; GetZPI(EA,HU_X); x=HU_Page1[EA]; op; break; }
-#define LD_ZPY(op)  	{ uint8 EA; uint8 x; GetZPI(EA,HU_Y); x=HU_Page1[EA]; op; break; }
-#define LD_AB(op)	{ unsigned int EA; uint8 x; GetAB(EA); x=RdMem(EA); op; break; }
-#define LD_ABI(reg,op)  { unsigned int EA; uint8 x; GetABI(EA,reg); x=RdMem(EA); op; break; }
+#define RMW_IND(op) { unsigned int EA; uint8 x; GetIND(EA); x = RdMem(EA); op; WrMem(EA, x); HU_OP_END; }
+#define RMW_IX(op)  { unsigned int EA; uint8 x; GetIX(EA); x=RdMem(EA); op; WrMem(EA,x); HU_OP_END; }
+#define RMW_IY(op)  { unsigned int EA; uint8 x; GetIY(EA); x=RdMem(EA); op; WrMem(EA,x); HU_OP_END; }
+#define RMW_ZP(op)  { uint8 EA; uint8 x; GetZP(EA); x=HU_Page1[EA]; op; HU_Page1[EA] = x; HU_OP_END; }
+#define RMW_ZPX(op) { uint8 EA; uint8 x; GetZPI(EA,HU_X); x=HU_Page1[EA]; op; HU_Page1[EA] = x; HU_OP_END;}
+
+#define LD_IM(op)	{ uint8 x; x=RdAtPC(); IncPC(); op; HU_OP_END; }
+#define LD_ZP(op)	{ uint8 EA; uint8 x; GetZP(EA); x=HU_Page1[EA]; op; HU_OP_END; }
+#define LD_ZPX(op) 	{ uint8 EA; uint8 x; GetZPI(EA,HU_X); x=HU_Page1[EA]; op; HU_OP_END; }
+#define LD_ZPY(op)  	{ uint8 EA; uint8 x; GetZPI(EA,HU_Y); x=HU_Page1[EA]; op; HU_OP_END; }
+#define LD_AB(op)	{ unsigned int EA; uint8 x; GetAB(EA); x=RdMem(EA); op; HU_OP_END; }
+#define LD_ABI(reg,op)  { unsigned int EA; uint8 x; GetABI(EA,reg); x=RdMem(EA); op; HU_OP_END; }
 #define LD_ABX(op)	LD_ABI(HU_X,op)
 #define LD_ABY(op)	LD_ABI(HU_Y,op)
 
-#define LD_IND(op)	{ unsigned int EA; uint8 x; GetIND(EA); x=RdMem(EA); op; break; }
-#define LD_IX(op)	{ unsigned int EA; uint8 x; GetIX(EA); x=RdMem(EA); op; break; }
-#define LD_IY(op)	{ unsigned int EA; uint8 x; GetIY(EA); x=RdMem(EA); op; break; }
+#define LD_IND(op)	{ unsigned int EA; uint8 x; GetIND(EA); x=RdMem(EA); op; HU_OP_END; }
+#define LD_IX(op)	{ unsigned int EA; uint8 x; GetIX(EA); x=RdMem(EA); op; HU_OP_END; }
+#define LD_IY(op)	{ unsigned int EA; uint8 x; GetIY(EA); x=RdMem(EA); op; HU_OP_END; }
 
 #define BMT_PREHONK(pork) HuCPU.in_block_move = IBM_##pork;
 #define BMT_HONKHONK(pork) if(HuCPU.timestamp >= next_user_event) goto GetOutBMT; continue_the_##pork:
@@ -466,19 +498,19 @@ static INLINE uint8 RdOp(unsigned int A)
 #define BMT_TIN BMT_PREHONK(TIN); do { ADDCYC(6); WrMem(HuCPU.bmt_dest, RdMem(HuCPU.bmt_src)); HuCPU.bmt_src++; BMT_HONKHONK(TIN); HuCPU.bmt_length--; } while(HuCPU.bmt_length);
 
 // Block memory transfer load
-#define LD_BMT(op)	{ PUSH(HU_Y); PUSH(HU_A); PUSH(HU_X); GetAB(HuCPU.bmt_src); GetAB(HuCPU.bmt_dest); GetAB(HuCPU.bmt_length); op; HuCPU.in_block_move = 0; HU_X = POP(); HU_A = POP(); HU_Y = POP(); break; }
+#define LD_BMT(op)	{ PUSH(HU_Y); PUSH(HU_A); PUSH(HU_X); GetAB(HuCPU.bmt_src); GetAB(HuCPU.bmt_dest); GetAB(HuCPU.bmt_length); op; HuCPU.in_block_move = 0; HU_X = POP(); HU_A = POP(); HU_Y = POP(); HU_OP_END; }
 
-#define ST_ZP(r)	{uint8 EA; GetZP(EA); HU_Page1[EA] = r; break;}
-#define ST_ZPX(r)	{uint8 EA; GetZPI(EA,HU_X); HU_Page1[EA] = r; break;}
-#define ST_ZPY(r)	{uint8 EA; GetZPI(EA,HU_Y); HU_Page1[EA] = r; break;}
-#define ST_AB(r)	{unsigned int EA; GetAB(EA); WrMem(EA, r); break;}
-#define ST_ABI(reg,r)	{unsigned int EA; GetABI(EA,reg); WrMem(EA,r); break; }
+#define ST_ZP(r)	{uint8 EA; GetZP(EA); HU_Page1[EA] = r; HU_OP_END;}
+#define ST_ZPX(r)	{uint8 EA; GetZPI(EA,HU_X); HU_Page1[EA] = r; HU_OP_END;}
+#define ST_ZPY(r)	{uint8 EA; GetZPI(EA,HU_Y); HU_Page1[EA] = r; HU_OP_END;}
+#define ST_AB(r)	{unsigned int EA; GetAB(EA); WrMem(EA, r); HU_OP_END;}
+#define ST_ABI(reg,r)	{unsigned int EA; GetABI(EA,reg); WrMem(EA,r); HU_OP_END; }
 #define ST_ABX(r)	ST_ABI(HU_X,r)
 #define ST_ABY(r)	ST_ABI(HU_Y,r)
 
-#define ST_IND(r)	{unsigned int EA; GetIND(EA); WrMem(EA,r); break; }
-#define ST_IX(r)	{unsigned int EA; GetIX(EA); WrMem(EA,r); break; }
-#define ST_IY(r)	{unsigned int EA; GetIY(EA); WrMem(EA,r); break; }
+#define ST_IND(r)	{unsigned int EA; GetIND(EA); WrMem(EA,r); HU_OP_END; }
+#define ST_IX(r)	{unsigned int EA; GetIX(EA); WrMem(EA,r); HU_OP_END; }
+#define ST_IY(r)	{unsigned int EA; GetIY(EA); WrMem(EA,r); HU_OP_END; }
 
 static const uint8 CycTable[256] =
 {                             
@@ -619,6 +651,44 @@ void HuC6280_Run(int32 cycles)
 
 	int32 next_event;
 
+	#ifdef HUC6280_THREADED_DISPATCH
+	static const void * const opTable[256] =
+	{
+	  &&op_0x00, &&op_0x01, &&op_0x02, &&op_0x03, &&op_0x04, &&op_0x05, &&op_0x06, &&op_0x07,
+	  &&op_0x08, &&op_0x09, &&op_0x0A, &&op_default, &&op_0x0C, &&op_0x0D, &&op_0x0E, &&op_0x0F,
+	  &&op_0x10, &&op_0x11, &&op_0x12, &&op_0x13, &&op_0x14, &&op_0x15, &&op_0x16, &&op_0x17,
+	  &&op_0x18, &&op_0x19, &&op_0x1A, &&op_default, &&op_0x1C, &&op_0x1D, &&op_0x1E, &&op_0x1F,
+	  &&op_0x20, &&op_0x21, &&op_0x22, &&op_0x23, &&op_0x24, &&op_0x25, &&op_0x26, &&op_0x27,
+	  &&op_0x28, &&op_0x29, &&op_0x2A, &&op_default, &&op_0x2C, &&op_0x2D, &&op_0x2E, &&op_0x2F,
+	  &&op_0x30, &&op_0x31, &&op_0x32, &&op_default, &&op_0x34, &&op_0x35, &&op_0x36, &&op_0x37,
+	  &&op_0x38, &&op_0x39, &&op_0x3A, &&op_default, &&op_0x3C, &&op_0x3D, &&op_0x3E, &&op_0x3F,
+	  &&op_0x40, &&op_0x41, &&op_0x42, &&op_0x43, &&op_0x44, &&op_0x45, &&op_0x46, &&op_0x47,
+	  &&op_0x48, &&op_0x49, &&op_0x4A, &&op_default, &&op_0x4C, &&op_0x4D, &&op_0x4E, &&op_0x4F,
+	  &&op_0x50, &&op_0x51, &&op_0x52, &&op_0x53, &&op_0x54, &&op_0x55, &&op_0x56, &&op_0x57,
+	  &&op_0x58, &&op_0x59, &&op_0x5A, &&op_default, &&op_default, &&op_0x5D, &&op_0x5E, &&op_0x5F,
+	  &&op_0x60, &&op_0x61, &&op_0x62, &&op_default, &&op_0x64, &&op_0x65, &&op_0x66, &&op_0x67,
+	  &&op_0x68, &&op_0x69, &&op_0x6A, &&op_default, &&op_0x6C, &&op_0x6D, &&op_0x6E, &&op_0x6F,
+	  &&op_0x70, &&op_0x71, &&op_0x72, &&op_0x73, &&op_0x74, &&op_0x75, &&op_0x76, &&op_0x77,
+	  &&op_0x78, &&op_0x79, &&op_0x7A, &&op_default, &&op_0x7C, &&op_0x7D, &&op_0x7E, &&op_0x7F,
+	  &&op_0x80, &&op_0x81, &&op_0x82, &&op_0x83, &&op_0x84, &&op_0x85, &&op_0x86, &&op_0x87,
+	  &&op_0x88, &&op_0x89, &&op_0x8A, &&op_default, &&op_0x8C, &&op_0x8D, &&op_0x8E, &&op_0x8F,
+	  &&op_0x90, &&op_0x91, &&op_0x92, &&op_0x93, &&op_0x94, &&op_0x95, &&op_0x96, &&op_0x97,
+	  &&op_0x98, &&op_0x99, &&op_0x9A, &&op_default, &&op_0x9C, &&op_0x9D, &&op_0x9E, &&op_0x9F,
+	  &&op_0xA0, &&op_0xA1, &&op_0xA2, &&op_0xA3, &&op_0xA4, &&op_0xA5, &&op_0xA6, &&op_0xa7,
+	  &&op_0xA8, &&op_0xA9, &&op_0xAA, &&op_default, &&op_0xAC, &&op_0xAD, &&op_0xAE, &&op_0xAF,
+	  &&op_0xB0, &&op_0xB1, &&op_0xB2, &&op_0xB3, &&op_0xB4, &&op_0xB5, &&op_0xB6, &&op_0xb7,
+	  &&op_0xB8, &&op_0xB9, &&op_0xBA, &&op_default, &&op_0xBC, &&op_0xBD, &&op_0xBE, &&op_0xBF,
+	  &&op_0xC0, &&op_0xC1, &&op_0xC2, &&op_0xC3, &&op_0xC4, &&op_0xC5, &&op_0xC6, &&op_0xc7,
+	  &&op_0xC8, &&op_0xC9, &&op_0xCA, &&op_default, &&op_0xCC, &&op_0xCD, &&op_0xCE, &&op_0xCF,
+	  &&op_0xD0, &&op_0xD1, &&op_0xD2, &&op_0xD3, &&op_0xD4, &&op_0xD5, &&op_0xD6, &&op_0xd7,
+	  &&op_0xD8, &&op_0xD9, &&op_0xDA, &&op_default, &&op_default, &&op_0xDD, &&op_0xDE, &&op_0xDF,
+	  &&op_0xE0, &&op_0xE1, &&op_default, &&op_0xE3, &&op_0xE4, &&op_0xE5, &&op_0xE6, &&op_0xe7,
+	  &&op_0xE8, &&op_0xE9, &&op_0xEA, &&op_default, &&op_0xEC, &&op_0xED, &&op_0xEE, &&op_0xEF,
+	  &&op_0xF0, &&op_0xF1, &&op_0xF2, &&op_0xF3, &&op_0xF4, &&op_0xF5, &&op_0xF6, &&op_0xf7,
+	  &&op_0xF8, &&op_0xF9, &&op_0xFA, &&op_default, &&op_0xFC, &&op_0xFD, &&op_0xFE, &&op_0xFF,
+	};
+	#endif
+
 	if(HuCPU.in_block_move)
 	{
          next_event = (next_user_event < HuCPU.timer_next_timestamp) ? next_user_event : HuCPU.timer_next_timestamp;
@@ -689,6 +759,13 @@ void HuC6280_Run(int32 cycles)
 
 	  IncPC();
 
+	  #ifdef HUC6280_THREADED_DISPATCH
+	  goto *opTable[b1];
+	  {
+	   #include "huc6280_ops.inc"
+	  }
+	  OpDone: ;
+	  #else
           switch(b1)
           {
            #include "huc6280_ops.inc"
@@ -697,6 +774,7 @@ void HuC6280_Run(int32 cycles)
 	  #ifndef HUC6280_EXTRA_CRAZY
  	  FixPC_PC();
 	  #endif
+	  #endif
 	 }	// end while(HuCPU.timestamp < next_event)
 
 	 while(HuCPU.timestamp >= HuCPU.timer_next_timestamp)
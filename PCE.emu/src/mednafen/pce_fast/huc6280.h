@@ -5,6 +5,12 @@
 
 #define HUC6280_LAZY_FLAGS
 
+// Dispatch opcodes through a table of label addresses (GCC/Clang extension)
+// instead of a switch, with the fetch of the next opcode replicated into each handler
+#if defined(__GNUC__) && !defined(HUC6280_NO_THREADED_DISPATCH)
+#define HUC6280_THREADED_DISPATCH
+#endif
+
 namespace PCE_Fast
 {
 
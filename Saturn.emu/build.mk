@@ -10,6 +10,11 @@ ifeq ($(SUBARCH), armv6)
  android_cpuFlags = -marm -march=armv7-a -mfloat-abi=softfp -mfpu=vfp
 endif
 
+# scsp2.c can run the SCSP & its 68K on a separate thread, chosen at runtime
+# with the SCSP Thread system option, set threadedSCSP := 0 to build the
+# original single-threaded scsp.c instead
+threadedSCSP ?= 1
+
 ifneq ($(config_compiler),clang)
  CFLAGS_OPTIMIZE_RELEASE_DEFAULT += -O3 -fno-tree-vectorize
 endif
@@ -84,16 +89,29 @@ yabause/vdp2debug.c \
 yabause/vidshared.c \
 yabause/vidsoft.c \
 yabause/yabause.c \
-yabause/scsp.c \
 yabause/japmodem.c
 
+ifeq ($(threadedSCSP), 1)
+ CPPFLAGS += -DUSE_SCSP2=1
+ SRC += yabause/scsp2.c
+else
+ SRC += yabause/scsp.c
+endif
+
 #SRC += yabause/c68k/c68kexec.c yabause/c68k/c68k.c yabause/m68kc68k.c
 #CPPFLAGS += -DHAVE_C68K=1
 SRC += yabause/q68/q68.c \
 yabause/q68/q68-core.c \
 yabause/m68kq68.c
 CPPFLAGS += -DHAVE_Q68=1
-# TODO: -DQ68_USE_JIT=1
+# Q68 only has x86/x64 (and PSP) translators, other archs use the interpreter
+ifeq ($(ARCH), x86_64)
+ CPPFLAGS += -DQ68_USE_JIT=1 -DCPU_X64=1
+ SRC += yabause/q68/q68-jit.c yabause/q68/q68-jit-x86.S
+else ifeq ($(ARCH), x86)
+ CPPFLAGS += -DQ68_USE_JIT=1
+ SRC += yabause/q68/q68-jit.c yabause/q68/q68-jit-x86.S
+endif
 
 include $(EMUFRAMEWORK_PATH)/package/emuframework.mk
 
@@ -31,6 +31,20 @@ class CustomSystemOptionView : public SystemOptionView
 		string_printf(str, "BIOS: %s", strlen(::biosPath.data()) ? FS::basename(::biosPath).data() : "None set");
 	}
 
+	#ifdef USE_SCSP2
+	BoolMenuItem scspThread
+	{
+		"SCSP Thread",
+		(bool)optionSCSPThread,
+		[this](BoolMenuItem &item, View &, Input::Event e)
+		{
+			optionSCSPThread = item.flipBoolValue(*this);
+			if(EmuSystem::gameIsRunning())
+				EmuApp::postMessage("Takes effect on next game load");
+		}
+	};
+	#endif
+
 	StaticArrayList<TextMenuItem, MAX_SH2_CORES> sh2CoreItem{};
 
 	MultiChoiceMenuItem sh2Core
@@ -66,6 +80,9 @@ public:
 			}
 			item.emplace_back(&sh2Core);
 		}
+		#ifdef USE_SCSP2
+		item.emplace_back(&scspThread);
+		#endif
 		printBiosMenuEntryStr(biosPathStr);
 		item.emplace_back(&biosPath);
 	}
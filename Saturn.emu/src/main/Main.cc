@@ -2,7 +2,16 @@
 #define LOGTAG "main"
 #include <emuframework/EmuApp.hh>
 #include <emuframework/EmuAppInlines.hh>
+#include <imagine/io/BufferMapIO.hh>
+#include <imagine/io/IOStream.hh>
 #include "internal.hh"
+#include <algorithm>
+#ifdef USE_SCSP2
+#include <imagine/thread/Thread.hh>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
+#endif
 
 extern "C"
 {
@@ -16,6 +25,10 @@ extern "C"
 	#include <yabause/cdbase.h>
 	#include <yabause/cs0.h>
 	#include <yabause/cs2.h>
+	#include <yabause/memory.h>
+	#ifdef USE_SCSP2
+	#include <yabause/threads.h>
+	#endif
 }
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2012-2018\nRobert Broglia\nwww.explusalpha.com\n\n(c) 2012 the\nYabause Team\nyabause.org";
@@ -69,6 +82,109 @@ static void mergeSamplesToStereo(s32 srcL, s32 srcR, s16 *dst)
 	else *dst = srcR;
 }
 
+#ifdef USE_SCSP2
+// scsp2.c may generate audio on its own thread, so samples are staged here
+// and handed to EmuSystem::writeSound() from the emulation thread in runFrame()
+static constexpr uint audioStagingFrames = 8192; // power of 2
+static s16 audioStagingBuff[audioStagingFrames * 2];
+static std::atomic_uint audioStagingWritePos{}, audioStagingReadPos{};
+
+static void SNDImagineUpdateAudioStaged(u32 *leftchanbuffer, u32 *rightchanbuffer, u32 frames)
+{
+	uint writePos = audioStagingWritePos.load(std::memory_order_relaxed);
+	uint freeFrames = audioStagingFrames - (writePos - audioStagingReadPos.load(std::memory_order_acquire));
+	if(unlikely(frames > freeFrames))
+	{
+		logMsg("audio staging overrun, dropping %u frames", frames - freeFrames);
+		frames = freeFrames;
+	}
+	iterateTimes(frames, i)
+	{
+		mergeSamplesToStereo(leftchanbuffer[i], rightchanbuffer[i],
+			&audioStagingBuff[((writePos + i) % audioStagingFrames) * 2]);
+	}
+	audioStagingWritePos.store(writePos + frames, std::memory_order_release);
+}
+
+static void writeStagedAudio(bool renderAudio)
+{
+	uint readPos = audioStagingReadPos.load(std::memory_order_relaxed);
+	uint frames = audioStagingWritePos.load(std::memory_order_acquire) - readPos;
+	if(!frames)
+		return;
+	if(renderAudio)
+	{
+		uint start = readPos % audioStagingFrames;
+		uint firstFrames = std::min(frames, audioStagingFrames - start);
+		EmuSystem::writeSound(&audioStagingBuff[start * 2], firstFrames);
+		if(frames > firstFrames)
+			EmuSystem::writeSound(audioStagingBuff, frames - firstFrames);
+	}
+	audioStagingReadPos.store(readPos + frames, std::memory_order_release);
+}
+
+// Thread support for scsp2.c (only YAB_THREAD_SCSP is used)
+static IG::thread *yabThread[YAB_NUM_THREADS]{};
+static std::mutex yabThreadMutex[YAB_NUM_THREADS];
+static std::condition_variable yabThreadCond[YAB_NUM_THREADS];
+static bool yabThreadWakePending[YAB_NUM_THREADS]{};
+static thread_local int currentYabThread = -1;
+
+CLINK int YabThreadStart(unsigned int id, void (*func)(void *), void *arg)
+{
+	if(yabThread[id])
+	{
+		logErr("thread %u is already started", id);
+		return -1;
+	}
+	yabThreadWakePending[id] = false;
+	yabThread[id] = new IG::thread
+	{
+		[id, func, arg]()
+		{
+			currentYabThread = id;
+			func(arg);
+		}
+	};
+	return 0;
+}
+
+CLINK void YabThreadWait(unsigned int id)
+{
+	if(!yabThread[id])
+		return;
+	yabThread[id]->join();
+	delete yabThread[id];
+	yabThread[id] = nullptr;
+}
+
+CLINK void YabThreadYield()
+{
+	std::this_thread::yield();
+}
+
+CLINK void YabThreadSleep()
+{
+	assumeExpr(currentYabThread != -1);
+	auto id = currentYabThread;
+	std::unique_lock<std::mutex> lock{yabThreadMutex[id]};
+	yabThreadCond[id].wait(lock, [id](){ return yabThreadWakePending[id]; });
+	yabThreadWakePending[id] = false;
+}
+
+CLINK void YabThreadRemoteSleep(unsigned int id) {}
+
+CLINK void YabThreadWake(unsigned int id)
+{
+	if(!yabThread[id])
+		return;
+	{
+		std::lock_guard<std::mutex> lock{yabThreadMutex[id]};
+		yabThreadWakePending[id] = true;
+	}
+	yabThreadCond[id].notify_one();
+}
+#else
 static void SNDImagineUpdateAudioNull(u32 *leftchanbuffer, u32 *rightchanbuffer, u32 frames) { }
 
 static void SNDImagineUpdateAudio(u32 *leftchanbuffer, u32 *rightchanbuffer, u32 frames)
@@ -81,6 +197,7 @@ static void SNDImagineUpdateAudio(u32 *leftchanbuffer, u32 *rightchanbuffer, u32
 	}
 	EmuSystem::writeSound(sample, frames);
 }
+#endif
 
 static u32 SNDImagineGetAudioSpace()
 {
@@ -96,7 +213,11 @@ static SoundInterface_struct SNDImagine =
 	SNDImagineDeInit,
 	SNDImagineReset,
 	SNDImagineChangeVideoFormat,
+	#ifdef USE_SCSP2
+	SNDImagineUpdateAudioStaged,
+	#else
 	SNDImagineUpdateAudio,
+	#endif
 	SNDImagineGetAudioSpace,
 	SNDImagineMuteAudio,
 	SNDImagineUnMuteAudio,
@@ -264,6 +385,52 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 		return EmuSystem::makeFileReadError();
 }
 
+static bool saveStateToBuffer(void *data, size_t size, size_t &dataSize)
+{
+	BufferMapIO io;
+	io.openForWrite(data, size);
+	IOStream<BufferMapIO> stream{std::move(io), "wb"};
+	// writes are buffered, an overflow shows up when flushing
+	if(YabSaveStateStream(stream) != 0 || fflush(stream) != 0)
+		return false;
+	dataSize = ftell(stream);
+	return true;
+}
+
+// the state size depends on the current video mode due to the embedded
+// preview image, measuring it would mean running a save, so estimate it
+// from the last one
+static constexpr size_t DEFAULT_STATE_SIZE_HINT = 4 * 1024 * 1024;
+static constexpr size_t MAX_STATE_SIZE_HINT = 64 * 1024 * 1024;
+static size_t stateSizeHint = DEFAULT_STATE_SIZE_HINT;
+
+size_t EmuSystem::stateDataSize()
+{
+	return stateSizeHint;
+}
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	if(!saveStateToBuffer(data, size, dataSize))
+	{
+		stateSizeHint = std::min(std::max(stateSizeHint, size * 2), MAX_STATE_SIZE_HINT);
+		return makeError("State buffer too small");
+	}
+	// leave room for a larger preview image from a video mode change
+	stateSizeHint = dataSize + dataSize / 4;
+	return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	BufferMapIO io;
+	io.open(data, size);
+	IOStream<BufferMapIO> stream{std::move(io), "rb"};
+	if(YabLoadStateStream(stream, nullptr) != 0)
+		return makeError("Invalid state data");
+	return {};
+}
+
 void EmuSystem::saveBackupMem() // for manually saving when not closing game
 {
 	if(gameIsRunning())
@@ -287,6 +454,11 @@ void EmuSystem::closeSystem()
 EmuSystem::Error EmuSystem::loadGame(IO &, OnLoadProgressDelegate)
 {
 	string_printf(bupPath, "%s/bkram.bin", savePath());
+	#ifdef USE_SCSP2
+	// only read by YabauseInit(), so changes apply on the next game load
+	yinit.usethreads = (bool)optionSCSPThread;
+	audioStagingReadPos = audioStagingWritePos.load();
+	#endif
 	if(YabauseInit(&yinit) != 0)
 	{
 		logErr("YabauseInit failed");
@@ -311,8 +483,13 @@ void EmuSystem::configAudioRate(double frameTime, int rate)
 void EmuSystem::runFrame(EmuVideo *video, bool renderAudio)
 {
 	emuVideo = video;
+	#ifdef USE_SCSP2
+	YabauseEmulate();
+	writeStagedAudio(renderAudio);
+	#else
 	SNDImagine.UpdateAudio = renderAudio ? SNDImagineUpdateAudio : SNDImagineUpdateAudioNull;
 	YabauseEmulate();
+	#endif
 }
 
 void EmuApp::onCustomizeNavView(EmuApp::NavView &view)
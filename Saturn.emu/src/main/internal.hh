@@ -15,6 +15,9 @@ static const uint gamepadKeys = 23;
 }
 
 extern Byte1Option optionSH2Core;
+#ifdef USE_SCSP2
+extern Byte1Option optionSCSPThread;
+#endif
 extern FS::PathString biosPath;
 extern SH2Interface_struct *SH2CoreList[];
 extern uint SH2Cores;
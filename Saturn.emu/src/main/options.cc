@@ -8,7 +8,8 @@ extern "C"
 
 enum
 {
-	CFGKEY_BIOS_PATH = 279, CFGKEY_SH2_CORE = 280
+	CFGKEY_BIOS_PATH = 279, CFGKEY_SH2_CORE = 280,
+	CFGKEY_SCSP_THREAD = 281
 };
 
 SH2Interface_struct *SH2CoreList[]
@@ -38,6 +39,9 @@ static bool OptionSH2CoreIsValid(uint8 val)
 const char *EmuSystem::configFilename = "SaturnEmu.config";
 static PathOption optionBiosPath{CFGKEY_BIOS_PATH, biosPath, ""};
 Byte1Option optionSH2Core{CFGKEY_SH2_CORE, (uchar)defaultSH2CoreID, false, OptionSH2CoreIsValid};
+#ifdef USE_SCSP2
+Byte1Option optionSCSPThread{CFGKEY_SCSP_THREAD, 0, false, optionIsValidWithMax<1>};
+#endif
 const AspectRatioInfo EmuSystem::aspectRatioInfo[] =
 {
 		{"4:3 (Original)", 4, 3},
@@ -70,6 +74,9 @@ bool EmuSystem::readConfig(IO &io, uint key, uint readSize)
 		default: return 0;
 		bcase CFGKEY_BIOS_PATH: optionBiosPath.readFromIO(io, readSize);
 		bcase CFGKEY_SH2_CORE: optionSH2Core.readFromIO(io, readSize);
+		#ifdef USE_SCSP2
+		bcase CFGKEY_SCSP_THREAD: optionSCSPThread.readFromIO(io, readSize);
+		#endif
 	}
 	return 1;
 }
@@ -78,4 +85,7 @@ void EmuSystem::writeConfig(IO &io)
 {
 	optionBiosPath.writeToIO(io);
 	optionSH2Core.writeWithKeyIfNotDefault(io);
+	#ifdef USE_SCSP2
+	optionSCSPThread.writeWithKeyIfNotDefault(io);
+	#endif
 }
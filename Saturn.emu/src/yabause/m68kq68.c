@@ -34,6 +34,22 @@
 # define NEED_TRAMPOLINE
 #endif
 
+/**
+ * NEED_EXEC_ALLOC:  Defined when the dynamic translator is enabled on a
+ * platform where ordinary heap memory can't be executed, so Q68 is given
+ * native code allocation functions that return pages which are made
+ * executable once each block is translated.
+ */
+#if defined(Q68_USE_JIT) && !defined(PSP)
+# define NEED_EXEC_ALLOC
+# include <stdio.h>
+# include <string.h>
+# include <sys/mman.h>
+# ifdef __APPLE__
+#  include <pthread.h>
+# endif
+#endif
+
 /**
  * PROFILE_68K: Perform simple profiling of the 68000 emulation, reporting
  * the average time per 68000 clock cycle.  (Realtime execution would be
@@ -91,6 +107,13 @@ static void writeb_trampoline(uint32_t address, uint32_t data);
 static void writew_trampoline(uint32_t address, uint32_t data);
 #endif
 
+#ifdef NEED_EXEC_ALLOC
+static void *exec_malloc(size_t size);
+static void *exec_realloc(void *ptr, size_t size);
+static void exec_free(void *ptr);
+static int exec_finish(void *ptr, size_t size);
+#endif
+
 /*-----------------------------------------------------------------------*/
 
 /* Module interface definition */
@@ -163,6 +186,10 @@ static int m68kq68_init(void)
     if (!(state = q68_create())) {
         return -1;
     }
+#ifdef NEED_EXEC_ALLOC
+    q68_set_jit_memory_funcs(state, exec_malloc, exec_realloc, exec_free,
+                             exec_finish);
+#endif
     q68_set_irq(state, 0);
     q68_set_readb_func(state, dummy_read);
     q68_set_readw_func(state, dummy_read);
@@ -520,6 +547,130 @@ static void writew_trampoline(uint32_t address, uint32_t data) {
 
 #endif  // NEED_TRAMPOLINE
 
+/*-----------------------------------------------------------------------*/
+
+#ifdef NEED_EXEC_ALLOC
+
+/* Size of the header preceding each block, holding the mapping length;
+ * keeps the returned pointer 16-byte aligned */
+#define EXEC_HEADER_SIZE  16
+
+/* Set once executable memory can't be obtained, after which no more
+ * blocks are allocated and Q68 stays in its interpreter */
+static int exec_unavailable;
+
+/**
+ * exec_set_writable:  Switch the calling thread between writing and
+ * executing MAP_JIT pages on Apple platforms that enforce it (arm64).
+ * Other platforms change the page protection in exec_finish() instead.
+ *
+ * [Parameters]
+ *     writable: Nonzero to allow writes, zero to allow execution
+ * [Return value]
+ *     None
+ */
+static void exec_set_writable(int writable)
+{
+#if defined(__APPLE__) && defined(__aarch64__)
+    pthread_jit_write_protect_np(!writable);
+#else
+    (void)writable;
+#endif
+}
+
+/**
+ * exec_malloc, exec_realloc, exec_free:  Allocate, resize, and free
+ * blocks of native code memory for Q68.  Each block is a separate
+ * anonymous mapping so exec_finish() can change its protection.  Blocks
+ * are writable until passed to exec_finish().  On Apple platforms the
+ * hardened runtime only allows executable anonymous memory mapped with
+ * MAP_JIT, so blocks are mapped that way instead.
+ *
+ * [Parameters]
+ *      ptr: Block to resize or free (exec_realloc and exec_free only)
+ *     size: Requested block size in bytes
+ * [Return value]
+ *     Pointer to the block, or NULL on error (exec_free returns nothing)
+ */
+
+static void *exec_malloc(size_t size)
+{
+    if (exec_unavailable) {
+        return NULL;
+    }
+    const size_t map_size = size + EXEC_HEADER_SIZE;
+#ifdef __APPLE__
+    uint8_t *base = mmap(NULL, map_size, PROT_READ | PROT_WRITE | PROT_EXEC,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_JIT, -1, 0);
+#else
+    uint8_t *base = mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#endif
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Q68: can't map code memory, using the interpreter\n");
+        exec_unavailable = 1;
+        return NULL;
+    }
+    exec_set_writable(1);
+    *(size_t *)base = map_size;
+    return base + EXEC_HEADER_SIZE;
+}
+
+static void *exec_realloc(void *ptr, size_t size)
+{
+    if (!ptr) {
+        return exec_malloc(size);
+    }
+    const size_t old_size =
+        *(size_t *)((uint8_t *)ptr - EXEC_HEADER_SIZE) - EXEC_HEADER_SIZE;
+    void *new_ptr = exec_malloc(size);
+    if (!new_ptr) {
+        return NULL;
+    }
+    memcpy(new_ptr, ptr, old_size < size ? old_size : size);
+    exec_free(ptr);
+    return new_ptr;
+}
+
+static void exec_free(void *ptr)
+{
+    if (ptr) {
+        uint8_t *base = (uint8_t *)ptr - EXEC_HEADER_SIZE;
+        munmap(base, *(size_t *)base);
+    }
+}
+
+/*-----------------------------------------------------------------------*/
+
+/**
+ * exec_finish:  Make a translated block executable, after which it is no
+ * longer written to.
+ *
+ * [Parameters]
+ *      ptr: Block returned by exec_malloc() or exec_realloc()
+ *     size: Block size in bytes
+ * [Return value]
+ *     Nonzero on success, zero on error
+ */
+static int exec_finish(void *ptr, size_t size)
+{
+    (void)size;
+#ifdef __APPLE__
+    (void)ptr;
+    exec_set_writable(0);
+#else
+    uint8_t *base = (uint8_t *)ptr - EXEC_HEADER_SIZE;
+    if (mprotect(base, *(size_t *)base, PROT_READ | PROT_EXEC) != 0) {
+        fprintf(stderr, "Q68: can't make code executable, using the interpreter\n");
+        exec_unavailable = 1;
+        return 0;
+    }
+#endif
+    return 1;
+}
+
+#endif  // NEED_EXEC_ALLOC
+
 /*************************************************************************/
 /*************************************************************************/
 
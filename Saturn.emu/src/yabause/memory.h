@@ -404,6 +404,9 @@ void FormatBackupRam(void *mem, u32 size);
 
 int YabSaveState(const char *filename);
 int YabLoadState(const char *filename);
+// same as above using an already open stream, movieFilename can be NULL to skip movie data
+int YabSaveStateStream(FILE *fp);
+int YabLoadStateStream(FILE *fp, const char *movieFilename);
 int YabSaveStateSlot(const char *dirpath, u8 slot);
 int YabLoadStateSlot(const char *dirpath, u8 slot);
 
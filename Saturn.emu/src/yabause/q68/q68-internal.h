@@ -236,6 +236,16 @@ struct Q68State_ {
     /* Buffer for tracking translated code blocks */
     uint8_t jit_pages[1<<(24-(Q68_JIT_PAGE_BITS+3))];
 
+    /* q68_jit_clear_write(), called through this pointer by translated
+     * code so the native code stays position-independent */
+    void (*jit_clear_write)(Q68State *state, uint32_t address, uint32_t size);
+
+    /* Native code memory functions (see q68_set_jit_memory_funcs()) */
+    void *(*jit_code_malloc)(size_t size);
+    void *(*jit_code_realloc)(void *ptr, size_t size);
+    void (*jit_code_free)(void *ptr);
+    int (*jit_code_finish)(void *ptr, size_t size);
+
 };
 
 /*-----------------------------------------------------------------------*/
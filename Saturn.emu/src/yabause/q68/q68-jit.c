@@ -422,6 +422,14 @@ int q68_jit_init(Q68State *state)
     /* Default to no cache flush function */
     state->jit_flush   = NULL;
 
+    state->jit_clear_write = q68_jit_clear_write;
+
+    /* Default to allocating native code like any other data */
+    state->jit_code_malloc  = state->malloc_func;
+    state->jit_code_realloc = state->realloc_func;
+    state->jit_code_free    = state->free_func;
+    state->jit_code_finish  = NULL;
+
 #ifdef Q68_DISABLE_ADDRESS_ERROR
     /* Hack to avoid compiler warnings about unused functions */
     if (0) {
@@ -595,7 +603,7 @@ Q68JitEntry *q68_jit_translate(Q68State *state, uint32_t address)
 
     /* Initialize the new entry */
 
-    current_entry->native_code = state->malloc_func(Q68_JIT_BLOCK_EXPAND_SIZE);
+    current_entry->native_code = state->jit_code_malloc(Q68_JIT_BLOCK_EXPAND_SIZE);
     if (!current_entry->native_code) {
         DMSG("No memory for code at $%06X", address);
         current_entry = NULL;
@@ -663,13 +671,22 @@ Q68JitEntry *q68_jit_translate(Q68State *state, uint32_t address)
     ) {
         JIT_PAGE_SET(state, index);
     }
-    void *newptr = state->realloc_func(current_entry->native_code,
-                                       current_entry->native_length);
+    void *newptr = state->jit_code_realloc(current_entry->native_code,
+                                           current_entry->native_length);
     if (newptr) {
         current_entry->native_code = newptr;
         current_entry->native_size = current_entry->native_length;
     }
     state->jit_total_data += current_entry->native_size;
+    if (state->jit_code_finish
+     && !state->jit_code_finish(current_entry->native_code,
+                                current_entry->native_size)
+    ) {
+        DMSG("Failed to finish code at $%06X", address);
+        clear_entry(state, current_entry);
+        current_entry = NULL;
+        return NULL;
+    }
     /* Prepare the block for execution so it can be immediately passed to
      * q68_jit_run() (see q68_jit_find() for why we do it here) */
     current_entry->exec_address = current_entry->native_code;
@@ -1079,7 +1096,7 @@ static void clear_entry(Q68State *state, Q68JitEntry *entry)
 
     /* Free the native code */
     state->jit_total_data -= entry->native_size;
-    state->free_func(entry->native_code);
+    state->jit_code_free(entry->native_code);
     entry->native_code = NULL;
 
     /* Clear the entry from the table and hash chain */
@@ -1144,7 +1161,7 @@ static void clear_oldest_entry(Q68State *state)
 static int expand_buffer(Q68JitEntry *entry)
 {
     const uint32_t newsize = entry->native_size + Q68_JIT_BLOCK_EXPAND_SIZE;
-    void *newptr = entry->state->realloc_func(entry->native_code, newsize);
+    void *newptr = entry->state->jit_code_realloc(entry->native_code, newsize);
     if (!newptr) {
         DMSG("Out of memory");
         return 0;
@@ -3428,8 +3445,12 @@ static int op4E7x(Q68State *state, uint32_t opcode)
       case 2:  // $4E72 STOP
         JIT_EMIT_CHECK_SUPER(current_entry);
         JIT_EMIT_ADD_CYCLES(current_entry, 4);
-        advance_PC(state);
-        JIT_EMIT_STOP(current_entry, IFETCH(state));
+        {
+            /* Fetch the new SR first so the PC ends up past the operand */
+            const unsigned int new_SR = IFETCH(state);
+            advance_PC(state);
+            JIT_EMIT_STOP(current_entry, new_SR);
+        }
         return 1;
       case 3: {  // $4E73 RTE
         JIT_EMIT_CHECK_SUPER(current_entry);
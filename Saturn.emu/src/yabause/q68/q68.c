@@ -197,6 +197,40 @@ void q68_set_jit_flush_func(Q68State *state, void (*flush_func)(void))
     state->jit_flush   = flush_func;
 }
 
+/*-----------------------------------------------------------------------*/
+
+/**
+ * q68_set_jit_memory_funcs:  Set the functions used to allocate memory for
+ * translated native code, separately from the functions passed to
+ * q68_create_ex().  finish_func, if not NULL, is called on each block once
+ * its translation is complete and before it is first executed, so blocks
+ * can be allocated writable and only then made executable.  If it returns
+ * zero, the block is discarded and the interpreter runs the code instead.
+ * Must be called before the processor is first run.  This function has no
+ * effect if dynamic translation is not enabled.
+ *
+ * [Parameters]
+ *           state: Processor state block
+ *     malloc_func: Function for allocating a native code block
+ *    realloc_func: Function for adjusting the size of a native code block
+ *       free_func: Function for freeing a native code block
+ *     finish_func: Function called on each completed block, returning
+ *                  nonzero on success (NULL if none)
+ * [Return value]
+ *     None
+ */
+void q68_set_jit_memory_funcs(Q68State *state,
+                              void *(*malloc_func)(size_t size),
+                              void *(*realloc_func)(void *ptr, size_t size),
+                              void (*free_func)(void *ptr),
+                              int (*finish_func)(void *ptr, size_t size))
+{
+    state->jit_code_malloc  = malloc_func;
+    state->jit_code_realloc = realloc_func;
+    state->jit_code_free    = free_func;
+    state->jit_code_finish  = finish_func;
+}
+
 /*************************************************************************/
 
 /**
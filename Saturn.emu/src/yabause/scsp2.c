@@ -31,6 +31,7 @@
 #include "yabause.h"
 
 #include <math.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 
 #undef round  // In case math.h defines it
@@ -119,6 +120,12 @@ extern SoundInterface_struct *SNDCoreList[];  // Defined by each port
 
 #endif
 
+// Values handed between the main and SCSP threads are C11 atomics; a
+// release store makes everything written before it visible to the thread
+// that reads the value back with an acquire load.
+#define SCSP_LOAD(var)       atomic_load_explicit(&PSP_UC(var), memory_order_acquire)
+#define SCSP_STORE(var,val)  atomic_store_explicit(&PSP_UC(var), (val), memory_order_release)
+
 //-------------------------------------------------------------------------
 // SCSP constants
 
@@ -491,29 +498,30 @@ PSP_SECTION_START(me_write)
 
 // Core 11.2896MHz clock (continually counts up)
 PSP_SECTION(me_write)
-   static volatile u32 scsp_clock;
+   static _Atomic u32 scsp_clock;
 // Target clock value for execution (execute until clock == clock_target)
 PSP_SECTION(sc_write)
-   static volatile u32 scsp_clock_target;
+   static _Atomic u32 scsp_clock_target;
 
 // Flag: Is a subthread currently running?  (Also used to signal the
 // subthread to stop.)
 PSP_SECTION(sc_write)
-   static volatile u8 scsp_thread_running;
+   static _Atomic u8 scsp_thread_running;
 
 // Flag: Has an interrupt request been generated for the main processor?
 // (Set by the subthread, cleared by the main thread.)
 PSP_SECTION(both_write)
-   static volatile u8 scsp_main_interrupt_pending;
+   static _Atomic u8 scsp_main_interrupt_pending;
 
 // Buffer for external (SH-2) SCSP writes (only _size is written by both
-// CPUs, but we keep all three in the same section for cache safety)
+// CPUs, but we keep all three in the same section for cache safety).
+// _address and _data are published by the release store to _size.
 PSP_SECTION(both_write)
-   static volatile u8 scsp_write_buffer_size;  // 0 = nothing buffered
+   static _Atomic u8 scsp_write_buffer_size;  // 0 = nothing buffered
 PSP_SECTION(both_write)
-   static volatile u16 scsp_write_buffer_address;
+   static u16 scsp_write_buffer_address;
 PSP_SECTION(both_write)
-   static volatile u32 scsp_write_buffer_data;
+   static u32 scsp_write_buffer_data;
 
 // SCSP register value cache (caching handled separately)
 #ifdef PSP
@@ -528,9 +536,9 @@ static union {
    u8 data[CDDA_NUM_BUFFERS*2352];
 } cdda_buf;
 PSP_SECTION(sc_write)
-   static volatile u32 cdda_next_in;  // Offset of next _sector_ to store
+   static _Atomic u32 cdda_next_in;  // Offset of next _sector_ to store
 PSP_SECTION(me_write)
-   static volatile u32 cdda_next_out; // Offset of next _byte_ to read out
+   static _Atomic u32 cdda_next_out; // Offset of next _byte_ to read out
 
 PSP_SECTION_END(sc_write)
 PSP_SECTION_END(me_write)
@@ -592,6 +600,7 @@ static void ScspMidiOut(u8 data);
 static void ScspDoDMA(void);
 
 static void ScspSyncThread(void);
+static void ScspDeliverMainInterrupt(void);
 static void ScspRaiseInterrupt(int which, int target);
 static void ScspCheckInterrupts(u16 mask, int target);
 static void ScspClearInterrupts(u16 mask, int target);
@@ -1181,7 +1190,7 @@ void ScspDeInit(void)
 {
    if (scsp_thread_running)
    {
-      scsp_thread_running = 0;  // Tell the subthread to stop
+      SCSP_STORE(scsp_thread_running, 0);  // Tell the subthread to stop
       YabThreadWake(YAB_THREAD_SCSP);
       YabThreadWait(YAB_THREAD_SCSP);
    }
@@ -1209,7 +1218,7 @@ void ScspExec(int decilines)
 
    scsp_clock_frac += scsp_clock_inc * decilines;
    new_target = scsp_clock_target + (scsp_clock_frac >> 20);
-   scsp_clock_target = new_target;
+   SCSP_STORE(scsp_clock_target, new_target);
    scsp_clock_frac &= 0xFFFFF;
 
    if (scsp_thread_running)
@@ -1218,21 +1227,33 @@ void ScspExec(int decilines)
       if (!psp_writeback_cache_for_scsp())
           PSP_UC(scsp_clock_target) = new_target; // Push just this one through
 #endif
-      while (new_target - PSP_UC(scsp_clock) > SCSP_CLOCK_MAX_EXEC)
+      while (new_target - SCSP_LOAD(scsp_clock) > SCSP_CLOCK_MAX_EXEC)
       {
          YabThreadWake(YAB_THREAD_SCSP);
          YabThreadYield();
       }
-      if (PSP_UC(scsp_main_interrupt_pending))
-      {
-          (*scsp_interrupt_handler)();
-          PSP_UC(scsp_main_interrupt_pending) = 0;
-      }
+      ScspDeliverMainInterrupt();
    }
    else
       ScspDoExec(new_target - scsp_clock);
 }
 
+#ifdef SH2_DYNAREC
+
+// M68KExec, M68KSync:  The SH-2 dynarec's frame loop (linkage_*.s) calls
+// these as the original scsp.c expects; here the M68K is run from within
+// ScspExec(), so there is nothing left to do.
+
+void M68KExec(s32 cycles)
+{
+}
+
+void M68KSync(void)
+{
+}
+
+#endif
+
 ///////////////////////////////////////////////////////////////////////////
 
 // ScspThread:  Control routine for SCSP thread.  Loops over ScspDoExec()
@@ -1240,9 +1261,9 @@ void ScspExec(int decilines)
 
 static void ScspThread(void *arg)
 {
-   while (PSP_UC(scsp_thread_running))
+   while (SCSP_LOAD(scsp_thread_running))
    {
-      const u8 write_size = PSP_UC(scsp_write_buffer_size);
+      const u8 write_size = SCSP_LOAD(scsp_write_buffer_size);
       u32 clock_cycles;
 
       if (write_size != 0)
@@ -1258,10 +1279,10 @@ static void ScspThread(void *arg)
             ScspWriteWordDirect(address, data >> 16);
             ScspWriteWordDirect(address+2, data & 0xFFFF);
          }
-         PSP_UC(scsp_write_buffer_size) = 0;
+         SCSP_STORE(scsp_write_buffer_size, 0);
       }
 
-      clock_cycles = PSP_UC(scsp_clock_target) - scsp_clock;
+      clock_cycles = SCSP_LOAD(scsp_clock_target) - scsp_clock;
       if (clock_cycles > SCSP_CLOCK_MAX_EXEC)
          clock_cycles = SCSP_CLOCK_MAX_EXEC;
       if (clock_cycles > 0)
@@ -1385,7 +1406,7 @@ static void ScspDoExec(u32 cycles)
 
    // Update scsp_clock last, so the main thread can use it as a signal
    // that we've finished processing to this point
-   scsp_clock += cycles;
+   SCSP_STORE(scsp_clock, atomic_load_explicit(&scsp_clock, memory_order_relaxed) + cycles);
 }
 
 //-------------------------------------------------------------------------
@@ -1433,7 +1454,7 @@ static void ScspGenerateAudio(s32 *bufL, s32 *bufR, u32 samples)
    for (slotnum = 0; slotnum < 32; slotnum++)
       ScspGenerateAudioForSlot(&scsp.slot[slotnum], samples);
 
-   if (cdda_next_out != PSP_UC(cdda_next_in) * 2352)
+   if (cdda_next_out != SCSP_LOAD(cdda_next_in) * 2352)
    {
       if (cdda_delay > 0)
       {
@@ -1451,7 +1472,7 @@ static void ScspGenerateAudio(s32 *bufL, s32 *bufR, u32 samples)
       if (cdda_delay == 0)
          ScspGenerateAudioForCDDA(bufL, bufR, samples);
    }
-   if (cdda_next_out == PSP_UC(cdda_next_in) * 2352)
+   if (cdda_next_out == SCSP_LOAD(cdda_next_in) * 2352)
       cdda_delay = CDDA_DELAY_SAMPLES;  // No data buffered, so reset delay
 }
 
@@ -1477,8 +1498,9 @@ static void ScspGenerateAudioForCDDA(s32 *bufL, s32 *bufR, u32 samples)
    // May need to wrap around the buffer, so use nested loops
    while (samples > 0)
    {
-      const u32 next_out = cdda_next_out;  // Save volatile value locally
-      const s32 temp = (PSP_UC(cdda_next_in) * 2352) - next_out;
+      // Only this thread writes cdda_next_out
+      const u32 next_out = atomic_load_explicit(&cdda_next_out, memory_order_relaxed);
+      const s32 temp = (SCSP_LOAD(cdda_next_in) * 2352) - next_out;
       const u32 out_left = (temp < 0) ? sizeof(cdda_buf) - next_out : temp;
       const u32 this_len = (samples > out_left/4) ? out_left/4 : samples;
       const u8 *buf = &cdda_buf.data[next_out];
@@ -1494,9 +1516,9 @@ static void ScspGenerateAudioForCDDA(s32 *bufL, s32 *bufR, u32 samples)
       }
 
       if (next_out + this_len*4 >= sizeof(cdda_buf))
-         cdda_next_out = 0;
+         SCSP_STORE(cdda_next_out, 0);
       else
-         cdda_next_out = next_out + this_len*4;
+         SCSP_STORE(cdda_next_out, next_out + this_len*4);
       samples -= this_len;
    }
 }
@@ -1593,8 +1615,8 @@ void FASTCALL ScspWriteByte(u32 address, u8 data)
    {
       PSP_UC(scsp_write_buffer_address) = address & 0xFFF;
       PSP_UC(scsp_write_buffer_data) = data;
-      PSP_UC(scsp_write_buffer_size) = 1;
-      while (PSP_UC(scsp_write_buffer_size) != 0)
+      SCSP_STORE(scsp_write_buffer_size, 1);
+      while (SCSP_LOAD(scsp_write_buffer_size) != 0)
       {
          YabThreadWake(YAB_THREAD_SCSP);
          YabThreadYield();
@@ -1611,8 +1633,8 @@ void FASTCALL ScspWriteWord(u32 address, u16 data)
    {
       PSP_UC(scsp_write_buffer_address) = address & 0xFFF;
       PSP_UC(scsp_write_buffer_data) = data;
-      PSP_UC(scsp_write_buffer_size) = 2;
-      while (PSP_UC(scsp_write_buffer_size) != 0)
+      SCSP_STORE(scsp_write_buffer_size, 2);
+      while (SCSP_LOAD(scsp_write_buffer_size) != 0)
       {
          YabThreadWake(YAB_THREAD_SCSP);
          YabThreadYield();
@@ -1629,8 +1651,8 @@ void FASTCALL ScspWriteLong(u32 address, u32 data)
    {
       PSP_UC(scsp_write_buffer_address) = address & 0xFFF;
       PSP_UC(scsp_write_buffer_data) = data;
-      PSP_UC(scsp_write_buffer_size) = 4;
-      while (PSP_UC(scsp_write_buffer_size) != 0)
+      SCSP_STORE(scsp_write_buffer_size, 4);
+      while (SCSP_LOAD(scsp_write_buffer_size) != 0)
       {
          YabThreadWake(YAB_THREAD_SCSP);
          YabThreadYield();
@@ -1650,12 +1672,13 @@ void FASTCALL ScspWriteLong(u32 address, u32 data)
 
 void ScspReceiveCDDA(const u8 *sector)
 {
-   const u32 next_in = cdda_next_in;  // Save volatile value locally
+   // Only the main thread writes cdda_next_in
+   const u32 next_in = atomic_load_explicit(&cdda_next_in, memory_order_relaxed);
    const u32 next_next_in = 
       (next_in + 1) % (sizeof(cdda_buf.sectors) / sizeof(cdda_buf.sectors[0]));
 
    // Make sure we have room for the new sector first
-   const u32 next_out = PSP_UC(cdda_next_out);
+   const u32 next_out = SCSP_LOAD(cdda_next_out);
    if (next_out > next_in * 2352 && next_out <= (next_in+1) * 2352)
    {
       SCSPLOG("WARNING: CDDA buffer overflow, discarding sector\n");
@@ -1664,7 +1687,7 @@ void ScspReceiveCDDA(const u8 *sector)
 
    memcpy(cdda_buf.sectors[next_in], sector, 2352);
    PSP_WRITEBACK_CACHE(cdda_buf.sectors[next_in], 2352);
-   cdda_next_in = next_next_in;
+   SCSP_STORE(cdda_next_in, next_next_in);
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -3200,11 +3223,27 @@ static void ScspDoDMA(void)
 static void ScspSyncThread(void)
 {
    PSP_FLUSH_ALL();
-   while (PSP_UC(scsp_clock) != scsp_clock_target)
+   while (SCSP_LOAD(scsp_clock) != scsp_clock_target)
    {
       YabThreadWake(YAB_THREAD_SCSP);
       YabThreadYield();
    }
+   // Hand any interrupt raised while catching up to the SCU now, as the
+   // single-threaded path would have; SoundSaveState() runs before
+   // ScuSaveState(), so this keeps it in the saved SCU state
+   ScspDeliverMainInterrupt();
+}
+
+//-------------------------------------------------------------------------
+
+// ScspDeliverMainInterrupt:  Pass an interrupt request raised by the SCSP
+// subthread on to the main CPU.  Must be called from the main thread.
+
+static void ScspDeliverMainInterrupt(void)
+{
+   if (atomic_exchange_explicit(&PSP_UC(scsp_main_interrupt_pending), 0,
+                                memory_order_acquire))
+      (*scsp_interrupt_handler)();
 }
 
 //-------------------------------------------------------------------------
@@ -3220,7 +3259,7 @@ static void ScspRaiseInterrupt(int which, int target)
       if (scsp.mcieb & (1 << which))
       {
          if (scsp_thread_running)
-            PSP_UC(scsp_main_interrupt_pending) = 1;
+            SCSP_STORE(scsp_main_interrupt_pending, 1);
          else
             (*scsp_interrupt_handler)();
       }
@@ -320,6 +320,7 @@ cc_interrupt_master:
 	/*movw	r6, #:lower16:maxlinecount_p*/
 	/*movt	r6, #:upper16:maxlinecount_p*/
 	ldr	r6, .mlcpptr
+	mov	r0, #10 /* decilines, only used by scsp2.c */
 	bl	ScspExec
 	ldr	r4, [r4] /* pointer to linecount */
 	ldr	r5, [r5] /* pointer to vblanklinecount */
@@ -192,6 +192,7 @@ cc_interrupt_master:
 	call	ScuExec
 	call	M68KSync
 	call	Vdp2HBlankOUT
+	movl	$10, (%esp) /* decilines, only used by scsp2.c */
 	call	ScspExec
 	mov	linecount_p, %ebx
 	mov	maxlinecount_p, %eax
@@ -1,6 +1,7 @@
 #define LOGTAG "main"
 #include <emuframework/EmuApp.hh>
 #include <emuframework/EmuAppInlines.hh>
+#include <imagine/logger/Trace.hh>
 #include "internal.hh"
 
 #include <snes9x.h>
@@ -138,6 +139,45 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 		return EmuSystem::makeFileReadError();
 }
 
+#ifndef SNES9X_VERSION_1_4
+size_t EmuSystem::stateDataSize()
+{
+	return S9xFreezeSize();
+}
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	memStream stream{(uint8*)data, size};
+	S9xFreezeToStream(&stream);
+	// memStream silently truncates, a full buffer means the state may not have fit
+	if(stream.pos() == size && size < S9xFreezeSize())
+		return makeError("State buffer too small");
+	dataSize = stream.pos();
+	return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	if(S9xUnfreezeGameMem((const uint8*)data, size) != SUCCESS)
+		return makeError("Invalid state data");
+	IPPU.RenderThisFrame = TRUE;
+	return {};
+}
+#else
+// snapshots only write to gzip streams in this version
+size_t EmuSystem::stateDataSize() { return 0; }
+
+EmuSystem::Error EmuSystem::saveStateData(void *data, size_t size, size_t &dataSize)
+{
+	return makeError("Memory states not supported");
+}
+
+EmuSystem::Error EmuSystem::loadStateData(const void *data, size_t size)
+{
+	return makeError("Memory states not supported");
+}
+#endif
+
 void EmuSystem::saveBackupMem() // for manually saving when not closing game
 {
 	if(gameIsRunning())
@@ -282,7 +322,10 @@ void EmuSystem::runFrame(EmuVideo *video, bool renderAudio)
 			mixSamples(samples / 2, renderAudio);
 		}, (void*)renderAudio);
 	#endif
-	S9xMainLoop();
+	{
+		TRACE_ZONE("S9xMainLoop");
+		S9xMainLoop();
+	}
 	// video rendered in S9xDeinitUpdate
 	#ifdef SNES9X_VERSION_1_4
 	mixSamples(audioFramesPerUpdate, renderAudio);
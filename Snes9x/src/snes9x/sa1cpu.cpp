@@ -312,6 +312,21 @@ void S9xSA1MainLoop (void)
 		}
 	}
 
+	// The SA-1 is parked on WAI until one of the interrupts above fires, so
+	// account for the five WAI steps below without dispatching them
+	if (SA1.WaitingForInterrupt && SA1.PCBase && !(Memory.FillRAM[0x2200] & 0x60) &&
+		SA1.PCBase[SA1Registers.PCw] == 0xcb && (SA1Registers.PCw & MEMMAP_MASK) + SA1.S9xOpLengths[0xcb] < MEMMAP_BLOCK_SIZE
+	#ifdef DEBUGGER
+		&& !(SA1.Flags & TRACE_FLAG)
+	#endif
+		)
+	{
+		SA1OpenBus = 0xcb;
+		SA1.Cycles += TWO_CYCLES * 5;
+		S9xSA1UpdateTimer();
+		return;
+	}
+
 	for (int i = 0; i < 5 && !(Memory.FillRAM[0x2200] & 0x60); i++)
 	{
 	#ifdef DEBUGGER
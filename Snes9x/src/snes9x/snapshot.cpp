@@ -191,6 +191,7 @@
 
 
 #include <assert.h>
+#include <vector>
 #include "snes9x.h"
 #include "memmap.h"
 #include "dma.h"
@@ -1325,7 +1326,8 @@ bool8 S9xUnfreezeGame (const char *filename)
 void S9xFreezeToStream (STREAM stream)
 {
 	char	buffer[8192];
-	uint8	*soundsnapshot = new uint8[SPC_SAVE_STATE_BLOCK_SIZE];
+	// kept between calls so saving doesn't allocate
+	static uint8	soundsnapshot[SPC_SAVE_STATE_BLOCK_SIZE];
 
 	sprintf(buffer, "%s:%04d\n", SNAPSHOT_MAGIC, SNAPSHOT_VERSION);
 	WRITE_STREAM(buffer, strlen(buffer), stream);
@@ -1465,7 +1467,6 @@ void S9xFreezeToStream (STREAM stream)
 		}
 	}
 
-	delete [] soundsnapshot;
 }
 
 int S9xUnfreezeFromStream (STREAM stream)
@@ -1963,7 +1964,11 @@ static void FreezeStruct (STREAM stream, const char *name, void *base, FreezeDat
 			len += FreezeSize(fields[i].size, fields[i].type);
 	}
 
-	uint8	*block = new uint8[len];
+	// scratch space kept between calls so saving doesn't allocate once it's grown
+	static std::vector<uint8>	blockBuffer;
+	if (blockBuffer.size() < (size_t) len)
+		blockBuffer.resize(len);
+	uint8	*block = blockBuffer.data();
 	uint8	*ptr = block;
 	uint8	*addr;
 	uint16	word;
@@ -2065,7 +2070,6 @@ static void FreezeStruct (STREAM stream, const char *name, void *base, FreezeDat
 	}
 
 	FreezeBlock(stream, name, block, len);
-	delete [] block;
 }
 
 static void FreezeBlock (STREAM stream, const char *name, uint8 *block, int size)
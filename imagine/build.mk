@@ -34,6 +34,7 @@ include $(imagineSrcDir)/data-type/image/system.mk
 include $(imagineSrcDir)/mem/malloc.mk
 include $(imagineSrcDir)/util/system/pagesize.mk
 include $(imagineSrcDir)/logger/system.mk
+include $(imagineSrcDir)/logger/Trace.mk
 include $(buildSysPath)/package/stdc++.mk
 SRC += util/string/generic.cc
 
@@ -29,3 +29,4 @@
 	#include <imagine/audio/alsa/ALSAOutputStream.hh>
 	#endif
 #endif
+#include <imagine/audio/null/NullOutputStream.hh>
@@ -0,0 +1,91 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/config/defs.hh>
+#include <imagine/audio/defs.hh>
+#include <imagine/thread/Thread.hh>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <cstdio>
+
+namespace Audio
+{
+
+// Requests samples at the format's rate from its own timer thread without
+// a sound device, so callers see the same pacing as real hardware
+class NullOutputStream : public OutputStream
+{
+public:
+	NullOutputStream();
+	~NullOutputStream() override;
+	std::error_code open(OutputStreamConfig config) override;
+	void play() final;
+	void pause() final;
+	void close() override;
+	void flush() final;
+	bool isOpen() final;
+	bool isPlaying() final;
+	explicit operator bool() const;
+
+protected:
+	PcmFormat pcmFormat{};
+
+	// called from the timer thread with each period of samples
+	virtual void consumeSamples(const void *samples, uint bytes);
+
+private:
+	std::optional<IG::thread> timerThread{};
+	std::mutex mutex{};
+	std::condition_variable cond{};
+	OnSamplesNeededDelegate onSamplesNeeded{};
+	uint periodFrames = 0;
+	bool isPlaying_ = false;
+	bool quitThread = false;
+
+	void runTimer();
+};
+
+// NullOutputStream that also writes the samples to a WAV or raw PCM file,
+// the file is kept across close()/open() and its header is updated on close()
+class FileOutputStream : public NullOutputStream
+{
+public:
+	enum class FileFormat
+	{
+		WAV,
+		RAW
+	};
+
+	FileOutputStream(const char *path, FileFormat fileFormat);
+	~FileOutputStream() final;
+	std::error_code open(OutputStreamConfig config) final;
+	void close() final;
+
+protected:
+	void consumeSamples(const void *samples, uint bytes) final;
+
+private:
+	const char *path;
+	FILE *file{};
+	uint dataBytes = 0;
+	FileFormat fileFormat;
+
+	void writeWAVHeader();
+};
+
+}
@@ -158,6 +158,10 @@ public:
 	RendererCommands(RendererCommands &&o);
 	RendererCommands &operator=(RendererCommands &&o);
 	void present();
+	// fence signaled once the GPU finishes all commands issued so far,
+	// returns an empty fence if sync objects aren't supported
+	SyncFence addSyncFence();
+	void deleteSyncFence(SyncFence fence);
 	void setDrawable(Drawable win);
 	void setRenderTarget(Texture &t);
 	void setDefaultRenderTarget();
@@ -268,6 +272,10 @@ public:
 	Base::WindowConfig addWindowConfig(Base::WindowConfig config);
 	ThreadMode threadMode() const;
 	SyncFence addResourceSyncFence();
+	bool hasSyncFences() const;
+	// blocks the calling thread until the GPU passes the fence and deletes it,
+	// returns true if the fence wasn't already signaled
+	bool clientWaitSync(SyncFence fence);
 	void initWindow(Base::Window &win, Base::WindowConfig config);
 	void setWindowValidOrientations(Base::Window &win, uint validO);
 	void setProjectionMatrixRotation(Angle angle);
@@ -93,5 +93,6 @@ using Sprite = SpriteBase<TexRect>;
 using ShadedSprite = SpriteBase<ColTexQuad>;
 
 std::array<TexVertex, 4> makeTexVertArray(GCRect pos, PixmapTexture &img);
+std::array<TexVertex, 4> makeTexVertArray(GCRect pos, IG::Rect2<GTexC> uvBounds);
 
 }
@@ -23,16 +23,59 @@
 #include <imagine/font/Font.hh>
 #include <system_error>
 #include <memory>
+#include <vector>
 
 namespace Gfx
 {
 
 struct GlyphEntry
 {
-	Gfx::PixmapTexture glyph{};
 	IG::GlyphMetrics metrics{};
+	IG::Rect2<GTexC> uv{};
+	uint16 page = 0;
+	bool cached = false;
 
 	constexpr GlyphEntry() {}
+	explicit operator bool() const { return cached; }
+};
+
+// A single texture holding many glyphs, packed into horizontal shelves.
+// Glyphs are rasterized into a CPU-side copy and the rows touched since the
+// last commit are uploaded in one write.
+class GlyphAtlasPage
+{
+public:
+	static constexpr uint SIZE = 512;
+	static constexpr uint PADDING = 1;
+
+	GlyphAtlasPage() {}
+	GlyphAtlasPage(Renderer &r, IG::PixelFormat format);
+	GlyphAtlasPage(GlyphAtlasPage &&o) = default;
+	GlyphAtlasPage &operator=(GlyphAtlasPage &&o) = default;
+	~GlyphAtlasPage();
+	explicit operator bool() const { return (bool)tex; }
+	bool allocate(IG::WP size, IG::WP &pos);
+	// frees all space and clears the page, it's re-uploaded on the next commit
+	void reset();
+	IG::Pixmap pixmap() const { return pix; }
+	void markDirty(IG::WP pos, IG::WP size);
+	bool commit();
+	PixmapTexture &texture() { return tex; }
+	IG::Rect2<GTexC> uvBounds(IG::WP pos, IG::WP size) const;
+
+private:
+	struct Shelf
+	{
+		int y;
+		int height;
+		int xEnd;
+	};
+
+	PixmapTexture tex{};
+	IG::MemPixmap pix{};
+	std::vector<Shelf> shelf{};
+	int shelfEnd = 0;
+	int dirtyY = 0, dirtyY2 = 0;
 };
 
 class GlyphTextureSet
@@ -60,6 +103,8 @@ public:
 		return precache(r, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789");
 	}
 	GlyphEntry *glyphEntry(Renderer &r, int c, bool allowCache = true);
+	PixmapTexture &pageTexture(const GlyphEntry &entry) { return page[entry.page].texture(); }
+	void commitGlyphs();
 	uint nominalHeight() const;
 	void freeCaches(uint32 rangeToFreeBits);
 	void freeCaches() { freeCaches(~0); }
@@ -67,13 +112,17 @@ public:
 private:
 	std::unique_ptr<IG::Font> font{};
 	GlyphEntry *glyphTable{};
+	std::vector<GlyphAtlasPage> page{};
 	IG::FontSize faceSize{};
 	uint nominalHeight_ = 0;
 	uint32 usedGlyphTableBits = 0;
 
 	void calcNominalHeight(Renderer &r);
 	bool initGlyphTable();
+	void freeAtlas();
+	void compactAtlas();
 	std::errc cacheChar(Renderer &r, int c, int tableIdx);
+	std::errc allocateGlyph(Renderer &r, IG::PixelFormat format, IG::WP size, uint &pageIdx, IG::WP &pos);
 };
 
 }
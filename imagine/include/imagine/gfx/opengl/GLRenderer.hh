@@ -220,7 +220,7 @@ public:
 	void (* GL_APIENTRY glReadBuffer) (GLenum src){};
 	GLsync (* GL_APIENTRY glFenceSync) (GLenum condition, GLbitfield flags){};
 	void (* GL_APIENTRY glDeleteSync) (GLsync sync){};
-	//GLenum (* GL_APIENTRY glClientWaitSync) (GLsync sync, GLbitfield flags, GLuint64 timeout){};
+	GLenum (* GL_APIENTRY glClientWaitSync) (GLsync sync, GLbitfield flags, GLuint64 timeout){};
 	void (* GL_APIENTRY glWaitSync) (GLsync sync, GLbitfield flags, GLuint64 timeout){};
 	#else
 	static void glGenSamplers(GLsizei count, GLuint* samplers) { ::glGenSamplers(count, samplers); };
@@ -234,7 +234,7 @@ public:
 	static void glReadBuffer(GLenum src) { ::glReadBuffer(src); };
 	static GLsync glFenceSync(GLenum condition, GLbitfield flags) { return ::glFenceSync(condition, flags); }
 	static void glDeleteSync(GLsync sync) { ::glDeleteSync(sync); }
-	//static GLenum glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) { return ::glClientWaitSync(sync, flags, timeout); }
+	static GLenum glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) { return ::glClientWaitSync(sync, flags, timeout); }
 	static void glWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) { ::glWaitSync(sync, flags, timeout); }
 	#endif
 	GLenum luminanceFormat = GL_LUMINANCE;
@@ -35,6 +35,8 @@ public:
 	{
 		return open(buff, size, {});
 	}
+	// starts empty, write() stores into buff and fails once it's full
+	std::error_code openForWrite(void *buff, size_t size);
 
 	void close() final;
 
@@ -43,6 +43,7 @@ protected:
 	const char *data{};
 	const char *currPos{};
 	size_t dataSize = 0;
+	size_t writeCapacity = 0; // non-zero if write() can store up to this many bytes at data
 
 	void setData(const void* buff, size_t size);
 	void resetData();
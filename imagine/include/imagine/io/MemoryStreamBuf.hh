@@ -0,0 +1,103 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <streambuf>
+#include <cstddef>
+
+// std::streambuf over a fixed caller-supplied buffer, never allocates,
+// writes past the end of the buffer fail instead of growing it
+class MemoryStreamBuf : public std::streambuf
+{
+public:
+	// for writing to buff
+	MemoryStreamBuf(void *buff, size_t size)
+	{
+		setp((char*)buff, (char*)buff + size);
+	}
+
+	// for reading from buff
+	MemoryStreamBuf(const void *buff, size_t size)
+	{
+		auto start = (char*)buff;
+		setg(start, start, start + size);
+	}
+
+	// for counting the bytes written without storing them
+	MemoryStreamBuf() {}
+
+	size_t bytesWritten() const
+	{
+		return pbase() ? pptr() - pbase() : countedBytes;
+	}
+
+protected:
+	size_t countedBytes = 0;
+
+	int_type overflow(int_type c) override
+	{
+		if(pbase() || traits_type::eq_int_type(c, traits_type::eof()))
+			return traits_type::eof();
+		countedBytes++;
+		return c;
+	}
+
+	std::streamsize xsputn(const char_type *s, std::streamsize n) override
+	{
+		if(pbase())
+			return std::streambuf::xsputn(s, n);
+		countedBytes += n;
+		return n;
+	}
+
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+	{
+		pos_type newPos = pos_type(off_type(-1));
+		if((which & std::ios_base::in) && eback())
+		{
+			auto pos = offsetToPos(off, dir, gptr() - eback(), egptr() - eback());
+			if(pos < 0)
+				return pos_type(off_type(-1));
+			setg(eback(), eback() + pos, egptr());
+			newPos = pos;
+		}
+		if((which & std::ios_base::out) && pbase())
+		{
+			auto pos = offsetToPos(off, dir, pptr() - pbase(), epptr() - pbase());
+			if(pos < 0)
+				return pos_type(off_type(-1));
+			setp(pbase(), epptr());
+			pbump(pos);
+			newPos = pos;
+		}
+		return newPos;
+	}
+
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+	{
+		return seekoff(off_type(pos), std::ios_base::beg, which);
+	}
+
+	static off_type offsetToPos(off_type off, std::ios_base::seekdir dir, off_type curr, off_type size)
+	{
+		off_type pos = off;
+		if(dir == std::ios_base::cur)
+			pos += curr;
+		else if(dir == std::ios_base::end)
+			pos += size;
+		return (pos < 0 || pos > size) ? -1 : pos;
+	}
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/config/defs.hh>
+#include <imagine/util/utility.h>
+#include <atomic>
+#include <system_error>
+
+// Scoped zone tracer, each thread records begin/end timestamps into its own
+// fixed-size ring buffer so only the most recent events are kept.
+// Zone names must be string literals since only the pointer is stored.
+
+namespace Trace
+{
+
+extern std::atomic_bool isEnabled_;
+
+static bool isEnabled()
+{
+	return isEnabled_.load(std::memory_order_relaxed);
+}
+
+void setEnabled(bool on);
+void beginZone(const char *name);
+void endZone();
+// name used for the calling thread in the trace output
+void setThreadName(const char *name);
+// write the recorded events of all threads in Chrome trace event format,
+// viewable in chrome://tracing or Perfetto
+std::error_code writeChromeJSON(const char *path);
+
+class Zone
+{
+public:
+	Zone(const char *name): active{isEnabled()}
+	{
+		if(unlikely(active))
+			beginZone(name);
+	}
+
+	~Zone()
+	{
+		if(unlikely(active))
+			endZone();
+	}
+
+	Zone(const Zone &) = delete;
+	Zone &operator=(const Zone &) = delete;
+
+private:
+	bool active;
+};
+
+}
+
+#define TRACE_ZONE_CONCAT2(a, b) a ## b
+#define TRACE_ZONE_CONCAT(a, b) TRACE_ZONE_CONCAT2(a, b)
+#define TRACE_ZONE(name) Trace::Zone TRACE_ZONE_CONCAT(traceZone_, __LINE__){name}
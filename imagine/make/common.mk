@@ -57,3 +57,9 @@ $(objDir)/%.o : %.s
 	@echo "Assembling $<"
 	@mkdir -p $(@D)
 	$(PRINT_CMD)$(AS) $< $(ASMFLAGS) -o $@
+
+# Assembly with C preprocessor
+$(objDir)/%.o : %.S
+	@echo "Assembling $<"
+	@mkdir -p $(@D)
+	$(PRINT_CMD)$(CC) $(compileAction) $< $(CPPFLAGS) $(CFLAGS) -o $@
@@ -0,0 +1,8 @@
+ifndef inc_audio_null
+inc_audio_null := 1
+
+configDefs += CONFIG_AUDIO
+
+SRC += audio/OutputStream.cc audio/null/null.cc
+
+endif
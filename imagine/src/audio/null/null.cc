@@ -0,0 +1,252 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "NullAudio"
+#include <imagine/audio/null/NullOutputStream.hh>
+#include <imagine/logger/logger.h>
+#include <imagine/util/algorithm.h>
+#include <chrono>
+#include <cerrno>
+#include <memory>
+
+namespace Audio
+{
+
+using Clock = std::chrono::steady_clock;
+
+NullOutputStream::NullOutputStream() {}
+
+NullOutputStream::~NullOutputStream()
+{
+	close();
+}
+
+std::error_code NullOutputStream::open(OutputStreamConfig config)
+{
+	if(isOpen())
+	{
+		logMsg("already open");
+		return {};
+	}
+	pcmFormat = config.format();
+	onSamplesNeeded = config.onSamplesNeeded();
+	uint wantedLatency = config.wantedLatencyHint() ? config.wantedLatencyHint() : 10000;
+	periodFrames = pcmFormat.uSecsToFrames(wantedLatency);
+	logMsg("opening stream: %iHz, %u bits, %i channels, %u frame periods",
+		pcmFormat.rate, pcmFormat.sample.toBits(), pcmFormat.channels, periodFrames);
+	isPlaying_ = false;
+	quitThread = false;
+	timerThread.emplace([this](){ runTimer(); });
+	if(config.startPlaying())
+		play();
+	return {};
+}
+
+void NullOutputStream::play()
+{
+	if(unlikely(!isOpen()))
+		return;
+	std::lock_guard<std::mutex> lock{mutex};
+	isPlaying_ = true;
+	cond.notify_one();
+}
+
+void NullOutputStream::pause()
+{
+	if(unlikely(!isOpen()))
+		return;
+	logMsg("pausing playback");
+	std::lock_guard<std::mutex> lock{mutex};
+	isPlaying_ = false;
+	cond.notify_one();
+}
+
+void NullOutputStream::close()
+{
+	if(unlikely(!isOpen()))
+		return;
+	logDMsg("closing stream");
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		quitThread = true;
+		isPlaying_ = false;
+		cond.notify_one();
+	}
+	timerThread->join();
+	timerThread.reset();
+}
+
+void NullOutputStream::flush()
+{
+	// no queued samples beyond the period being consumed,
+	// leave the stream paused like the other backends
+	pause();
+}
+
+bool NullOutputStream::isOpen()
+{
+	return (bool)timerThread;
+}
+
+bool NullOutputStream::isPlaying()
+{
+	std::lock_guard<std::mutex> lock{mutex};
+	return isOpen() && isPlaying_;
+}
+
+NullOutputStream::operator bool() const
+{
+	return true;
+}
+
+void NullOutputStream::consumeSamples(const void *, uint) {}
+
+void NullOutputStream::runTimer()
+{
+	auto periodBytes = pcmFormat.framesToBytes(periodFrames);
+	auto buff = std::make_unique<char[]>(periodBytes);
+	auto framesToTime =
+		[rate = pcmFormat.rate](uint64_t frames)
+		{
+			return std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(frames * 1000000000 / rate));
+		};
+	// resync instead of bursting samples if the thread falls this far behind,
+	// a real device would underrun in that case
+	auto maxLag = framesToTime(periodFrames * 4);
+	Clock::time_point startTime{};
+	uint64_t framesConsumed = 0;
+	std::unique_lock<std::mutex> lock{mutex};
+	while(!quitThread)
+	{
+		if(!isPlaying_)
+		{
+			cond.wait(lock, [this](){ return quitThread || isPlaying_; });
+			startTime = Clock::now();
+			framesConsumed = 0;
+			continue;
+		}
+		// the next period is due once the previous one has played out
+		auto deadline = startTime + framesToTime(framesConsumed);
+		if(cond.wait_until(lock, deadline, [this](){ return quitThread || !isPlaying_; }))
+			continue;
+		if(Clock::now() - deadline > maxLag)
+		{
+			logMsg("timer thread fell behind, resyncing");
+			startTime = Clock::now();
+			framesConsumed = 0;
+		}
+		lock.unlock();
+		onSamplesNeeded(buff.get(), periodBytes);
+		consumeSamples(buff.get(), periodBytes);
+		lock.lock();
+		framesConsumed += periodFrames;
+	}
+}
+
+static void writeLE(FILE *f, uint32_t val, uint bytes)
+{
+	iterateTimes(bytes, i)
+	{
+		fputc((val >> (i * 8)) & 0xFF, f);
+	}
+}
+
+FileOutputStream::FileOutputStream(const char *path, FileFormat fileFormat):
+	path{path}, fileFormat{fileFormat}
+{}
+
+FileOutputStream::~FileOutputStream()
+{
+	close();
+	if(file)
+	{
+		fclose(file);
+	}
+}
+
+std::error_code FileOutputStream::open(OutputStreamConfig config)
+{
+	if(isOpen())
+	{
+		logMsg("already open");
+		return {};
+	}
+	if(!file)
+	{
+		file = fopen(path, "wb");
+		if(!file)
+		{
+			logErr("error creating %s", path);
+			return {errno, std::system_category()};
+		}
+		logMsg("writing audio to %s", path);
+		dataBytes = 0;
+		if(fileFormat == FileFormat::WAV)
+		{
+			pcmFormat = config.format();
+			writeWAVHeader();
+		}
+	}
+	return NullOutputStream::open(config);
+}
+
+void FileOutputStream::close()
+{
+	if(unlikely(!isOpen()))
+		return;
+	NullOutputStream::close();
+	if(fileFormat == FileFormat::WAV)
+		writeWAVHeader();
+	fflush(file);
+}
+
+void FileOutputStream::consumeSamples(const void *samples, uint bytes)
+{
+	if(fileFormat == FileFormat::WAV && pcmFormat.sample.toBits() == 8 && pcmFormat.sample.isSigned)
+	{
+		// 8-bit WAV data is unsigned
+		auto byte = (const uint8*)samples;
+		iterateTimes(bytes, i)
+		{
+			fputc(byte[i] ^ 0x80, file);
+		}
+	}
+	else
+	{
+		fwrite(samples, 1, bytes, file);
+	}
+	dataBytes += bytes;
+}
+
+void FileOutputStream::writeWAVHeader()
+{
+	uint bytesPerFrame = pcmFormat.framesToBytes(1);
+	fseek(file, 0, SEEK_SET);
+	fwrite("RIFF", 1, 4, file);
+	writeLE(file, 36 + dataBytes, 4);
+	fwrite("WAVEfmt ", 1, 8, file);
+	writeLE(file, 16, 4); // format chunk size
+	writeLE(file, 1, 2); // integer PCM
+	writeLE(file, pcmFormat.channels, 2);
+	writeLE(file, pcmFormat.rate, 4);
+	writeLE(file, pcmFormat.rate * bytesPerFrame, 4);
+	writeLE(file, bytesPerFrame, 2);
+	writeLE(file, pcmFormat.sample.toBits(), 2);
+	fwrite("data", 1, 4, file);
+	writeLE(file, dataBytes, 4);
+	fseek(file, 0, SEEK_END);
+}
+
+}
@@ -1,3 +1,6 @@
+# device-less output for headless runs, available on every platform
+include $(imagineSrcDir)/audio/null/build.mk
+
 ifeq ($(ENV), linux)
  ifneq ($(SUBENV), pandora)
   include $(imagineSrcDir)/audio/pulseaudio/build.mk
@@ -18,6 +18,8 @@
 #include <imagine/logger/logger.h>
 #include <imagine/gfx/GfxText.hh>
 #include <imagine/util/math/int.hh>
+#include <imagine/util/container/ArrayList.hh>
+#include <imagine/gfx/GeomQuad.hh>
 #include <imagine/mem/mem.h>
 
 namespace Gfx
@@ -68,6 +70,7 @@ void Text::makeGlyphs(Renderer &r)
 	{
 		face->glyphEntry(r, c);
 	}
+	face->commitGlyphs();
 }
 
 void Text::compile(Renderer &r, const ProjectionPlane &projP)
@@ -84,6 +87,7 @@ void Text::compile(Renderer &r, const ProjectionPlane &projP)
 	if(!mGly || !gGly)
 	{
 		logErr("error reading measurement glyphs to compile text");
+		face->commitGlyphs();
 		return;
 	}
 
@@ -169,6 +173,7 @@ void Text::compile(Renderer &r, const ProjectionPlane &projP)
 	maxXLineSize = std::max(xLineSize, maxXLineSize);
 	xSize = maxXLineSize;
 	ySize = nominalHeight * (GC)lines;
+	face->commitGlyphs();
 }
 
 void Text::draw(RendererCommands &cmds, GC xPos, GC yPos, _2DOrigin o, const ProjectionPlane &projP) const
@@ -179,9 +184,21 @@ void Text::draw(RendererCommands &cmds, GC xPos, GC yPos, _2DOrigin o, const Pro
 	//logMsg("drawing with origin: %s,%s", o.toString(o.x), o.toString(o.y));
 	cmds.setBlendMode(BLEND_MODE_ALPHA);
 	cmds.setCommonTextureSampler(CommonTextureSampler::NO_MIP_CLAMP);
-	std::array<TexVertex, 4> vArr;
-	cmds.bindTempVertexBuffer();
-	TexVertex::bindAttribs(cmds, vArr.data());
+	// glyphs are batched into one vertex buffer per atlas page run, only
+	// flushing when the page changes or the batch fills up
+	StaticArrayList<std::array<TexVertex, 4>, 128> vArr;
+	StaticArrayList<std::array<VertexIndex, 6>, vArr.maxSize()> vArrIdx;
+	GlyphEntry *batchGly{};
+	auto drawBatch =
+		[&]()
+		{
+			if(!vArr.size())
+				return;
+			cmds.setTexture(face->pageTexture(*batchGly));
+			drawQuads(cmds, &vArr[0], vArr.size(), &vArrIdx[0], vArrIdx.size());
+			vArr.clear();
+			vArrIdx.clear();
+		};
 	_2DOrigin align = o;
 	xPos = o.adjustX(xPos, xSize, LT2DO);
 	//logMsg("aligned to %f, converted to %d", Gfx::alignYToPixel(yPos), toIYPos(Gfx::alignYToPixel(yPos)));
@@ -195,6 +212,7 @@ void Text::draw(RendererCommands &cmds, GC xPos, GC yPos, _2DOrigin o, const Pro
 	auto xViewLimit = projP.wHalf();
 	const char *s = str;
 	uint totalCharsDrawn = 0;
+	bool convError = false;
 	if(lines > 1)
 	{
 		assert(lineInfo);
@@ -213,7 +231,8 @@ void Text::draw(RendererCommands &cmds, GC xPos, GC yPos, _2DOrigin o, const Pro
 				(bool)err)
 			{
 				logWarn("failed char conversion while drawing line %d, char %d, result %d", l, i, (int)err);
-				return;
+				convError = true;
+				break;
 			}
 
 			if(c == '\n')
@@ -233,21 +252,31 @@ void Text::draw(RendererCommands &cmds, GC xPos, GC yPos, _2DOrigin o, const Pro
 				//logMsg("skipped %c, off right screen edge", s[i]);
 				continue;
 			}
-			GC xSize = projP.unprojectXSize(gly->metrics.xSize);
-
-			auto x = xPos + projP.unprojectXSize(gly->metrics.xOffset);
-			auto y = yPos - projP.unprojectYSize(gly->metrics.ySize - gly->metrics.yOffset);
-			vArr = makeTexVertArray({x, y, x + xSize, y + projP.unprojectYSize(gly->metrics.ySize)}, gly->glyph);
-			cmds.vertexBufferData(vArr.data(), sizeof(vArr));
-			cmds.setTexture(gly->glyph);
-			//logMsg("drawing");
-			cmds.drawPrimitives(Primitive::TRIANGLE_STRIP, 0, 4);
+			if(gly->metrics.xSize && gly->metrics.ySize)
+			{
+				if(batchGly && (batchGly->page != gly->page || vArr.size() == vArr.maxSize()))
+				{
+					drawBatch();
+				}
+				batchGly = gly;
+				GC xSize = projP.unprojectXSize(gly->metrics.xSize);
+				auto x = xPos + projP.unprojectXSize(gly->metrics.xOffset);
+				auto y = yPos - projP.unprojectYSize(gly->metrics.ySize - gly->metrics.yOffset);
+				vArrIdx.emplace_back(makeRectIndexArray(vArr.size()));
+				vArr.emplace_back(makeTexVertArray({x, y, x + xSize, y + projP.unprojectYSize(gly->metrics.ySize)}, gly->uv));
+			}
 			xPos += projP.unprojectXSize(gly->metrics.xAdvance);
 		}
+		if(convError)
+		{
+			// still draw the glyphs queued before the bad char
+			break;
+		}
 		yPos -= nominalHeight;
 		yPos = projP.alignYToPixel(yPos);
 		totalCharsDrawn += charsToDraw;
 	}
+	drawBatch();
 	if(totalCharsDrawn < chars)
 	{
 		logWarn("only rendered %d/%d chars", totalCharsDrawn, chars);
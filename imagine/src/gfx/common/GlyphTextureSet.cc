@@ -96,6 +96,89 @@ static int charIsDrawableUnicode(int c)
 			);
 }
 
+GlyphAtlasPage::GlyphAtlasPage(Renderer &r, IG::PixelFormat format):
+	pix{{{(int)SIZE, (int)SIZE}, format}}
+{
+	logMsg("allocating %dx%d glyph atlas page", SIZE, SIZE);
+	pix.clear();
+	tex = r.makePixmapTexture(TextureConfig{pix});
+	if(!tex)
+		return;
+	tex.write(0, pix, {});
+}
+
+GlyphAtlasPage::~GlyphAtlasPage()
+{
+	tex.deinit();
+}
+
+bool GlyphAtlasPage::allocate(IG::WP size, IG::WP &pos)
+{
+	int w = size.x + PADDING;
+	int h = size.y + PADDING;
+	if(w > (int)SIZE || h > (int)SIZE)
+		return false;
+	// pick the shortest shelf that fits, opening a new one if the best
+	// existing shelf would waste too much height
+	Shelf *fit{};
+	for(auto &s : shelf)
+	{
+		if(s.height >= h && s.xEnd + w <= (int)SIZE && (!fit || s.height < fit->height))
+			fit = &s;
+	}
+	if((!fit || fit->height > h + h / 2) && shelfEnd + h <= (int)SIZE)
+	{
+		shelf.emplace_back(Shelf{shelfEnd, h, 0});
+		shelfEnd += h;
+		fit = &shelf.back();
+	}
+	if(!fit)
+		return false;
+	pos = {fit->xEnd, fit->y};
+	fit->xEnd += w;
+	return true;
+}
+
+void GlyphAtlasPage::reset()
+{
+	shelf.clear();
+	shelfEnd = 0;
+	pix.clear();
+	markDirty({}, pix.size());
+}
+
+void GlyphAtlasPage::markDirty(IG::WP pos, IG::WP size)
+{
+	if(dirtyY2 <= dirtyY)
+	{
+		dirtyY = pos.y;
+		dirtyY2 = pos.y + size.y;
+	}
+	else
+	{
+		dirtyY = std::min(dirtyY, pos.y);
+		dirtyY2 = std::max(dirtyY2, pos.y + size.y);
+	}
+}
+
+bool GlyphAtlasPage::commit()
+{
+	if(dirtyY2 <= dirtyY)
+		return false;
+	// upload whole rows so the source data is contiguous and doesn't need
+	// unpack row length support
+	//logMsg("uploading glyph atlas rows %d-%d", dirtyY, dirtyY2);
+	tex.write(0, pix.subPixmap({0, dirtyY}, {(int)pix.w(), dirtyY2 - dirtyY}), {0, dirtyY});
+	dirtyY = dirtyY2 = 0;
+	return true;
+}
+
+IG::Rect2<GTexC> GlyphAtlasPage::uvBounds(IG::WP pos, IG::WP size) const
+{
+	return {(GTexC)pos.x / (GTexC)SIZE, (GTexC)pos.y / (GTexC)SIZE,
+		(GTexC)(pos.x + size.x) / (GTexC)SIZE, (GTexC)(pos.y + size.y) / (GTexC)SIZE};
+}
+
 bool GlyphTextureSet::initGlyphTable()
 {
 	logMsg("allocating glyph table, %d entries", glyphTableEntries);
@@ -108,12 +191,60 @@ bool GlyphTextureSet::initGlyphTable()
 		return false;
 	}
 	usedGlyphTableBits = 0;
+	freeAtlas();
 	return true;
 }
 
+void GlyphTextureSet::freeAtlas()
+{
+	page.clear();
+}
+
+void GlyphTextureSet::compactAtlas()
+{
+	// shelves can't free individual glyphs, so re-pack the remaining ones
+	// from copies of the current pages
+	std::vector<IG::MemPixmap> oldPix{};
+	oldPix.reserve(page.size());
+	for(auto &p : page)
+	{
+		oldPix.emplace_back((IG::PixmapDesc)p.pixmap());
+		oldPix.back().write(p.pixmap());
+		p.reset();
+	}
+	uint pageIdx = 0;
+	iterateTimes(glyphTableEntries, i)
+	{
+		auto &entry = glyphTable[i];
+		if(!entry || entry.uv.x2 == entry.uv.x)
+			continue;
+		IG::WP pos{int(entry.uv.x * GlyphAtlasPage::SIZE), int(entry.uv.y * GlyphAtlasPage::SIZE)};
+		IG::WP size{int(entry.uv.x2 * GlyphAtlasPage::SIZE) - pos.x, int(entry.uv.y2 * GlyphAtlasPage::SIZE) - pos.y};
+		IG::WP newPos;
+		while(pageIdx < page.size() && !page[pageIdx].allocate(size, newPos))
+		{
+			pageIdx++;
+		}
+		if(pageIdx == page.size())
+		{
+			// packing order changed enough to need more space, re-cache it on next use
+			entry = {};
+			pageIdx = page.size() - 1;
+			continue;
+		}
+		page[pageIdx].pixmap().write(oldPix[entry.page].subPixmap(pos, size), newPos);
+		entry.uv = page[pageIdx].uvBounds(newPos, size);
+		entry.page = pageIdx;
+	}
+	logMsg("compacted glyph atlas from %zu to %u pages", page.size(), pageIdx + 1);
+	page.erase(page.begin() + pageIdx + 1, page.end());
+	commitGlyphs();
+}
+
 void GlyphTextureSet::freeCaches(uint32 purgeBits)
 {
 	auto tableBits = usedGlyphTableBits;
+	bool purged = false;
 	iterateTimes(32, i)
 	{
 		if((tableBits & 1) && (purgeBits & 1))
@@ -128,13 +259,22 @@ void GlyphTextureSet::freeCaches(uint32 purgeBits)
 					//logMsg( "%c not a known drawable character, skipping", c);
 					continue;
 				}
-				glyphTable[tableIdx].glyph.deinit();
+				glyphTable[tableIdx] = {};
 			}
 			usedGlyphTableBits = IG::clearBits(usedGlyphTableBits, IG::bit(i));
+			purged = true;
 		}
 		tableBits >>= 1;
 		purgeBits >>= 1;
 	}
+	if(!usedGlyphTableBits)
+	{
+		freeAtlas();
+	}
+	else if(purged && page.size())
+	{
+		compactAtlas();
+	}
 }
 
 GlyphTextureSet::GlyphTextureSet(Renderer &r, const char *path, IG::FontSettings set):
@@ -191,10 +331,6 @@ GlyphTextureSet::~GlyphTextureSet()
 {
 	if(glyphTable)
 	{
-		iterateTimes(glyphTableEntries, i)
-		{
-			glyphTable[i].glyph.deinit();
-		}
 		mem_free(glyphTable);
 	}
 }
@@ -209,6 +345,7 @@ void GlyphTextureSet::swap(GlyphTextureSet &a, GlyphTextureSet &b)
 	std::swap(a.settings, b.settings);
 	std::swap(a.font, b.font);
 	std::swap(a.glyphTable, b.glyphTable);
+	std::swap(a.page, b.page);
 	std::swap(a.faceSize, b.faceSize);
 	std::swap(a.nominalHeight_, b.nominalHeight_);
 	std::swap(a.usedGlyphTableBits, b.usedGlyphTableBits);
@@ -241,10 +378,6 @@ bool GlyphTextureSet::setFontSettings(Renderer &r, IG::FontSettings set)
 	if(settings && glyphTable)
 	{
 		logMsg("flushing glyph cache");
-		iterateTimes(glyphTableEntries, i)
-		{
-			glyphTable[i].glyph.deinit();
-		}
 	}
 	if(!initGlyphTable())
 	{
@@ -254,6 +387,7 @@ bool GlyphTextureSet::setFontSettings(Renderer &r, IG::FontSettings set)
 	std::errc ec{};
 	faceSize = font->makeSize(settings, ec);
 	calcNominalHeight(r);
+	commitGlyphs();
 	return true;
 }
 
@@ -274,14 +408,60 @@ std::errc GlyphTextureSet::cacheChar(Renderer &r, int c, int tableIdx)
 		return ec;
 	}
 	//logMsg("setting up table entry %d", tableIdx);
-	glyphTable[tableIdx].metrics = res.metrics;
+	auto &entry = glyphTable[tableIdx];
+	entry.metrics = res.metrics;
 	auto img = GfxGlyphImage(std::move(res.image));
-	glyphTable[tableIdx].glyph = r.makePixmapTexture(img, false);
+	auto glyphDesc = (IG::PixmapDesc)img.lockPixmap();
+	if(glyphDesc.w() && glyphDesc.h())
+	{
+		uint pageIdx;
+		IG::WP pos;
+		if(auto ec = allocateGlyph(r, glyphDesc.format(), glyphDesc.size(), pageIdx, pos);
+			(bool)ec)
+		{
+			img.unlockPixmap();
+			entry.metrics.ySize = -1;
+			return ec;
+		}
+		auto &glyphPage = page[pageIdx];
+		img.write(glyphPage.pixmap().subPixmap(pos, glyphDesc.size()));
+		glyphPage.markDirty(pos, glyphDesc.size());
+		entry.uv = glyphPage.uvBounds(pos, glyphDesc.size());
+		entry.page = pageIdx;
+	}
+	img.unlockPixmap();
+	entry.cached = true;
 	usedGlyphTableBits |= IG::bit((c >> 11) & 0x1F); // use upper 5 BMP plane bits to map in range 0-31
 	//logMsg("used table bits 0x%X", usedGlyphTableBits);
 	return {};
 }
 
+std::errc GlyphTextureSet::allocateGlyph(Renderer &r, IG::PixelFormat format, IG::WP size, uint &pageIdx, IG::WP &pos)
+{
+	if(page.size() && page.back().allocate(size, pos))
+	{
+		pageIdx = page.size() - 1;
+		return {};
+	}
+	page.emplace_back(r, format);
+	if(!page.back() || !page.back().allocate(size, pos))
+	{
+		logErr("unable to allocate %dx%d glyph in atlas", size.x, size.y);
+		page.pop_back();
+		return std::errc::not_enough_memory;
+	}
+	pageIdx = page.size() - 1;
+	return {};
+}
+
+void GlyphTextureSet::commitGlyphs()
+{
+	for(auto &p : page)
+	{
+		p.commit();
+	}
+}
+
 static std::errc mapCharToTable(uint c, uint &tableIdx)
 {
 	if(GlyphTextureSet::supportsUnicode)
@@ -332,7 +512,7 @@ std::errc GlyphTextureSet::precache(Renderer &r, const char *string)
 			//logMsg( "%c not a known drawable character, skipping", c);
 			continue;
 		}
-		if(glyphTable[tableIdx].glyph)
+		if(glyphTable[tableIdx])
 		{
 			//logMsg( "%c already cached", c);
 			continue;
@@ -340,6 +520,7 @@ std::errc GlyphTextureSet::precache(Renderer &r, const char *string)
 		logMsg("making glyph:%c (0x%X)", c, c);
 		cacheChar(r, c, tableIdx);
 	}
+	commitGlyphs();
 	return {};
 }
 
@@ -350,7 +531,7 @@ GlyphEntry *GlyphTextureSet::glyphEntry(Renderer &r, int c, bool allowCache)
 	if((bool)mapCharToTable(c, tableIdx))
 		return nullptr;
 	assert(tableIdx < glyphTableEntries);
-	if(!glyphTable[tableIdx].glyph)
+	if(!glyphTable[tableIdx])
 	{
 		if(!allowCache)
 		{
@@ -18,6 +18,10 @@
 #include <imagine/logger/logger.h>
 #include "private.hh"
 
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+
 namespace Gfx
 {
 
@@ -71,6 +75,22 @@ void RendererCommands::present()
 	rTask->present(drawable);
 }
 
+SyncFence RendererCommands::addSyncFence()
+{
+	if(!renderer().support.hasSyncFences())
+		return {};
+	rTask->verifyCurrentContext();
+	return renderer().support.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void RendererCommands::deleteSyncFence(SyncFence fence)
+{
+	if(!fence.sync)
+		return;
+	rTask->verifyCurrentContext();
+	renderer().support.glDeleteSync(fence.sync);
+}
+
 void RendererCommands::setDrawable(Drawable drawable)
 {
 	rTask->verifyCurrentContext();
@@ -16,6 +16,7 @@
 #define LOGTAG "RendererTask"
 #include <imagine/gfx/Gfx.hh>
 #include <imagine/thread/Thread.hh>
+#include <imagine/logger/Trace.hh>
 #include "private.hh"
 
 #ifndef GL_BACK_LEFT
@@ -202,6 +203,7 @@ bool GLRendererTask::commandHandler(Base::Pipe &pipe, Base::GLDisplay glDpy, boo
 		auto arg = drawArg[i];
 		if(!arg.del)
 			continue;
+		TRACE_ZONE("RendererTask::runDraw");
 		arg.del(arg.drawable, *arg.winPtr, {*static_cast<RendererTask*>(this), glDpy});
 		if(onDrawFinished.size())
 		{
@@ -268,6 +270,7 @@ void RendererTask::start(uint channels_)
 		IG::makeDetachedThread(
 			[this]()
 			{
+				Trace::setThreadName("RendererTask");
 				auto glDpy = Base::GLDisplay::getDefault();
 				#ifdef CONFIG_GFX_OPENGL_ES
 				if(!Base::GLContext::bindAPI(Base::GLContext::OPENGL_ES_API))
@@ -310,6 +313,7 @@ void RendererTask::start(uint channels_)
 
 void RendererTask::draw(DrawableHolder &drawableHolder, Base::Window &win, Base::Window::DrawParams params, DrawDelegate del, uint channel)
 {
+	TRACE_ZONE("RendererTask::draw");
 	if(unlikely(!glCtx))
 	{
 		logWarn("drawing without starting render task");
@@ -74,6 +74,10 @@
 #define GL_CONDITION_SATISFIED 0x911C
 #endif
 
+#ifndef GL_WAIT_FAILED
+#define GL_WAIT_FAILED 0x911D
+#endif
+
 namespace Gfx
 {
 
@@ -233,6 +237,7 @@ void GLRenderer::setupFenceSync()
 	support.glFenceSync = (typeof(support.glFenceSync))Base::GLContext::procAddress("glFenceSync");
 	support.glDeleteSync = (typeof(support.glDeleteSync))Base::GLContext::procAddress("glDeleteSync");
 	support.glWaitSync = (typeof(support.glWaitSync))Base::GLContext::procAddress("glWaitSync");
+	support.glClientWaitSync = (typeof(support.glClientWaitSync))Base::GLContext::procAddress("glClientWaitSync");
 	#else
 	support.hasFenceSync = true;
 	#endif
@@ -247,6 +252,7 @@ void GLRenderer::setupAppleFenceSync()
 	support.glFenceSync = (typeof(support.glFenceSync))Base::GLContext::procAddress("glFenceSyncAPPLE");
 	support.glDeleteSync = (typeof(support.glDeleteSync))Base::GLContext::procAddress("glDeleteSyncAPPLE");
 	support.glWaitSync = (typeof(support.glWaitSync))Base::GLContext::procAddress("glWaitSyncAPPLE");
+	support.glClientWaitSync = (typeof(support.glClientWaitSync))Base::GLContext::procAddress("glClientWaitSyncAPPLE");
 }
 #endif
 
@@ -261,8 +267,7 @@ void GLRenderer::setupEGLFenceSync(bool supportsServerSync)
 	eglDestroySync = (typeof(eglDestroySync))Base::GLContext::procAddress("eglDestroySyncKHR");
 	if(supportsServerSync)
 		eglWaitSync = (typeof(eglWaitSync))Base::GLContext::procAddress("eglWaitSyncKHR");
-	else
-		eglClientWaitSync = (typeof(eglClientWaitSync))Base::GLContext::procAddress("eglClientWaitSyncKHR");
+	eglClientWaitSync = (typeof(eglClientWaitSync))Base::GLContext::procAddress("eglClientWaitSyncKHR");
 	#endif
 	// wrap EGL sync in terms of ARB sync
 	support.glFenceSync =
@@ -297,6 +302,16 @@ void GLRenderer::setupEGLFenceSync(bool supportsServerSync)
 				}
 			};
 	}
+	support.glClientWaitSync =
+		[](GLsync sync, GLbitfield flags, GLuint64 timeout) -> GLenum
+		{
+			switch(eglClientWaitSync(Base::GLDisplay::getDefault().eglDisplay(), (EGLSync)sync, 0, timeout))
+			{
+				case EGL_CONDITION_SATISFIED: return GL_CONDITION_SATISFIED;
+				case EGL_TIMEOUT_EXPIRED: return GL_TIMEOUT_EXPIRED;
+				default: return GL_WAIT_FAILED;
+			}
+		};
 }
 #endif
 
@@ -51,10 +51,14 @@ void SpriteBase<BaseRect>::draw(RendererCommands &cmds) const
 }
 
 std::array<TexVertex, 4> makeTexVertArray(GCRect pos, PixmapTexture &img)
+{
+	return makeTexVertArray(pos, img.uvBounds());
+}
+
+std::array<TexVertex, 4> makeTexVertArray(GCRect pos, IG::Rect2<GTexC> uvBounds)
 {
 	std::array<TexVertex, 4> arr{};
 	setPos(arr, pos.x, pos.y, pos.x2, pos.y2);
-	auto uvBounds = img.uvBounds();
 	mapImg(arr, uvBounds.x, uvBounds.y, uvBounds.x2, uvBounds.y2);
 	return arr;
 }
@@ -28,6 +28,14 @@
 #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
 #endif
 
+#ifndef GL_TIMEOUT_EXPIRED
+#define GL_TIMEOUT_EXPIRED 0x911B
+#endif
+
+#ifndef GL_WAIT_FAILED
+#define GL_WAIT_FAILED 0x911D
+#endif
+
 #ifndef GL_DEBUG_TYPE_ERROR
 #define GL_DEBUG_TYPE_ERROR 0x824C
 #endif
@@ -155,6 +163,35 @@ SyncFence Renderer::addResourceSyncFence()
 	}
 }
 
+bool Renderer::hasSyncFences() const
+{
+	return support.hasSyncFences();
+}
+
+bool Renderer::clientWaitSync(SyncFence fence)
+{
+	if(!fence.sync)
+		return false;
+	assumeExpr(support.hasSyncFences());
+	bool waited = false;
+	runGLTaskSync(
+		[this, &waited, sync = fence.sync]()
+		{
+			auto status = support.glClientWaitSync(sync, 0, 0);
+			if(status == GL_TIMEOUT_EXPIRED)
+			{
+				waited = true;
+				status = support.glClientWaitSync(sync, 0, 1000000000);
+			}
+			if(status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED)
+			{
+				logErr("error waiting for sync object:%p", sync);
+			}
+			support.glDeleteSync(sync);
+		});
+	return waited;
+}
+
 void Renderer::setCorrectnessChecks(bool on)
 {
 	if(on)
@@ -18,6 +18,7 @@
 #include <sys/inotify.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <time.h>
 #include <imagine/util/algorithm.h>
 #include <imagine/util/bits.h>
 #include <imagine/util/fd-utils.h>
@@ -365,6 +366,13 @@ static bool processDevNode(const char *path, int id, bool notify)
 		close(fd);
 		return false;
 	}
+	// use the same clock as IG::Time::now() for event times so they can be
+	// compared with frame timestamps
+	int clockId = CLOCK_MONOTONIC;
+	if(ioctl(fd, EVIOCSCLOCKID, &clockId) < 0)
+	{
+		logWarn("unable to set monotonic event clock");
+	}
 	std::array<char, 80> nameStr{};
 	if(ioctl(fd, EVIOCGNAME(sizeof(nameStr)), nameStr.data()) < 0)
 	{
@@ -49,6 +49,13 @@ std::error_code BufferMapIO::open(const void *buff, size_t size, OnCloseDelegate
 	return {};
 }
 
+std::error_code BufferMapIO::openForWrite(void *buff, size_t size)
+{
+	open(buff, 0, {});
+	writeCapacity = size;
+	return {};
+}
+
 void BufferMapIO::close()
 {
 	if(data)
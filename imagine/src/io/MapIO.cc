@@ -15,6 +15,7 @@
 
 #define LOGTAG "MapIO"
 #include <cstring>
+#include <algorithm>
 #if defined __linux__ || defined __APPLE__
 #include <sys/mman.h>
 #include <imagine/util/system/pagesize.h>
@@ -46,10 +47,23 @@ const char *MapIO::mmapConst()
 
 ssize_t MapIO::write(const void *buff, size_t bytes, std::error_code *ecOut)
 {
-	// TODO
-	if(ecOut)
-		*ecOut = {ENOSYS, std::system_category()};
-	return -1;
+	if(!writeCapacity)
+	{
+		if(ecOut)
+			*ecOut = {ENOSYS, std::system_category()};
+		return -1;
+	}
+	if(bytes > writeCapacity - size_t(currPos - data))
+	{
+		if(ecOut)
+			*ecOut = {ENOSPC, std::system_category()};
+		return -1;
+	}
+	memcpy((char*)currPos, buff, bytes);
+	currPos += bytes;
+	// like a newly created file, the size is the furthest point written to
+	dataSize = std::max(dataSize, size_t(currPos - data));
+	return bytes;
 }
 
 off_t MapIO::seek(off_t offset, IO::SeekMode mode, std::error_code *ecOut)
@@ -132,6 +146,7 @@ void MapIO::resetData()
 {
 	data = currPos = nullptr;
 	dataSize = 0;
+	writeCapacity = 0;
 }
 
 const char *MapIO::dataEnd()
@@ -0,0 +1,217 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "Trace"
+#include <imagine/logger/Trace.hh>
+#include <imagine/logger/logger.h>
+#include <imagine/io/FileIO.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/algorithm.h>
+#include <algorithm>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+
+namespace Trace
+{
+
+struct Event
+{
+	uint64_t nsecs;
+	const char *name; // nullptr marks the end of the innermost zone
+};
+
+static constexpr uint32_t EVENTS = 1 << 14; // per thread, must be a power of 2
+static constexpr uint MAX_THREADS = 16;
+
+struct ThreadBuffer
+{
+	// total events written, only the owning thread stores to it
+	std::atomic<uint32_t> head{};
+	const char *name{};
+	Event event[EVENTS];
+};
+
+std::atomic_bool isEnabled_{};
+// allocated up front when tracing is first enabled so a thread's first event,
+// possibly in a real-time callback, only claims a buffer instead of allocating
+static std::atomic<ThreadBuffer*> bufferPool{};
+static std::atomic<ThreadBuffer*> threadBuffer[MAX_THREADS]{};
+static std::atomic_uint threadBuffers{};
+static thread_local ThreadBuffer *thisThreadBuffer{};
+static thread_local const char *thisThreadName{};
+static thread_local bool thisThreadOverLimit{};
+
+static ThreadBuffer *makeThreadBuffer()
+{
+	if(thisThreadOverLimit)
+		return nullptr;
+	auto pool = bufferPool.load(std::memory_order_acquire);
+	if(!pool)
+		return nullptr;
+	uint idx = threadBuffers.fetch_add(1, std::memory_order_relaxed);
+	if(idx >= MAX_THREADS)
+	{
+		logWarn("more than %u threads traced, ignoring new thread", MAX_THREADS);
+		threadBuffers.fetch_sub(1, std::memory_order_relaxed);
+		thisThreadOverLimit = true;
+		return nullptr;
+	}
+	// buffers are never freed so events of finished threads remain in the trace
+	auto buff = &pool[idx];
+	buff->name = thisThreadName;
+	threadBuffer[idx].store(buff, std::memory_order_release);
+	thisThreadBuffer = buff;
+	return buff;
+}
+
+static void addEvent(const char *name)
+{
+	auto buff = thisThreadBuffer;
+	if(unlikely(!buff))
+	{
+		buff = makeThreadBuffer();
+		if(!buff)
+			return;
+	}
+	auto head = buff->head.load(std::memory_order_relaxed);
+	buff->event[head & (EVENTS - 1)] = {IG::Time::now().nSecs(), name};
+	buff->head.store(head + 1, std::memory_order_release);
+}
+
+void setEnabled(bool on)
+{
+	logMsg("tracing %s", on ? "enabled" : "disabled");
+	if(on && !bufferPool.load(std::memory_order_relaxed))
+	{
+		logMsg("allocating %u thread buffers of %zu bytes", MAX_THREADS, sizeof(ThreadBuffer));
+		bufferPool.store(new ThreadBuffer[MAX_THREADS], std::memory_order_release);
+	}
+	isEnabled_.store(on, std::memory_order_relaxed);
+}
+
+void beginZone(const char *name)
+{
+	addEvent(name);
+}
+
+void endZone()
+{
+	addEvent(nullptr);
+}
+
+void setThreadName(const char *name)
+{
+	thisThreadName = name;
+	if(thisThreadBuffer)
+		thisThreadBuffer->name = name;
+}
+
+// copy out the events of a buffer its thread may still be writing to,
+// returns the number of valid events stored in events
+static uint32_t copyEvents(ThreadBuffer &buff, Event *events)
+{
+	auto head = buff.head.load(std::memory_order_acquire);
+	uint32_t start = head > EVENTS ? head - EVENTS : 0;
+	for(auto i = start; i != head; i++)
+	{
+		events[i - start] = buff.event[i & (EVENTS - 1)];
+	}
+	// drop any events the writer overwrote during the copy, including the one
+	// it may be in the middle of writing
+	auto newHead = buff.head.load(std::memory_order_acquire);
+	uint32_t skip = 0;
+	if(newHead + 1 > start + EVENTS)
+	{
+		skip = std::min(newHead + 1 - EVENTS - start, head - start);
+	}
+	if(skip)
+	{
+		std::copy(&events[skip], &events[head - start], events);
+	}
+	return head - start - skip;
+}
+
+static void writeStr(FileIO &io, const char *str, std::error_code &ec)
+{
+	if(ec)
+		return;
+	io.write(str, strlen(str), &ec);
+}
+
+std::error_code writeChromeJSON(const char *path)
+{
+	FileIO io;
+	if(auto ec = io.create(path);
+		ec)
+	{
+		logErr("error creating %s", path);
+		return ec;
+	}
+	std::unique_ptr<Event[]> events{new Event[EVENTS]};
+	std::error_code ec{};
+	char str[256];
+	bool firstEvent = true;
+	auto writeEvent =
+		[&](const char *fmt, auto ...args)
+		{
+			snprintf(str, sizeof(str), fmt, firstEvent ? "" : ",\n", args...);
+			firstEvent = false;
+			writeStr(io, str, ec);
+		};
+	writeStr(io, "{\"traceEvents\":[\n", ec);
+	uint threads = std::min(threadBuffers.load(std::memory_order_relaxed), MAX_THREADS);
+	uint totalEvents = 0;
+	iterateTimes(threads, t)
+	{
+		auto buff = threadBuffer[t].load(std::memory_order_acquire);
+		if(!buff)
+			continue;
+		if(buff->name)
+		{
+			writeEvent("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+				t, buff->name);
+		}
+		auto count = copyEvents(*buff, events.get());
+		uint depth = 0;
+		iterateTimes(count, i)
+		{
+			auto &e = events[i];
+			if(e.name)
+			{
+				depth++;
+				writeEvent("%s{\"name\":\"%s\",\"ph\":\"B\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+					e.name, t, e.nsecs / 1000.);
+			}
+			else if(depth) // skip ends of zones whose begin was overwritten
+			{
+				depth--;
+				writeEvent("%s{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+					t, e.nsecs / 1000.);
+			}
+		}
+		totalEvents += count;
+	}
+	writeStr(io, "\n]}\n", ec);
+	if(ec)
+	{
+		logErr("error writing %s", path);
+		return ec;
+	}
+	logMsg("wrote %u events from %u thread(s) to %s", totalEvents, threads, path);
+	return {};
+}
+
+}
@@ -0,0 +1,6 @@
+ifndef inc_logger_trace
+inc_logger_trace := 1
+
+SRC += logger/Trace.cc
+
+endif